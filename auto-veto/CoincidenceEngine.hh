@@ -0,0 +1,136 @@
+// CoincidenceEngine.hh
+// Muon-Ge coincidences for any number of time windows, in one pass over a run.
+// C. Wiseman, USC/Majorana
+//
+// Each window is an interval [lo, hi] of (Ge hit time - muon time), in seconds, e.g.
+// {"2s",-2,2} or {"70s",-10,60}.  Give the engine a run's muon times, then its Ge
+// hits in time order.  For each window, it keeps a pointer to the first muon whose
+// window hasn't closed yet, so a run with M muons and N hits costs O(N + M) per window,
+// plus the muons that actually overlap a hit.
+//
+// A hit inside the windows of several muons is matched once per window, to the closest
+// muon (smallest |dt|).  So nothing is double counted, however the windows overlap.
+// Times only have to be in the same units and from the same clock.
+// Hits that go backwards in time are still matched correctly, and cost a binary search
+// per window to move its pointer back.
+//
+// Usage:
+//   CoincidenceEngine coin(windows);
+//   coin.SetMuons(muTimes);                        // one run
+//   for each hit (time-ordered):
+//     if (coin.Match(t, muIdx, dt)) ...            // muIdx[w] = -1 if not in window w
+
+#ifndef COINCIDENCEENGINE_H_GUARD
+#define COINCIDENCEENGINE_H_GUARD
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+struct CoinWindow
+{
+  std::string name;
+  double lo, hi;
+};
+
+// One window per line: name lo hi (seconds).  '#' for comments.
+inline bool LoadCoinWindows(std::string file, std::vector<CoinWindow> &windows)
+{
+  std::ifstream in(file.c_str());
+  if (!in.good()) {
+    std::cout << "Couldn't open window file " << file << std::endl;
+    return false;
+  }
+  std::string line;
+  while (getline(in, line))
+  {
+    if (line.empty() || line[0] == '#') continue;
+    std::istringstream iss(line);
+    CoinWindow w;
+    if (!(iss >> w.name >> w.lo >> w.hi)) continue;
+    if (w.hi < w.lo) std::swap(w.lo, w.hi);
+    windows.push_back(w);
+  }
+  return !windows.empty();
+}
+
+class CoincidenceEngine
+{
+public:
+  CoincidenceEngine(const std::vector<CoinWindow> &windows) : fWindows(windows), fFirst(windows.size(), 0), fLastTime(-HUGE_VAL) {}
+
+  // Muon times for one run, in any order.  Match() returns indexes into this list.
+  void SetMuons(const std::vector<double> &muTimes)
+  {
+    fOrder.resize(muTimes.size());
+    for (size_t i = 0; i < muTimes.size(); i++) fOrder[i] = i;
+    std::sort(fOrder.begin(), fOrder.end(), [&](size_t a, size_t b) { return muTimes[a] < muTimes[b]; });
+    fMuTimes.resize(muTimes.size());
+    for (size_t i = 0; i < fOrder.size(); i++) fMuTimes[i] = muTimes[fOrder[i]];
+    Rewind();
+  }
+
+  // For each window w: muIdx[w] is the closest muon with the hit in its window (-1 if none),
+  // and dt[w] = hitTime - (that muon's time).  Returns true if the hit is in any window.
+  bool Match(double hitTime, std::vector<int> &muIdx, std::vector<double> &dt)
+  {
+    size_t nWin = fWindows.size();
+    muIdx.assign(nWin, -1);
+    dt.assign(nWin, 0);
+    if (hitTime < fLastTime) Reposition(hitTime);
+    fLastTime = hitTime;
+
+    bool found = false;
+    for (size_t w = 0; w < nWin; w++)
+    {
+      double lo = fWindows[w].lo, hi = fWindows[w].hi;
+      // muons whose window closed before this hit are done for good
+      size_t &k = fFirst[w];
+      while (k < fMuTimes.size() && hitTime - fMuTimes[k] > hi) k++;
+
+      // every muon from here on with hitTime - muTime >= lo contains the hit
+      double best = HUGE_VAL;
+      for (size_t m = k; m < fMuTimes.size() && hitTime - fMuTimes[m] >= lo; m++) {
+        double d = hitTime - fMuTimes[m];
+        if (fabs(d) < best) {
+          best = fabs(d);
+          muIdx[w] = (int)fOrder[m];
+          dt[w] = d;
+        }
+      }
+      if (muIdx[w] >= 0) found = true;
+    }
+    return found;
+  }
+
+  // Start over from the first muon (e.g. to go through the same run's hits again).
+  void Rewind()
+  {
+    std::fill(fFirst.begin(), fFirst.end(), 0);
+    fLastTime = -HUGE_VAL;
+  }
+
+  // Moves each window's pointer back to the first muon with hitTime - muTime <= hi.
+  void Reposition(double hitTime)
+  {
+    for (size_t w = 0; w < fWindows.size(); w++)
+      fFirst[w] = std::lower_bound(fMuTimes.begin(), fMuTimes.end(), hitTime - fWindows[w].hi) - fMuTimes.begin();
+  }
+
+  size_t GetNWindows() const { return fWindows.size(); }
+  const CoinWindow& GetWindow(size_t w) const { return fWindows[w]; }
+  size_t GetNMuons() const { return fMuTimes.size(); }
+
+private:
+  std::vector<CoinWindow> fWindows;
+  std::vector<size_t> fFirst;      // per window: first muon whose window might still be open
+  std::vector<double> fMuTimes;    // sorted
+  std::vector<size_t> fOrder;      // sorted position -> index in the caller's list
+  double fLastTime;
+};
+
+#endif
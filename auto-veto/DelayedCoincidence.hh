@@ -0,0 +1,170 @@
+// DelayedCoincidence.hh
+// Delayed muon-Ge coincidences (neutron capture, activation, ...) over windows up to
+// minutes long after each muon, in one time-ordered pass.  Fills dt spectra per window,
+// for all hits, per detector and per muon type.
+// C. Wiseman, USC/Majorana
+//
+// Give it muons and Ge hits in time order (e.g. from StreamMerge.hh).  The muons whose
+// longest window is still open are kept in a deque: each hit drops the expired muons from
+// the front, and is paired with every muon left.  So a hit costs O(muons in the longest
+// window), not O(all muons), and every (muon, hit) pair in a window is counted once.
+// Unlike CoincidenceEngine, a hit after several muons counts once for each of them; the
+// flat part of the dt spectrum is the accidental rate.
+//
+// Windows are [lo, hi] seconds after the muon (CoinWindow, LoadCoinWindows), with lo >= 0.
+//
+// Usage:
+//   DelayedCoincidence dc(windows, nBins);
+//   for each time-ordered event:
+//     if (muon) dc.AddMuon(t, type, run);
+//     else dc.AddHit(t, detector);
+//   dc.Print();
+//   dc.Write();            // histograms, in one directory per window
+
+#ifndef DELAYEDCOINCIDENCE_H_GUARD
+#define DELAYEDCOINCIDENCE_H_GUARD
+
+#include <iostream>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include "TH1D.h"
+#include "TDirectory.h"
+#include "CoincidenceEngine.hh"
+
+class DelayedCoincidence
+{
+public:
+  struct Muon { double time; int type; int run; };
+
+  DelayedCoincidence(const std::vector<CoinWindow> &windows, int nBins=600)
+    : fWindows(windows), fNBins(nBins), fMaxHi(0), fNMuons(0), fNHits(0), fNUnordered(0), fMaxActive(0)
+  {
+    for (auto &w : fWindows) {
+      if (w.lo < 0) {
+        std::cout << "Delayed window " << w.name << " starts before the muon.  Using 0 to " << w.hi << " s.\n";
+        w.lo = 0;
+      }
+      if (w.hi > fMaxHi) fMaxHi = w.hi;
+    }
+    fAll.resize(fWindows.size());
+    fByDet.resize(fWindows.size());
+    fByType.resize(fWindows.size());
+    fNPairs.assign(fWindows.size(), 0);
+  }
+
+  void AddMuon(double time, int type, int run=0)
+  {
+    Muon m = {time, type, run};
+    fNMuons++;
+    if (!fMuons.empty() && time < fMuons.back().time) {   // keep the deque sorted
+      fNUnordered++;
+      auto it = fMuons.end();
+      while (it != fMuons.begin() && (it-1)->time > time) --it;
+      fMuons.insert(it, m);
+    }
+    else fMuons.push_back(m);
+    if (fMuons.size() > fMaxActive) fMaxActive = fMuons.size();
+  }
+
+  // Returns the number of (muon, window) pairs the hit is in.
+  int AddHit(double time, int detector)
+  {
+    fNHits++;
+    while (!fMuons.empty() && time - fMuons.front().time > fMaxHi) fMuons.pop_front();
+    int n = 0;
+    for (auto &m : fMuons) {
+      double dt = time - m.time;
+      if (dt < 0) break;   // muons after the hit
+      for (size_t w = 0; w < fWindows.size(); w++) {
+        if (dt < fWindows[w].lo || dt > fWindows[w].hi) continue;
+        int bin = Bin(w, dt);
+        Counts(fAll[w])[bin]++;
+        Counts(fByDet[w][detector])[bin]++;
+        Counts(fByType[w][m.type])[bin]++;
+        fNPairs[w]++;
+        n++;
+      }
+    }
+    return n;
+  }
+
+  // Forget the open muons (e.g. across a run boundary with no clock offset).
+  void ClearMuons() { fMuons.clear(); }
+
+  long GetNPairs(size_t w) const { return (w < fNPairs.size()) ? fNPairs[w] : 0; }
+  size_t GetMaxActive() const { return fMaxActive; }
+
+  void Print() const
+  {
+    printf("Delayed coincidences: %li muons, %li hits, at most %zu muons open at once", fNMuons, fNHits, fMaxActive);
+    if (fNUnordered > 0) printf(" (%li muons out of time order)", fNUnordered);
+    printf("\n");
+    for (size_t w = 0; w < fWindows.size(); w++) {
+      printf("  %-10s %6g to %-6g s: %li pairs.  By muon type:", fWindows[w].name.c_str(), fWindows[w].lo, fWindows[w].hi, fNPairs[w]);
+      for (auto &t : fByType[w]) printf("  %i: %.0f", t.first, Sum(t.second));
+      printf("\n");
+    }
+  }
+
+  // One directory per window: dt (all hits), dt_det[channel], dt_type[muon type].
+  void Write(TDirectory *dir=NULL) const
+  {
+    if (dir == NULL) dir = gDirectory;
+    for (size_t w = 0; w < fWindows.size(); w++) {
+      TDirectory *d = dir->mkdir(("delayed_" + fWindows[w].name).c_str());
+      if (d == NULL) d = dir;
+      d->cd();
+      WriteHist(w, "dt", "all detectors", fAll[w]);
+      for (auto &det : fByDet[w]) WriteHist(w, "dt_det" + std::to_string(det.first), "detector " + std::to_string(det.first), det.second);
+      for (auto &t : fByType[w]) WriteHist(w, "dt_type" + std::to_string(t.first), "muon type " + std::to_string(t.first), t.second);
+    }
+    dir->cd();
+  }
+
+private:
+  int Bin(size_t w, double dt) const
+  {
+    int bin = (int)((dt - fWindows[w].lo) / (fWindows[w].hi - fWindows[w].lo) * fNBins);
+    return (bin < fNBins) ? bin : fNBins-1;
+  }
+
+  std::vector<double>& Counts(std::vector<double> &c)
+  {
+    if (c.empty()) c.assign(fNBins, 0);
+    return c;
+  }
+
+  static double Sum(const std::vector<double> &c)
+  {
+    double s = 0;
+    for (auto x : c) s += x;
+    return s;
+  }
+
+  void WriteHist(size_t w, std::string name, std::string what, const std::vector<double> &c) const
+  {
+    if (c.empty()) return;
+    const CoinWindow &win = fWindows[w];
+    TH1D *h = new TH1D(name.c_str(), Form("Ge hit - muon time, %s (%g to %g s)", what.c_str(), win.lo, win.hi), fNBins, win.lo, win.hi);
+    h->GetXaxis()->SetTitle("dt (sec)");
+    for (int b = 0; b < fNBins; b++) h->SetBinContent(b+1, c[b]);
+    h->SetEntries(Sum(c));
+    h->Write("", TObject::kOverwrite);
+    delete h;
+  }
+
+  std::vector<CoinWindow> fWindows;
+  int fNBins;
+  double fMaxHi;
+  std::deque<Muon> fMuons;                             // open muons, in time order
+  std::vector<std::vector<double> > fAll;               // [window][bin]
+  std::vector<std::map<int, std::vector<double> > > fByDet, fByType;
+  std::vector<long> fNPairs;
+  long fNMuons, fNHits, fNUnordered;
+  size_t fMaxActive;
+};
+
+#endif
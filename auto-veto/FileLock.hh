@@ -0,0 +1,54 @@
+// FileLock.hh
+// An exclusive lock on a shared text file (threshold store, run metadata cache, ...),
+// so jobs running in parallel don't overwrite each other's updates.
+// C. Wiseman, USC/Majorana
+//
+// The lock is flock() on "[file].lock", held until the FileLock goes out of scope.
+// Take it before loading the file, and keep it until the new version is saved:
+//   {
+//     FileLock lock(file);
+//     store.Load(file);  ... change it ...  store.Save(file);
+//   }
+// flock isn't reliable on every network filesystem; if the lock can't be taken, a
+// warning is printed and the update goes ahead unlocked.
+
+#ifndef FILELOCK_H_GUARD
+#define FILELOCK_H_GUARD
+
+#include <iostream>
+#include <string>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+
+class FileLock
+{
+public:
+  explicit FileLock(std::string file) : fPath(file + ".lock"), fFD(-1)
+  {
+    fFD = open(fPath.c_str(), O_RDWR | O_CREAT, 0664);
+    if (fFD < 0 || flock(fFD, LOCK_EX) != 0) {
+      std::cout << "FileLock: couldn't lock " << fPath << ".  Updating " << file << " unlocked.\n";
+      if (fFD >= 0) close(fFD);
+      fFD = -1;
+    }
+  }
+
+  ~FileLock()
+  {
+    if (fFD < 0) return;
+    flock(fFD, LOCK_UN);
+    close(fFD);
+  }
+
+  bool IsLocked() const { return fFD >= 0; }
+
+private:
+  FileLock(const FileLock&);
+  FileLock& operator=(const FileLock&);
+
+  std::string fPath;
+  int fFD;
+};
+
+#endif
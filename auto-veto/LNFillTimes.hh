@@ -0,0 +1,231 @@
+// LNFillTimes.hh
+// Unix times of the liquid nitrogen fills for module 1 (LoadLNFillTimes1)
+// and module 2 (LoadLNFillTimes2).  Data taken from fillTime-900s to
+// fillTime+300s is tagged (see LNFillWindow in Livetime.hh).
+
+#ifndef LNFILLTIMES_H_GUARD
+#define LNFILLTIMES_H_GUARD
+
+#include <vector>
+
+using namespace std;
+
+inline void LoadLNFillTimes1(vector<double>& lnFillTimes1, int dsNumber)
+{
+  // we don't really need to make DS-specific lists, but look-up
+  // time is shorter if the lists are shorter.
+
+  if(dsNumber == 0) {
+    lnFillTimes1.push_back(1435870160);
+    lnFillTimes1.push_back(1436020533);
+    lnFillTimes1.push_back(1436168622);
+    lnFillTimes1.push_back(1436316362);
+    lnFillTimes1.push_back(1436463827);
+    lnFillTimes1.push_back(1436614832);
+    lnFillTimes1.push_back(1436759402);
+    lnFillTimes1.push_back(1436908966);
+    lnFillTimes1.push_back(1437058884);
+    lnFillTimes1.push_back(1437060687);
+    lnFillTimes1.push_back(1437204895);
+    lnFillTimes1.push_back(1437350621);
+    lnFillTimes1.push_back(1437638022);
+    lnFillTimes1.push_back(1437781652);
+    lnFillTimes1.push_back(1437926383);
+    lnFillTimes1.push_back(1438070819);
+    lnFillTimes1.push_back(1438121812);
+    lnFillTimes1.push_back(1438212611);
+    lnFillTimes1.push_back(1438352837);
+    lnFillTimes1.push_back(1438496004);
+    lnFillTimes1.push_back(1438639835);
+    lnFillTimes1.push_back(1438782282);
+    lnFillTimes1.push_back(1438932169);
+    lnFillTimes1.push_back(1439080850);
+    lnFillTimes1.push_back(1439226624);
+    lnFillTimes1.push_back(1439371591);
+    lnFillTimes1.push_back(1439514291);
+    lnFillTimes1.push_back(1439657247);
+    lnFillTimes1.push_back(1439801649);
+    lnFillTimes1.push_back(1439944622);
+    lnFillTimes1.push_back(1440080091);
+    lnFillTimes1.push_back(1440192295);
+    lnFillTimes1.push_back(1440335863);
+    lnFillTimes1.push_back(1440477294);
+    lnFillTimes1.push_back(1440618411);
+    lnFillTimes1.push_back(1440759782);
+    lnFillTimes1.push_back(1440902658);
+    lnFillTimes1.push_back(1441046730);
+    lnFillTimes1.push_back(1441187019);
+    lnFillTimes1.push_back(1441325878);
+    lnFillTimes1.push_back(1441462000);
+    lnFillTimes1.push_back(1441600116);
+    lnFillTimes1.push_back(1441741779);
+    lnFillTimes1.push_back(1441883940);
+    lnFillTimes1.push_back(1442027368);
+    lnFillTimes1.push_back(1442169713);
+    lnFillTimes1.push_back(1442312599);
+    lnFillTimes1.push_back(1442453920);
+    lnFillTimes1.push_back(1442595578);
+    lnFillTimes1.push_back(1442737259);
+    lnFillTimes1.push_back(1442879000);
+    lnFillTimes1.push_back(1443021647);
+  }
+
+  if(dsNumber == 1) {
+    lnFillTimes1.push_back(1452519860);
+    lnFillTimes1.push_back(1452655867);
+    lnFillTimes1.push_back(1452791415);
+    lnFillTimes1.push_back(1453541032);
+    lnFillTimes1.push_back(1453670314);
+    lnFillTimes1.push_back(1453800137);
+    lnFillTimes1.push_back(1453929779);
+    lnFillTimes1.push_back(1453937178);
+    lnFillTimes1.push_back(1453998125);
+    lnFillTimes1.push_back(1454000591);
+    lnFillTimes1.push_back(1454002456);
+    lnFillTimes1.push_back(1454014971);
+    lnFillTimes1.push_back(1454107981);
+    lnFillTimes1.push_back(1454219392);
+    lnFillTimes1.push_back(1454332307);
+    lnFillTimes1.push_back(1454447212);
+    lnFillTimes1.push_back(1454559953);
+    lnFillTimes1.push_back(1454679496);
+    lnFillTimes1.push_back(1454769079);
+    lnFillTimes1.push_back(1454882301);
+    lnFillTimes1.push_back(1454946492);
+    lnFillTimes1.push_back(1454951907);
+    lnFillTimes1.push_back(1454954012);
+    lnFillTimes1.push_back(1454955958);
+    lnFillTimes1.push_back(1455225161);
+    lnFillTimes1.push_back(1455228289);
+    lnFillTimes1.push_back(1455440690);
+    lnFillTimes1.push_back(1455568585);
+    lnFillTimes1.push_back(1455696789);
+    lnFillTimes1.push_back(1455822149);
+    lnFillTimes1.push_back(1455952573);
+    lnFillTimes1.push_back(1456082166);
+    lnFillTimes1.push_back(1456206057);
+    lnFillTimes1.push_back(1456333236);
+    lnFillTimes1.push_back(1456460237);
+    lnFillTimes1.push_back(1456588495);
+    lnFillTimes1.push_back(1456717776);
+    lnFillTimes1.push_back(1456846882);
+    lnFillTimes1.push_back(1456943983);
+    lnFillTimes1.push_back(1456981934);
+    lnFillTimes1.push_back(1457110918);
+    lnFillTimes1.push_back(1457238098);
+    lnFillTimes1.push_back(1457365179);
+    lnFillTimes1.push_back(1457491997);
+    lnFillTimes1.push_back(1457619662);
+    lnFillTimes1.push_back(1457747884);
+    lnFillTimes1.push_back(1457874684);
+    lnFillTimes1.push_back(1458001143);
+    lnFillTimes1.push_back(1458130495);
+    lnFillTimes1.push_back(1458259402);
+    lnFillTimes1.push_back(1458387930);
+    lnFillTimes1.push_back(1458515657);
+    lnFillTimes1.push_back(1458639685);
+    lnFillTimes1.push_back(1458767518);
+    lnFillTimes1.push_back(1458896260);
+    lnFillTimes1.push_back(1459023862);
+    lnFillTimes1.push_back(1459150863);
+    lnFillTimes1.push_back(1459275989);
+    lnFillTimes1.push_back(1459402548);
+    lnFillTimes1.push_back(1459529663);
+    lnFillTimes1.push_back(1459654930);
+    lnFillTimes1.push_back(1459785212);
+    lnFillTimes1.push_back(1459912507);
+    lnFillTimes1.push_back(1460042708);
+    lnFillTimes1.push_back(1460169429);
+    lnFillTimes1.push_back(1460297779);
+    lnFillTimes1.push_back(1460426527);
+    lnFillTimes1.push_back(1460552742);
+    lnFillTimes1.push_back(1460678641);
+    lnFillTimes1.push_back(1460808916);
+    lnFillTimes1.push_back(1460939150);
+    lnFillTimes1.push_back(1461064619);
+    lnFillTimes1.push_back(1461189868);
+    lnFillTimes1.push_back(1461318559);
+    lnFillTimes1.push_back(1461443967);
+    lnFillTimes1.push_back(1461569658);
+    lnFillTimes1.push_back(1461695992);
+    lnFillTimes1.push_back(1461824752);
+    lnFillTimes1.push_back(1461952713);
+    lnFillTimes1.push_back(1462258909);
+    lnFillTimes1.push_back(1462314666);
+    lnFillTimes1.push_back(1462371538);
+    lnFillTimes1.push_back(1462426019);
+    lnFillTimes1.push_back(1462462316);
+    lnFillTimes1.push_back(1462588708);
+    lnFillTimes1.push_back(1462715136);
+    lnFillTimes1.push_back(1462840823);
+    lnFillTimes1.push_back(1462966744);
+    lnFillTimes1.push_back(1463093301);
+    lnFillTimes1.push_back(1463220332);
+    lnFillTimes1.push_back(1463346237);
+    lnFillTimes1.push_back(1463472892);
+    lnFillTimes1.push_back(1463599111);
+    lnFillTimes1.push_back(1463694217);
+  }
+
+   if(dsNumber == 3) {
+   //M1
+    lnFillTimes1.push_back(1472129474);
+    lnFillTimes1.push_back(1472268007);
+    lnFillTimes1.push_back(1472404916);
+    lnFillTimes1.push_back(1472545253);
+    lnFillTimes1.push_back(1472683456);
+    lnFillTimes1.push_back(1472822134);
+    lnFillTimes1.push_back(1472961379);
+    lnFillTimes1.push_back(1473096880);
+    lnFillTimes1.push_back(1473236517);
+    lnFillTimes1.push_back(1473369324);
+    lnFillTimes1.push_back(1473510316);
+    lnFillTimes1.push_back(1473635684);
+    lnFillTimes1.push_back(1473771858);
+    lnFillTimes1.push_back(1473909355);
+    lnFillTimes1.push_back(1474045268);
+    lnFillTimes1.push_back(1474182801);
+    lnFillTimes1.push_back(1474319605);
+    lnFillTimes1.push_back(1474457662);
+    lnFillTimes1.push_back(1474569273);
+    lnFillTimes1.push_back(1474705001);
+    lnFillTimes1.push_back(1474842466);
+    lnFillTimes1.push_back(1474977413);
+   }
+}
+inline void LoadLNFillTimes2(vector<double>& lnFillTimes2, int dsNumber)
+{
+    if(dsNumber == 4) {
+    //M2
+    lnFillTimes2.push_back(1472057495);
+    lnFillTimes2.push_back(1472169344);
+    lnFillTimes2.push_back(1472283139);
+    lnFillTimes2.push_back(1472392397);
+    lnFillTimes2.push_back(1472508671);
+    lnFillTimes2.push_back(1472626749);
+    lnFillTimes2.push_back(1472749055);
+    lnFillTimes2.push_back(1472848201);
+    lnFillTimes2.push_back(1472959270);
+    lnFillTimes2.push_back(1473069251);
+    lnFillTimes2.push_back(1473180721);
+    lnFillTimes2.push_back(1473291137);
+    lnFillTimes2.push_back(1473369625);
+    lnFillTimes2.push_back(1473485389);
+    lnFillTimes2.push_back(1473594355);
+    lnFillTimes2.push_back(1473702993);
+    lnFillTimes2.push_back(1473815615);
+    lnFillTimes2.push_back(1473926807);
+    lnFillTimes2.push_back(1474040572);
+    lnFillTimes2.push_back(1474150140);
+    lnFillTimes2.push_back(1474260642);
+    lnFillTimes2.push_back(1474370902);
+    lnFillTimes2.push_back(1474482449);
+    lnFillTimes2.push_back(1474569695);
+    lnFillTimes2.push_back(1474679736);
+    lnFillTimes2.push_back(1474789636);
+    lnFillTimes2.push_back(1474901605);
+    lnFillTimes2.push_back(1475011276);
+  }
+}
+
+#endif
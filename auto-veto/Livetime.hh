@@ -0,0 +1,223 @@
+// Livetime.hh
+// Veto / LN fill cut windows, and an exact dead time & livetime calculation
+// built on sorted interval sets.
+// C. Wiseman, USC/Majorana
+//
+// The skim tools use the same window functions to apply the cut, so the
+// livetime reported by ds_livetime is the livetime of the cut that was applied.
+//
+// All dead windows are in global (unix) time.  Overlapping windows are merged
+// before they're counted, and only the part of a window inside a run counts.
+// Windows can apply to all detectors (group -1) or to one group of detectors
+// (e.g. a module, for the LN fills).
+
+#ifndef LIVETIME_H_GUARD
+#define LIVETIME_H_GUARD
+
+#include <vector>
+#include <map>
+#include <utility>
+#include <algorithm>
+#include <cmath>
+
+// =========================== cut windows ===========================
+
+// Window around a muon at time muTime: 1 second after the muon, widened by the
+// time uncertainty on both ends.  DS-4 requires a larger window due to synchronization issues.
+inline void MuonVetoWindow(int dsNumber, double muTime, double muUnc, double &lo, double &hi)
+{
+  double unc = fabs(muUnc);
+  if (dsNumber == 4) { lo = muTime - 3.*unc; hi = muTime + 4. + unc; }
+  else               { lo = muTime - unc;    hi = muTime + 1. + unc; }
+}
+
+// dtmu = (Ge hit time) - (muon time)
+inline bool InMuonVetoWindow(int dsNumber, double dtmu, double muUnc)
+{
+  double lo, hi;
+  MuonVetoWindow(dsNumber, 0., muUnc, lo, hi);
+  return (dtmu > lo && dtmu < hi);
+}
+
+inline void LNFillWindow(double fillTime, double &lo, double &hi)
+{
+  lo = fillTime - 900.;
+  hi = fillTime + 300.;
+}
+
+// fillTimes must be sorted (the LoadLNFillTimes lists are).
+inline bool InLNFillWindow(const std::vector<double> &fillTimes, double utcTime)
+{
+  // the first fill that could still cover this time
+  auto it = std::lower_bound(fillTimes.begin(), fillTimes.end(), utcTime - 300.);
+  if (it == fillTimes.end()) return false;
+  double lo, hi;
+  LNFillWindow(*it, lo, hi);
+  return (utcTime >= lo && utcTime <= hi);
+}
+
+// =========================== interval sets ===========================
+
+class IntervalSet
+{
+public:
+  typedef std::pair<double,double> Interval;
+
+  IntervalSet() : fNormalized(true) {}
+
+  void Add(double lo, double hi)
+  {
+    if (hi < lo) std::swap(lo, hi);
+    fIntervals.push_back(Interval(lo, hi));
+    fNormalized = false;
+  }
+
+  void Add(const IntervalSet &other)
+  {
+    fIntervals.insert(fIntervals.end(), other.fIntervals.begin(), other.fIntervals.end());
+    fNormalized = false;
+  }
+
+  // Sort and merge overlapping intervals.  O(n log n)
+  void Normalize()
+  {
+    if (fNormalized) return;
+    std::sort(fIntervals.begin(), fIntervals.end());
+    std::vector<Interval> merged;
+    for (auto &iv : fIntervals) {
+      if (!merged.empty() && iv.first <= merged.back().second)
+        merged.back().second = std::max(merged.back().second, iv.second);
+      else merged.push_back(iv);
+    }
+    fIntervals.swap(merged);
+    fNormalized = true;
+  }
+
+  double Length()
+  {
+    Normalize();
+    double len = 0;
+    for (auto &iv : fIntervals) len += iv.second - iv.first;
+    return len;
+  }
+
+  bool Contains(double t)
+  {
+    Normalize();
+    auto it = std::upper_bound(fIntervals.begin(), fIntervals.end(), Interval(t, HUGE_VAL));
+    if (it == fIntervals.begin()) return false;
+    --it;
+    return (t <= it->second);
+  }
+
+  // Length of the overlap of this set with another one.  Linear after sorting.
+  double Overlap(IntervalSet &other)
+  {
+    Normalize();
+    other.Normalize();
+    double len = 0;
+    size_t i = 0, j = 0;
+    while (i < fIntervals.size() && j < other.fIntervals.size())
+    {
+      const Interval &a = fIntervals[i], &b = other.fIntervals[j];
+      double lo = std::max(a.first, b.first), hi = std::min(a.second, b.second);
+      if (hi > lo) len += hi - lo;
+      if (a.second < b.second) i++;
+      else j++;
+    }
+    return len;
+  }
+
+  // Length of the overlap with a single interval.
+  double Overlap(double lo, double hi)
+  {
+    Normalize();
+    double len = 0;
+    auto it = std::upper_bound(fIntervals.begin(), fIntervals.end(), Interval(lo, -HUGE_VAL));
+    if (it != fIntervals.begin()) --it;
+    for (; it != fIntervals.end() && it->first < hi; ++it) {
+      double l = std::max(lo, it->first), h = std::min(hi, it->second);
+      if (h > l) len += h - l;
+    }
+    return len;
+  }
+
+  size_t Size() { Normalize(); return fIntervals.size(); }
+  const std::vector<Interval>& GetIntervals() { Normalize(); return fIntervals; }
+
+private:
+  std::vector<Interval> fIntervals;
+  bool fNormalized;
+};
+
+// =========================== livetime ===========================
+
+class LivetimeEngine
+{
+public:
+  enum { kMuon=0, kBadScaler=1, kLNFill=2, kNSources=3 };
+
+  void AddRun(int run, double unixStart, double unixStop)
+  {
+    fRunBounds[run] = std::make_pair(unixStart, unixStop);
+    fRuns.Add(unixStart, unixStop);
+  }
+
+  // group -1: applies to every detector.
+  void AddDeadWindow(double lo, double hi, int source=kMuon, int group=-1)
+  {
+    fDead[group].Add(lo, hi);
+    fDeadBySource[source].Add(lo, hi);
+  }
+
+  double GetRunTime() { return fRuns.Length(); }
+
+  // Dead time inside the runs, for the detectors in this group.
+  double GetDeadTime(int group=-1)
+  {
+    IntervalSet dead = DeadSet(group);
+    return dead.Overlap(fRuns);
+  }
+
+  // Dead time from one source alone (sources can overlap each other).
+  double GetDeadTimeFrom(int source) { return fDeadBySource[source].Overlap(fRuns); }
+
+  double GetLiveTime(int group=-1) { return GetRunTime() - GetDeadTime(group); }
+
+  // Exposure (kg-days), given each detector's active mass (g) and group.
+  // Detectors without a group entry only get the global windows.
+  // With byDet, each detector's exposure is filled in too.
+  double GetExposure(const std::map<int,double> &massByDet_g, const std::map<int,int> &groupByDet,
+    std::map<int,double> *byDet=NULL)
+  {
+    std::map<int,double> liveByGroup;
+    double expo = 0;
+    for (auto &det : massByDet_g) {
+      int group = -1;
+      auto g = groupByDet.find(det.first);
+      if (g != groupByDet.end()) group = g->second;
+      if (liveByGroup.find(group) == liveByGroup.end()) liveByGroup[group] = GetLiveTime(group);
+      double e = (det.second/1000.) * (liveByGroup[group]/86400.);
+      if (byDet != NULL) (*byDet)[det.first] = e;
+      expo += e;
+    }
+    return expo;
+  }
+
+  size_t GetNRuns() const { return fRunBounds.size(); }
+
+private:
+  IntervalSet DeadSet(int group)
+  {
+    IntervalSet dead = fDead[-1];
+    if (group != -1) dead.Add(fDead[group]);
+    return dead;
+  }
+
+  std::map<int, std::pair<double,double> > fRunBounds;
+  IntervalSet fRuns;
+  std::map<int, IntervalSet> fDead;
+  std::map<int, IntervalSet> fDeadBySource;
+};
+
+#endif
@@ -0,0 +1,214 @@
+// PanelMonitor.hh
+// Per-panel health statistics, accumulated in the same pass as the rest of the
+// veto processing: O(32) work per entry, and no extra pass over the run.
+// C. Wiseman, USC/Majorana
+//
+// For each panel:
+//   - hits over the software threshold, for LED and non-LED entries
+//   - QDC mean & sigma (Welford's running algorithm), for non-LED hits and for LED entries
+//   - the non-LED hit rate in time bins (default 60 s), and its bin-to-bin spread
+// The rate bins stop at the run's duration, if it's set before filling (plus a bin of slack),
+// or at maxTime (default one day).  A bad scaler time past that is counted as out of range.
+// Compared with the reference values for each panel (PanelReference), any panel whose
+// non-LED hit rate or LED QDC is more than N sigma off gets flagged (errors 30 and 29).
+// Write() makes a small summary tree, "panelTree", one entry per panel.
+//
+// Usage:
+//   PanelMonitor mon(run);
+//   mon.SetDuration(unixDuration);           // if it's known
+//   mon.Fill(veto, veto.GetTimeSec(), veto.GetMultip() > LEDSimpleThreshold);   // each entry
+//   vector<int> bad = mon.FlagRate(3.);
+//   mon.Write();
+
+#ifndef PANELMONITOR_H_GUARD
+#define PANELMONITOR_H_GUARD
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cstdio>
+#include "TTree.h"
+#include "MJVetoEvent.hh"
+
+// Reference hit rate (Hz, non-LED) & LED QDC for each panel.  Measured for DS3 and onward,
+// so there are none outside runs 16797 - 4500000.  The LED QDC changed after run 19091.
+inline bool PanelReference(int run, int panel, double &rateMean, double &rateSig, double &qdcMean, double &qdcSig)
+{
+  static const double hitRateMean[32] = {0.007338, 0.007482, 0.007730, 0.009183, 0.005995, 0.005272, 0.005786, 0.013200, 0.007360, 0.008041, 0.006708, 0.004830, 0.006750, 0.010310, 0.011600, 0.020450, 0.006718, 0.028900, 0.008145, 0.025110, 0.002854, 0.003381, 0.006357, 0.002808, 0.0006327, 0.0010950, 0.0003902, 0.003375, 0.0022120, 0.005735, 0.0007639, 0.005983};
+  static const double hitRateSig[32] = {0.001709, 0.001793, 0.001888, 0.002020, 0.001848, 0.00145 , 0.001414, 0.002276, 0.001566, 0.001775, 0.001587, 0.001344, 0.001948, 0.001995, 0.002273, 0.002962, 0.001635, 0.003787, 0.002711, 0.003167, 0.001129, 0.001145, 0.001727, 0.001200, 0.0004681, 0.0006459, 0.0003892, 0.001133, 0.0009158, 0.001850, 0.0005355, 0.001726};
+  static const double qdcMean1[32] = {925, 629.8, 1268, 993.4, 2151, 849.8, 720.2, 2997, 1585, 1185, 1495, 1207, 709.9, 1007, 1702, 2592, 643.2, 1040, 1115, 1307, 1917, 2027, 1214, 1069, 3783, 638.7, 1595, 1138, 1079, 1699, 2476, 3843};
+  static const double qdcSig1[32] = {220, 108.9, 175.6, 136.8, 309.9, 131.9, 115.1, 396.4, 228.5, 182.1, 230.5, 170.5, 93.33, 119.2, 207.9, 319.6, 155.6, 142,  217.2, 173.4, 272.5, 264.5, 145,  215.5, 269.2, 164.6, 263.8, 186.3, 204.9, 253.8, 282.3, 209.7};
+  static const double qdcMean2[32] = {3772, 520.1, 1491, 1110, 2306, 970.3, 2380, 3445, 1676, 1433, 1617, 1292, 857.2, 1124, 2104, 2576, 701.3, 1160, 1312, 1409, 2131, 2279, 1383, 1199, 1048, 743.7, 1688, 1220, 1343, 1760, 2212, 1828};
+  static const double qdcSig2[32] = {297, 92.38, 199.9, 150.1, 321.5, 149.5, 299.3, 387.1, 239.2, 212.6, 244.3, 178.9, 113,  129.6, 245.3, 312.3, 162.3, 154.5, 255.4, 184.5, 292.5, 288.8, 161, 228.7, 210, 176,  270.8, 194.4, 230.4, 261.8, 316, 230.8};
+  if (panel < 0 || panel > 31 || run <= 16797 || run >= 4500000) return false;
+  rateMean = hitRateMean[panel];
+  rateSig = hitRateSig[panel];
+  qdcMean = (run > 19091) ? qdcMean2[panel] : qdcMean1[panel];
+  qdcSig = (run > 19091) ? qdcSig2[panel] : qdcSig1[panel];
+  return true;
+}
+
+// Welford's running mean & variance.
+struct RunningStats
+{
+  long n;
+  double mean, m2;
+  RunningStats() : n(0), mean(0), m2(0) {}
+  void Add(double x)
+  {
+    n++;
+    double d = x - mean;
+    mean += d/n;
+    m2 += d*(x - mean);
+  }
+  double Sigma() const { return (n > 1) ? sqrt(m2/(n-1)) : 0; }
+};
+
+class PanelMonitor
+{
+public:
+  PanelMonitor(int run, double binWidth=60., double maxTime=86400.)
+    : fRun(run), fBinWidth(binWidth), fMaxTime(maxTime), fT0(-1), fDuration(0), fNOutOfRange(0)
+  {
+    for (int j = 0; j < 32; j++) fHits[j] = fLEDHits[j] = 0;
+  }
+
+  // One veto entry.  time is only used for the rate bins (entries with a bad scaler are counted, but not binned).
+  void Fill(const MJVetoEvent &veto, double time, bool isLED)
+  {
+    long bin = -1;
+    if (!veto.GetBadScaler() && time > 0) {
+      if (fT0 < 0) fT0 = time;
+      bin = (long)((time - fT0)/fBinWidth);
+      if (bin >= MaxBins()) { fNOutOfRange++; bin = -1; }
+      if (bin >= 0 && bin >= (long)fBins.size()) fBins.resize(bin+1, std::vector<int>(32, 0));
+    }
+    for (int j = 0; j < 32; j++)
+    {
+      int qdc = veto.GetQDC(j);
+      if (isLED) {
+        fLEDQDC[j].Add(qdc);
+        if (qdc > veto.GetSWThresh(j)) fLEDHits[j]++;
+        continue;
+      }
+      if (qdc <= veto.GetSWThresh(j)) continue;
+      fHits[j]++;
+      fQDC[j].Add(qdc);
+      if (bin >= 0) fBins[bin][j]++;
+    }
+  }
+
+  // The run's live time (sec), for the rates.  Defaults to the span of the rate bins.
+  void SetDuration(double sec) { fDuration = sec; }
+  double GetDuration() const { return (fDuration > 0) ? fDuration : fBins.size()*fBinWidth; }
+
+  long GetNOutOfRange() const { return fNOutOfRange; }
+  long GetHits(int j) const { return fHits[j]; }
+  long GetLEDHits(int j) const { return fLEDHits[j]; }
+  double GetRate(int j) const { return (GetDuration() > 0) ? fHits[j]/GetDuration() : 0; }
+  const RunningStats& GetQDC(int j) const { return fQDC[j]; }
+  const RunningStats& GetLEDQDC(int j) const { return fLEDQDC[j]; }
+
+  // Spread of the rate over the full time bins (the last one is usually partial).
+  double GetRateSigma(int j) const
+  {
+    RunningStats s;
+    for (size_t b = 0; b + 1 < fBins.size(); b++) s.Add(fBins[b][j]/fBinWidth);
+    return s.Sigma();
+  }
+
+  // How far (in reference sigmas) the panel's non-LED rate and LED QDC are from the reference.
+  // 0 if there's no reference for this run.
+  double RateDeviation(int j) const
+  {
+    double rm, rs, qm, qs;
+    if (!PanelReference(fRun, j, rm, rs, qm, qs) || rs <= 0) return 0;
+    return (GetRate(j) - rm)/rs;
+  }
+  double LEDQDCDeviation(int j) const
+  {
+    double rm, rs, qm, qs;
+    if (fLEDQDC[j].n == 0 || !PanelReference(fRun, j, rm, rs, qm, qs) || qs <= 0) return 0;
+    return (fLEDQDC[j].mean - qm)/qs;
+  }
+
+  // Panels more than nSigma off the reference.
+  std::vector<int> FlagRate(double nSigma, double minDuration=300) const
+  {
+    std::vector<int> bad;
+    if (GetDuration() <= minDuration) return bad;
+    for (int j = 0; j < 32; j++) if (fabs(RateDeviation(j)) > nSigma) bad.push_back(j);
+    return bad;
+  }
+  std::vector<int> FlagLEDQDC(double nSigma, long minLEDs=30) const
+  {
+    std::vector<int> bad;
+    for (int j = 0; j < 32; j++) if (fLEDQDC[j].n > minLEDs && fabs(LEDQDCDeviation(j)) > nSigma) bad.push_back(j);
+    return bad;
+  }
+
+  void Print() const
+  {
+    if (fNOutOfRange > 0) printf("%li entries past the end of the rate bins (%.0f s)\n", fNOutOfRange, MaxBins()*fBinWidth);
+    printf("Panel  hits  rate(Hz)   +/-bins   dev(sig)  QDC mean  sigma   LED QDC  dev(sig)\n");
+    for (int j = 0; j < 32; j++)
+      printf("%-5i  %-5li %-9.5f  %-8.5f  %-8.1f  %-8.1f  %-6.1f  %-8.1f %-6.1f\n", j, fHits[j], GetRate(j), GetRateSigma(j),
+        RateDeviation(j), fQDC[j].mean, fQDC[j].Sigma(), fLEDQDC[j].mean, LEDQDCDeviation(j));
+  }
+
+  // One entry per panel, in the current directory.
+  void Write(double nSigma=3.) const
+  {
+    int run = fRun, panel = 0;
+    long hits = 0, ledHits = 0;
+    double rate = 0, rateSigma = 0, rateDev = 0, qdcMean = 0, qdcSigma = 0, ledQDCMean = 0, ledQDCSigma = 0, ledQDCDev = 0;
+    double duration = GetDuration();
+    bool flagged = false;
+    TTree *t = new TTree("panelTree", "veto panel statistics");
+    t->Branch("run", &run);
+    t->Branch("panel", &panel);
+    t->Branch("duration", &duration);
+    t->Branch("hits", &hits);
+    t->Branch("ledHits", &ledHits);
+    t->Branch("rate", &rate);
+    t->Branch("rateSigma", &rateSigma);
+    t->Branch("rateDev", &rateDev);
+    t->Branch("qdcMean", &qdcMean);
+    t->Branch("qdcSigma", &qdcSigma);
+    t->Branch("ledQDCMean", &ledQDCMean);
+    t->Branch("ledQDCSigma", &ledQDCSigma);
+    t->Branch("ledQDCDev", &ledQDCDev);
+    t->Branch("flagged", &flagged);
+    for (panel = 0; panel < 32; panel++) {
+      hits = fHits[panel];
+      ledHits = fLEDHits[panel];
+      rate = GetRate(panel);
+      rateSigma = GetRateSigma(panel);
+      rateDev = RateDeviation(panel);
+      qdcMean = fQDC[panel].mean;
+      qdcSigma = fQDC[panel].Sigma();
+      ledQDCMean = fLEDQDC[panel].mean;
+      ledQDCSigma = fLEDQDC[panel].Sigma();
+      ledQDCDev = LEDQDCDeviation(panel);
+      flagged = (fabs(rateDev) > nSigma || fabs(ledQDCDev) > nSigma);
+      t->Fill();
+    }
+    t->Write("", TObject::kOverwrite);
+  }
+
+private:
+  long MaxBins() const
+  {
+    double t = (fDuration > 0 && fDuration < fMaxTime) ? fDuration + fBinWidth : fMaxTime;
+    return (long)(t/fBinWidth) + 1;
+  }
+
+  int fRun;
+  double fBinWidth, fMaxTime, fT0, fDuration;
+  long fNOutOfRange;
+  long fHits[32], fLEDHits[32];
+  RunningStats fQDC[32], fLEDQDC[32];
+  std::vector<std::vector<int> > fBins;   // [time bin][panel] non-LED hits
+};
+
+#endif
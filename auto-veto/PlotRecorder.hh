@@ -0,0 +1,140 @@
+// PlotRecorder.hh
+// Diagnostic plots kept as plain data (histogram contents, graph points) while a
+// program runs, and written as one small tree, "plotData".  No canvases are made
+// during processing.  ./veto-render draws them afterwards, in batch mode.
+// C. Wiseman, USC/Majorana
+//
+// Each plot goes in a pad of a named canvas.  The canvas name is also the output
+// file name, e.g. "veto-16797-qdc" -> veto-16797-qdc.pdf.
+//
+// Usage:
+//   PlotRecorder plots;
+//   plots.SetLayout("veto-16797-qdc", 8, 4, 1600, 1200);   // optional, default 1 pad, 800x600
+//   plots.AddHist("veto-16797-qdc", 1, hist, true);         // pad 1, log y
+//   plots.AddGraph("run-run16797", 0, "MultipVsTime", x, y, "Time (s)", "Multiplicity");
+//   plots.Write();                                          // to the current directory
+
+#ifndef PLOTRECORDER_H_GUARD
+#define PLOTRECORDER_H_GUARD
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include "TH1.h"
+#include "TTree.h"
+
+struct PlotRecord
+{
+  std::string canvas, name, title, xTitle, yTitle;
+  int pad;
+  int kind;               // 0: histogram, 1: graph
+  int nBins;              // histograms: x has the bin edges (xlo, xhi), y the contents
+  std::vector<double> x, y;
+  double vline;           // draw a vertical line here (if >= 0)
+  bool logy;
+  int marker, color;
+};
+
+class PlotRecorder
+{
+public:
+  struct Layout { int nx, ny, width, height; };
+
+  PlotRecorder() {}
+
+  void SetLayout(std::string canvas, int nx, int ny, int width=800, int height=600)
+  {
+    fLayout[canvas] = {nx, ny, width, height};
+  }
+
+  void AddHist(std::string canvas, int pad, std::string name, std::string title, int nBins, double xlo, double xhi,
+    const std::vector<double> &contents, bool logy=false, double vline=-1)
+  {
+    PlotRecord r = Make(canvas, pad, name, title, 0);
+    r.nBins = nBins;
+    r.x = {xlo, xhi};
+    r.y = contents;
+    r.logy = logy;
+    r.vline = vline;
+    fPlots.push_back(r);
+  }
+
+  void AddHist(std::string canvas, int pad, const TH1 *h, bool logy=false, double vline=-1)
+  {
+    std::vector<double> contents(h->GetNbinsX());
+    for (int i = 0; i < h->GetNbinsX(); i++) contents[i] = h->GetBinContent(i+1);
+    AddHist(canvas, pad, h->GetName(), h->GetTitle(), h->GetNbinsX(), h->GetXaxis()->GetXmin(), h->GetXaxis()->GetXmax(),
+      contents, logy, vline);
+  }
+
+  void AddGraph(std::string canvas, int pad, std::string name, const std::vector<double> &x, const std::vector<double> &y,
+    std::string xTitle="", std::string yTitle="", int marker=21, int color=4)
+  {
+    PlotRecord r = Make(canvas, pad, name, name, 1);
+    r.x = x;
+    r.y = y;
+    r.xTitle = xTitle;
+    r.yTitle = yTitle;
+    r.marker = marker;
+    r.color = color;
+    fPlots.push_back(r);
+  }
+
+  size_t GetNPlots() const { return fPlots.size(); }
+
+  // One entry per plot, in the current directory.
+  void Write() const
+  {
+    PlotRecord r;
+    Layout l;
+    TTree *t = new TTree("plotData", "diagnostic plots, for veto-render");
+    t->Branch("canvas", &r.canvas);
+    t->Branch("name", &r.name);
+    t->Branch("title", &r.title);
+    t->Branch("xTitle", &r.xTitle);
+    t->Branch("yTitle", &r.yTitle);
+    t->Branch("pad", &r.pad);
+    t->Branch("kind", &r.kind);
+    t->Branch("nBins", &r.nBins);
+    t->Branch("x", &r.x);
+    t->Branch("y", &r.y);
+    t->Branch("vline", &r.vline);
+    t->Branch("logy", &r.logy);
+    t->Branch("marker", &r.marker);
+    t->Branch("color", &r.color);
+    t->Branch("nx", &l.nx);
+    t->Branch("ny", &l.ny);
+    t->Branch("width", &l.width);
+    t->Branch("height", &l.height);
+    for (auto &p : fPlots) {
+      r = p;
+      auto it = fLayout.find(p.canvas);
+      l = (it != fLayout.end()) ? it->second : Layout{1, 1, 800, 600};
+      t->Fill();
+    }
+    t->Write("", TObject::kOverwrite);
+  }
+
+private:
+  static PlotRecord Make(std::string canvas, int pad, std::string name, std::string title, int kind)
+  {
+    PlotRecord r;
+    r.canvas = canvas;
+    r.pad = pad;
+    r.name = name;
+    r.title = title;
+    r.kind = kind;
+    r.nBins = 0;
+    r.vline = -1;
+    r.logy = false;
+    r.marker = 21;
+    r.color = 4;
+    return r;
+  }
+
+  std::vector<PlotRecord> fPlots;
+  std::map<std::string, Layout> fLayout;
+};
+
+#endif
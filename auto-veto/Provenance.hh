@@ -0,0 +1,196 @@
+// Provenance.hh
+// Provenance manifests for output files: what went in, with which settings.
+// C. Wiseman, USC/Majorana
+//
+// Each output file gets a text manifest next to it ([output].manifest) listing
+// the tool and its version, the parameters that affect the output, and every
+// input file with its size, mtime and content hash.  With --only-stale, a tool
+// builds the manifest it *would* write, compares it to the one on disk, and skips
+// the job if nothing changed.
+//
+// Inputs are only hashed when their size or mtime differ from the old manifest,
+// so checking an up-to-date output costs a stat() per input.  A file that was
+// touched or copied but not modified still counts as unchanged.
+// The tool version is recorded but not compared: rebuilding doesn't make
+// everything stale.  Use a parameter for changes that should.
+//
+// Format:
+//   tool [name] [version]
+//   param [key] [value]
+//   input [path] [size] [mtime] [hash]
+
+#ifndef PROVENANCE_H_GUARD
+#define PROVENANCE_H_GUARD
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdio>
+#include <cstdint>
+#include <sys/stat.h>
+
+#ifndef MJDVETO_VERSION
+#define MJDVETO_VERSION "unknown"
+#endif
+
+class Manifest
+{
+public:
+  struct Input {
+    std::string path;
+    long long size;
+    long mtime;
+    std::string hash;   // empty until computed
+  };
+
+  Manifest(std::string tool="", std::string version=MJDVETO_VERSION) : fTool(tool), fVersion(version) {}
+
+  static std::string FileName(std::string outputFile) { return outputFile + ".manifest"; }
+
+  template <class T> void AddParam(std::string key, const T &value)
+  {
+    std::ostringstream oss;
+    oss.precision(10);
+    oss << value;
+    fParams[key] = oss.str();
+  }
+
+  // Missing files are recorded with size -1, so they show up as a change if they appear later.
+  void AddInput(std::string path)
+  {
+    Input in = {path, -1, 0, ""};
+    struct stat st;
+    if (stat(path.c_str(), &st) == 0) {
+      in.size = (long long)st.st_size;
+      in.mtime = (long)st.st_mtime;
+    }
+    fInputs.push_back(in);
+  }
+
+  // Every file in a TChain (or anything else with GetListOfFiles).
+  template <class Chain> void AddInputs(Chain *chain)
+  {
+    if (chain == NULL) return;
+    auto *files = chain->GetListOfFiles();
+    if (files == NULL) return;
+    for (int i = 0; i < files->GetEntries(); i++)
+      AddInput(files->At(i)->GetTitle());
+  }
+
+  bool Load(std::string file)
+  {
+    std::ifstream in(file.c_str());
+    if (!in.good()) return false;
+    fParams.clear();
+    fInputs.clear();
+    std::string line, key;
+    while (getline(in, line))
+    {
+      if (line.empty() || line[0] == '#') continue;
+      std::istringstream iss(line);
+      iss >> key;
+      if (key == "tool") iss >> fTool >> fVersion;
+      else if (key == "param") {
+        std::string name, value;
+        iss >> name;
+        getline(iss >> std::ws, value);
+        fParams[name] = value;
+      }
+      else if (key == "input") {
+        Input inp;
+        if (iss >> inp.path >> inp.size >> inp.mtime >> inp.hash) fInputs.push_back(inp);
+      }
+    }
+    return true;
+  }
+
+  // Write after the output is complete.  Hashes are reused from 'prev' for unchanged files.
+  bool Save(std::string file, const Manifest *prev=NULL)
+  {
+    for (auto &in : fInputs) {
+      if (!in.hash.empty()) continue;
+      const Input *old = (prev != NULL) ? prev->FindInput(in.path) : NULL;
+      if (old != NULL && old->size == in.size && old->mtime == in.mtime) in.hash = old->hash;
+      else in.hash = HashFile(in.path);
+    }
+    std::ofstream out(file.c_str());
+    if (!out.good()) return false;
+    out << "# provenance manifest, see Provenance.hh\n";
+    out << "tool " << fTool << " " << fVersion << "\n";
+    for (auto &p : fParams) out << "param " << p.first << " " << p.second << "\n";
+    for (auto &in : fInputs)
+      out << "input " << in.path << " " << in.size << " " << in.mtime << " " << in.hash << "\n";
+    return true;
+  }
+
+  // Compare against the manifest of an existing output.  'why' says what changed.
+  bool IsStale(const Manifest &prev, std::string &why)
+  {
+    if (fTool != prev.fTool) { why = "tool changed: " + prev.fTool + " -> " + fTool; return true; }
+    for (auto &p : fParams) {
+      auto search = prev.fParams.find(p.first);
+      if (search == prev.fParams.end() || search->second != p.second) {
+        why = "parameter " + p.first + " changed";
+        return true;
+      }
+    }
+    if (prev.fParams.size() != fParams.size()) { why = "parameter list changed"; return true; }
+    if (prev.fInputs.size() != fInputs.size()) { why = "number of inputs changed"; return true; }
+    for (auto &in : fInputs) {
+      const Input *old = prev.FindInput(in.path);
+      if (old == NULL) { why = "new input " + in.path; return true; }
+      if (old->size == in.size && old->mtime == in.mtime) { in.hash = old->hash; continue; }
+      if (in.size != old->size || in.size < 0) { why = "input changed: " + in.path; return true; }
+      in.hash = HashFile(in.path);
+      if (in.hash != old->hash) { why = "input changed: " + in.path; return true; }
+    }
+    why = "";
+    return false;
+  }
+
+  // True if outputFile exists and its manifest matches this one.
+  bool IsUpToDate(std::string outputFile, std::string &why)
+  {
+    struct stat st;
+    if (stat(outputFile.c_str(), &st) != 0) { why = "no output file"; return false; }
+    Manifest prev;
+    if (!prev.Load(FileName(outputFile))) { why = "no manifest"; return false; }
+    return !IsStale(prev, why);
+  }
+
+  // 64-bit FNV-1a of the whole file, as hex.  "none" if it can't be read.
+  static std::string HashFile(std::string path)
+  {
+    FILE *f = fopen(path.c_str(), "rb");
+    if (f == NULL) return "none";
+    uint64_t h = 14695981039346656037ULL;
+    std::vector<unsigned char> buf(1 << 20);
+    size_t n;
+    while ((n = fread(&buf[0], 1, buf.size(), f)) > 0)
+      for (size_t i = 0; i < n; i++) { h ^= buf[i]; h *= 1099511628211ULL; }
+    fclose(f);
+    char hex[17];
+    sprintf(hex, "%016llx", (unsigned long long)h);
+    return std::string(hex);
+  }
+
+  const Input* FindInput(std::string path) const
+  {
+    for (auto &in : fInputs) if (in.path == path) return &in;
+    return NULL;
+  }
+
+  std::string GetTool() const { return fTool; }
+  std::string GetVersion() const { return fVersion; }
+  size_t GetNInputs() const { return fInputs.size(); }
+
+private:
+  std::string fTool, fVersion;
+  std::map<std::string,std::string> fParams;
+  std::vector<Input> fInputs;
+};
+
+#endif
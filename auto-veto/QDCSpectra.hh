@@ -0,0 +1,121 @@
+// QDCSpectra.hh
+// Each panel's low-QDC spectrum (0-500, 1 QDC/bin) for a run, kept as plain counts, and
+// the rules that turn a spectrum into a software threshold.  auto-veto writes the spectra
+// to "qdcSpectra" in each veto_run file, so the thresholds can be recomputed later
+// (./veto-rethresh) without reading the built data again.
+// C. Wiseman, USC/Majorana
+//
+// Rules (the parameter is the offset above the pedestal, 35 by default, or a fraction):
+//   pedestal : the highest bin near the first bin with > 1 count, + par  (auto-veto's FindThreshold)
+//   max      : the highest bin in 0-500, + par                           (vetoScan's FindQDCThreshold)
+//   frac     : the first bin above the pedestal that falls below par * the pedestal peak
+// All rules give 9999 for a panel with no counts, or one that isn't installed.
+//
+// Usage:
+//   QDCSpectra spec(run);
+//   spec.Fill(panel, hist);  // or spec.Counts(panel)[bin]++
+//   spec.Write();            // to the current directory
+//   int t = QDCSpectra::GetRule("pedestal")(spec.Counts(panel), panel, run, 35);
+
+#ifndef QDCSPECTRA_H_GUARD
+#define QDCSPECTRA_H_GUARD
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include "TH1.h"
+#include "TTree.h"
+
+class QDCSpectra
+{
+public:
+  static const int nBins = 500;
+  typedef int (*Rule)(const unsigned int *counts, int panel, int run, double par);
+
+  QDCSpectra(int run=0) : fRun(run), fCounts(32*nBins, 0) {}
+
+  int GetRun() const { return fRun; }
+  unsigned int* Counts(int panel) { return &fCounts[panel*nBins]; }
+  const unsigned int* Counts(int panel) const { return &fCounts[panel*nBins]; }
+
+  // From a 500-bin, 0-500 histogram.
+  void Fill(int panel, const TH1D *h)
+  {
+    for (int k = 0; k < nBins; k++) Counts(panel)[k] = (unsigned int)h->GetBinContent(k+1);
+  }
+
+  // One entry per run, in the current directory.
+  void Write() const
+  {
+    int run = fRun;
+    std::vector<unsigned int> counts = fCounts;
+    TTree *t = new TTree("qdcSpectra", "veto panel low-QDC spectra, 0-500");
+    t->Branch("run", &run);
+    t->Branch("counts", &counts[0], "counts[32][500]/i");
+    t->Fill();
+    t->Write("", TObject::kOverwrite);
+  }
+
+  // Reads the (single) entry of a qdcSpectra tree.
+  bool Read(TTree *t)
+  {
+    if (t == NULL || t->GetEntries() < 1) return false;
+    t->SetBranchAddress("run", &fRun);
+    t->SetBranchAddress("counts", &fCounts[0]);
+    t->GetEntry(0);
+    t->ResetBranchAddresses();
+    return true;
+  }
+
+  static bool Installed(int panel, int run) { return !(run > 45000000 && panel > 23); }
+
+  static int PedestalRule(const unsigned int *counts, int panel, int run, double par)
+  {
+    if (!Installed(panel, run)) return 9999;
+    int first = -1;
+    for (int k = 0; k < nBins && first < 0; k++) if (counts[k] > 1) first = k;
+    if (first < 0) return 9999;
+    int peak = std::max(0, first-10);
+    for (int k = peak; k < nBins && k <= first+50; k++) if (counts[k] > counts[peak]) peak = k;
+    return (int)(peak + 0.5 + par);
+  }
+
+  static int MaxRule(const unsigned int *counts, int panel, int run, double par)
+  {
+    if (!Installed(panel, run)) return 9999;
+    int peak = 0;
+    for (int k = 1; k < nBins; k++) if (counts[k] > counts[peak]) peak = k;
+    if (counts[peak] == 0) return 9999;
+    return (int)(peak + 0.5 + par);
+  }
+
+  static int FracRule(const unsigned int *counts, int panel, int run, double par)
+  {
+    if (!Installed(panel, run)) return 9999;
+    int peak = PedestalRule(counts, panel, run, 0);
+    if (peak == 9999) return 9999;
+    for (int k = peak; k < nBins; k++) if (counts[k] < par * counts[peak]) return k;
+    return 9999;
+  }
+
+  static std::map<std::string, Rule>& Rules()
+  {
+    static std::map<std::string, Rule> rules = {{"pedestal", PedestalRule}, {"max", MaxRule}, {"frac", FracRule}};
+    return rules;
+  }
+
+  // NULL if there's no rule by that name.
+  static Rule GetRule(std::string name)
+  {
+    auto it = Rules().find(name);
+    return (it != Rules().end()) ? it->second : NULL;
+  }
+
+private:
+  int fRun;
+  std::vector<unsigned int> fCounts;  // [panel][bin]
+};
+
+#endif
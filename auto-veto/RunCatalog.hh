@@ -0,0 +1,159 @@
+// RunCatalog.hh
+// Run ranges for each data set / run sequence, and the cross-module muon lists,
+// read from a text catalog instead of being compiled in.
+// C. Wiseman, USC/Majorana
+//
+// Catalog format (one record per line, '#' for comments):
+//   seq [ds] [run seq] [lo run] [hi run] ([lo run] [hi run] ...)
+//   mu  [ds] [run] [run unix start] [local muon time] [type] [uncertainty]
+// The catalog is written by make-catalog (see make-catalog.cc).
+// Set $MJD_RUNCATALOG to use something other than runs/dsCatalog.txt in the auto-veto
+// directory (MJDVETO_DIR, set by the Makefile), so the tools find it from any directory.
+// The tools can't run without their run lists: Default() exits if the catalog can't be read.
+
+#ifndef RUNCATALOG_H_GUARD
+#define RUNCATALOG_H_GUARD
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <utility>
+#include <cstdlib>
+
+#ifndef MJDVETO_DIR
+#define MJDVETO_DIR "."
+#endif
+
+class RunCatalog
+{
+public:
+  typedef std::vector<std::pair<int,int> > RangeList;
+
+  struct MuonList {
+    std::vector<int> runs, types;
+    std::vector<double> runTStarts, times, uncert;
+  };
+
+  RunCatalog() : fLoaded(false) {}
+
+  static std::string DefaultFile()
+  {
+    const char *env = getenv("MJD_RUNCATALOG");
+    return (env != NULL) ? env : std::string(MJDVETO_DIR) + "/runs/dsCatalog.txt";
+  }
+
+  // The catalog shared by LoadDataSet and friends.  Read once, on first use.
+  static RunCatalog& Default()
+  {
+    static RunCatalog cat;
+    if (!cat.fLoaded) {
+      std::string file = DefaultFile();
+      if (!cat.Load(file)) {
+        std::cout << "RunCatalog: couldn't open " << file << " (run ./make-catalog, or set $MJD_RUNCATALOG)\n";
+        exit(1);
+      }
+      cat.fLoaded = true;
+    }
+    return cat;
+  }
+
+  bool Load(std::string file)
+  {
+    std::ifstream in(file.c_str());
+    if (!in.good()) return false;
+    std::string line, key;
+    while (getline(in, line))
+    {
+      if (line.empty() || line[0] == '#') continue;
+      std::istringstream iss(line);
+      iss >> key;
+      if (key == "seq") {
+        int ds=0, lo=0, hi=0;
+        size_t seq=0;
+        iss >> ds >> seq;
+        while (iss >> lo >> hi) AddRunRange(ds, seq, lo, hi);
+      }
+      else if (key == "mu") {
+        int ds=0, run=0, type=0;
+        double tStart=0, time=0, unc=0;
+        if (iss >> ds >> run >> tStart >> time >> type >> unc)
+          AddMuon(ds, run, tStart, time, type, unc);
+      }
+    }
+    fLoaded = true;
+    return true;
+  }
+
+  bool Save(std::string file, std::string comment="") const
+  {
+    std::ofstream out(file.c_str());
+    if (!out.good()) return false;
+    out << "# MJD run catalog.  Generated by make-catalog, don't edit by hand.\n";
+    if (comment != "") out << "# " << comment << "\n";
+    for (auto &ds : fSeqs) {
+      out << "# DS" << ds.first << ": " << ds.second.size() << " run sequences\n";
+      for (size_t i = 0; i < ds.second.size(); i++) {
+        out << "seq " << ds.first << " " << i;
+        for (auto &r : ds.second[i]) out << " " << r.first << " " << r.second;
+        out << "\n";
+      }
+    }
+    for (auto &ds : fMuons) {
+      const MuonList &mu = ds.second;
+      out << "# DS" << ds.first << " muon list: " << mu.runs.size() << " entries\n";
+      for (size_t i = 0; i < mu.runs.size(); i++)
+        out << "mu " << ds.first << " " << mu.runs[i] << " " << (long)mu.runTStarts[i] << " "
+            << std::setprecision(9) << mu.times[i] << " " << mu.types[i] << " "
+            << std::setprecision(9) << mu.uncert[i] << "\n";
+    }
+    return true;
+  }
+
+  void AddRunRange(int ds, size_t seq, int lo, int hi)
+  {
+    std::vector<RangeList> &seqs = fSeqs[ds];
+    if (seqs.size() <= seq) seqs.resize(seq+1);
+    seqs[seq].push_back(std::make_pair(lo,hi));
+  }
+
+  void AddMuon(int ds, int run, double runTStart, double time, int type, double unc)
+  {
+    MuonList &mu = fMuons[ds];
+    mu.runs.push_back(run);
+    mu.runTStarts.push_back(runTStart);
+    mu.times.push_back(time);
+    mu.types.push_back(type);
+    mu.uncert.push_back(unc);
+  }
+
+  size_t GetNRunSeqs(int ds) const
+  {
+    auto search = fSeqs.find(ds);
+    return (search == fSeqs.end()) ? 0 : search->second.size();
+  }
+
+  // Returns NULL for an unknown data set or run sequence.
+  const RangeList* GetRunRanges(int ds, size_t seq) const
+  {
+    auto search = fSeqs.find(ds);
+    if (search == fSeqs.end() || seq >= search->second.size()) return NULL;
+    return &search->second[seq];
+  }
+
+  const MuonList* GetMuonList(int ds) const
+  {
+    auto search = fMuons.find(ds);
+    return (search == fMuons.end()) ? NULL : &search->second;
+  }
+
+private:
+  std::map<int, std::vector<RangeList> > fSeqs;
+  std::map<int, MuonList> fMuons;
+  bool fLoaded;
+};
+
+#endif
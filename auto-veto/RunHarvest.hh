@@ -0,0 +1,99 @@
+// RunHarvest.hh
+// Fill RunRecords (RunMetadata.hh) from the built data.
+// C. Wiseman, USC/Majorana
+//
+// GetRunRecord is what the tools should call: it returns the cached record,
+// and only opens the built file if the record is missing or the file has
+// changed since it was harvested.
+
+#ifndef RUNHARVEST_H_GUARD
+#define RUNHARVEST_H_GUARD
+
+#include <iostream>
+#include <string>
+#include "TChain.h"
+#include "TTreeReader.h"
+#include "TTreeReaderValue.h"
+#include "GATDataSet.hh"
+#include "MJTRun.hh"
+#include "MGTBasicEvent.hh"
+#include "MJVetoEvent.hh"
+#include "RunMetadata.hh"
+
+// Read the first and last entries of MGTree and VetoTree in one built file,
+// and the run time GATDataSet gives for the run.
+inline bool HarvestRunRecord(int run, std::string path, RunRecord &rec)
+{
+  rec.run = run;
+  rec.unixStart = rec.unixStop = 0;
+  rec.firstGeTS = rec.lastGeTS = rec.firstScaler = rec.lastScaler = 0;
+  rec.nGe = rec.nVeto = 0;
+  rec.runTime = -1;
+  if (!RunMetadataStore::StatFile(path, rec.fileSize, rec.mtime)) return false;
+
+  GATDataSet ds(run);
+  rec.runTime = ds.GetRunTime()/CLHEP::second;
+  if (rec.runTime < 0) rec.runTime = 0;
+
+  TChain *blt = new TChain("MGTree");
+  if (blt->Add(path.c_str()) && (rec.nGe = blt->GetEntries()) > 0)
+  {
+    TTreeReader reader(blt);
+    TTreeReaderValue<double> bTime(reader,"fTime");
+    TTreeReaderValue<long> bTimeStart(reader,"fStartTime");
+    TTreeReaderValue<long> bTimeStop(reader,"fStopTime");
+    reader.SetEntry(0);
+    rec.unixStart = *bTimeStart;
+    rec.unixStop = *bTimeStop;
+    rec.firstGeTS = (*bTime)*1.e-9;
+    reader.SetEntry(rec.nGe-1);
+    rec.lastGeTS = (*bTime)*1.e-9;
+  }
+  delete blt;
+
+  TChain *vetoChain = new TChain("VetoTree");
+  if (vetoChain->Add(path.c_str()) && (rec.nVeto = vetoChain->GetEntries()) > 0)
+  {
+    TTreeReader reader(vetoChain);
+    TTreeReaderValue<MJTRun> vRun(reader,"run");
+    TTreeReaderValue<MGTBasicEvent> vEvt(reader,"vetoEvent");
+    TTreeReaderValue<uint32_t> vBits(reader,"vetoBits");
+    MJVetoEvent veto;
+    reader.SetEntry(0);
+    veto.WriteEvent(0,&*vRun,&*vEvt,*vBits,run,true);
+    rec.firstScaler = veto.GetTimeSec();
+    if (rec.nGe == 0) {  // veto-only run
+      rec.unixStart = (long)vRun->GetStartTime();
+      rec.unixStop = (long)vRun->GetStopTime();
+    }
+    veto.Clear();
+    reader.SetEntry(rec.nVeto-1);
+    veto.WriteEvent(rec.nVeto-1,&*vRun,&*vEvt,*vBits,run,true);
+    rec.lastScaler = veto.GetTimeSec();
+  }
+  delete vetoChain;
+
+  return (rec.nGe > 0 || rec.nVeto > 0);
+}
+
+// Cached record for a run, harvested (and put in the store) if it's missing or stale.
+// Returns NULL if there's no built file and nothing cached.
+// Pass save=false when looping over many runs, and call store.Save() at the end.
+inline const RunRecord* GetRunRecord(int run, RunMetadataStore &store, bool save=true)
+{
+  GATDataSet ds;
+  std::string path = ds.GetPathToRun(run,GATDataSet::kBuilt);
+  if (store.IsCurrent(run, path)) return store.Get(run);
+  RunRecord rec;
+  if (!HarvestRunRecord(run, path, rec)) {
+    if (store.Get(run) == NULL) std::cout << "GetRunRecord: no built data for run " << run << std::endl;
+    return store.Get(run);
+  }
+  store.Put(rec);
+  if (save) store.Save();
+  return store.Get(run);
+}
+
+inline const RunRecord* GetRunRecord(int run) { return GetRunRecord(run, RunMetadataStore::Default()); }
+
+#endif
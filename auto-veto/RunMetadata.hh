@@ -0,0 +1,174 @@
+// RunMetadata.hh
+// One small record per run (start/stop, first/last Ge and veto times, entry
+// counts), cached in a text file so the tools don't have to open every built
+// file just to find out how long a run was.
+// C. Wiseman, USC/Majorana
+//
+// Cache format (one run per line, '#' for comments):
+//   run unixStart unixStop firstGeTS lastGeTS nGe firstScaler lastScaler nVeto fileSize mtime runTime
+// Ge timestamps and veto scalers are in seconds.  runTime is GATDataSet::GetRunTime
+// in seconds, the run length the tools have always used; GetDuration (stop - start)
+// is the unix one.  fileSize and mtime are of the
+// built file the record was harvested from; if either changes, the record is
+// stale and gets harvested again (see RunHarvest.hh).  Records without a runTime
+// (from older caches) are harvested again too.
+// Several tools can update the cache at once: Save locks it (FileLock.hh), and merges
+// in the records other jobs have saved since it was loaded.
+// Set $MJD_RUNMETA to use something other than ./runs/runMetadata.txt.
+
+#ifndef RUNMETADATA_H_GUARD
+#define RUNMETADATA_H_GUARD
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <map>
+#include <set>
+#include <cstdio>
+#include <cstdlib>
+#include <sys/stat.h>
+#include "FileLock.hh"
+
+struct RunRecord
+{
+  int run;
+  long unixStart, unixStop;
+  double firstGeTS, lastGeTS;       // MGTree fTime (sec)
+  long nGe;
+  double firstScaler, lastScaler;   // veto scaler (sec)
+  long nVeto;
+  long long fileSize;
+  long mtime;
+  double runTime;                   // GATDataSet::GetRunTime (sec).  -1: not harvested
+
+  long GetDuration() const { return unixStop - unixStart; }
+  double GetRunTime() const { return runTime; }
+  double GetGeDuration() const { return lastGeTS - firstGeTS; }
+};
+
+class RunMetadataStore
+{
+public:
+  RunMetadataStore() : fLoaded(false), fDirty(false) {}
+
+  static std::string DefaultFile()
+  {
+    const char *env = getenv("MJD_RUNMETA");
+    return (env != NULL) ? env : "./runs/runMetadata.txt";
+  }
+
+  // The store shared by the tools.  Read once, on first use.
+  static RunMetadataStore& Default()
+  {
+    static RunMetadataStore store;
+    if (!store.fLoaded) {
+      store.fFile = DefaultFile();
+      store.Load(store.fFile);
+      store.fLoaded = true;
+    }
+    return store;
+  }
+
+  // Append (or update) records from a cache file.  Returns false if it can't be opened.
+  bool Load(std::string file)
+  {
+    if (!Read(file, fRecords)) return false;
+    fFile = file;
+    fLoaded = true;
+    return true;
+  }
+
+  // Rewrites the cache, under its lock.  Records put since loading replace the ones in the
+  // file; everything else in the file (e.g. saved by another job meanwhile) is kept.
+  bool Save(std::string file="")
+  {
+    if (file == "") file = (fFile == "") ? DefaultFile() : fFile;
+    FileLock lock(file);
+    std::map<int,RunRecord> onDisk;
+    Read(file, onDisk);
+    for (auto &rec : onDisk)
+      if (fPut.find(rec.first) == fPut.end()) fRecords[rec.first] = rec.second;
+    std::string tmp = file + ".tmp";
+    std::ofstream out(tmp.c_str());
+    if (!out.good()) {
+      std::cout << "RunMetadataStore: couldn't write " << file << std::endl;
+      return false;
+    }
+    out << "# run unixStart unixStop firstGeTS lastGeTS nGe firstScaler lastScaler nVeto fileSize mtime runTime\n";
+    out << std::fixed << std::setprecision(6);
+    for (auto &rec : fRecords) {
+      const RunRecord &r = rec.second;
+      out << r.run << " " << r.unixStart << " " << r.unixStop << " "
+          << r.firstGeTS << " " << r.lastGeTS << " " << r.nGe << " "
+          << r.firstScaler << " " << r.lastScaler << " " << r.nVeto << " "
+          << r.fileSize << " " << r.mtime << " " << r.runTime << "\n";
+    }
+    out.close();
+    if (rename(tmp.c_str(), file.c_str()) != 0) return false;
+    fPut.clear();
+    fDirty = false;
+    return true;
+  }
+
+  void Put(const RunRecord &rec) { fRecords[rec.run] = rec; fPut.insert(rec.run); fDirty = true; }
+
+  // Returns NULL if the run isn't in the store.
+  const RunRecord* Get(int run) const
+  {
+    auto search = fRecords.find(run);
+    return (search == fRecords.end()) ? NULL : &search->second;
+  }
+
+  // True if there's a record for this run, harvested from the file as it is now.
+  bool IsCurrent(int run, std::string path) const
+  {
+    const RunRecord *rec = Get(run);
+    if (rec == NULL) return false;
+    if (rec->runTime < 0) return false;
+    long long size;
+    long mtime;
+    if (!StatFile(path, size, mtime)) return true;  // file's gone, the record is all we have
+    return (rec->fileSize == size && rec->mtime == mtime);
+  }
+
+  static bool StatFile(std::string path, long long &size, long &mtime)
+  {
+    struct stat st;
+    if (path == "" || stat(path.c_str(), &st) != 0) return false;
+    size = (long long)st.st_size;
+    mtime = (long)st.st_mtime;
+    return true;
+  }
+
+  size_t GetNRuns() const { return fRecords.size(); }
+  bool IsDirty() const { return fDirty; }
+  const std::map<int,RunRecord>& GetRecords() const { return fRecords; }
+
+private:
+  static bool Read(std::string file, std::map<int,RunRecord> &records)
+  {
+    std::ifstream in(file.c_str());
+    if (!in.good()) return false;
+    std::string line;
+    while (getline(in, line))
+    {
+      if (line.empty() || line[0] == '#') continue;
+      std::istringstream iss(line);
+      RunRecord r;
+      if (!(iss >> r.run >> r.unixStart >> r.unixStop >> r.firstGeTS >> r.lastGeTS >> r.nGe
+              >> r.firstScaler >> r.lastScaler >> r.nVeto >> r.fileSize >> r.mtime)) continue;
+      if (!(iss >> r.runTime)) r.runTime = -1;
+      records[r.run] = r;
+    }
+    return true;
+  }
+
+  std::map<int,RunRecord> fRecords;
+  std::set<int> fPut;                 // runs put since the last save
+  std::string fFile;
+  bool fLoaded, fDirty;
+};
+
+#endif
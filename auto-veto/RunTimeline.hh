@@ -0,0 +1,129 @@
+// RunTimeline.hh
+// Maps global (unix) times onto runs and local digitizer times, and back.
+// C. Wiseman, USC/Majorana
+//
+// Each run is stored as: run, first digitizer timestamp (sec), unix start, unix stop.
+// This is the same format as the old "runs/ds*-runInfo.txt" files, which are
+// now just the on-disk cache for this table.  Runs are kept sorted by unix start,
+// so a time lookup is a binary search, and a run lookup is a map search.
+
+#ifndef RUNTIMELINE_H_GUARD
+#define RUNTIMELINE_H_GUARD
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+
+struct RunBounds
+{
+  int run;
+  double digStart;   // first digitizer timestamp in the run (sec)
+  double unixStart;
+  double unixStop;
+};
+
+class RunTimeline
+{
+public:
+  RunTimeline() : fSorted(true) {}
+
+  void AddRun(int run, double digStart, double unixStart, double unixStop)
+  {
+    RunBounds rb = {run, digStart, unixStart, unixStop};
+    auto search = fIndex.find(run);
+    if (search != fIndex.end()) fRuns[search->second] = rb;
+    else {
+      fIndex[run] = fRuns.size();
+      fRuns.push_back(rb);
+    }
+    fSorted = false;
+  }
+
+  // Append (or update) runs from a cache file.  Returns false if it can't be opened.
+  bool Load(std::string file)
+  {
+    std::ifstream in(file.c_str());
+    if (!in.good()) return false;
+    int run;
+    double digStart, unixStart, unixStop;
+    while (in >> run >> digStart >> unixStart >> unixStop)
+      AddRun(run, digStart, unixStart, unixStop);
+    return true;
+  }
+
+  bool Save(std::string file)
+  {
+    Sort();
+    std::ofstream out(file.c_str());
+    if (!out.good()) return false;
+    for (auto &rb : fRuns)
+      out << rb.run << "  " << std::setprecision(15) << rb.digStart << "  "
+          << (long)rb.unixStart << "  " << (long)rb.unixStop << std::endl;
+    return true;
+  }
+
+  size_t GetNRuns() const { return fRuns.size(); }
+  const std::vector<RunBounds>& GetRuns() { Sort(); return fRuns; }
+  bool HasRun(int run) const { return fIndex.find(run) != fIndex.end(); }
+
+  // Returns NULL if the run isn't in the table.
+  const RunBounds* GetRun(int run)
+  {
+    Sort();
+    auto search = fIndex.find(run);
+    if (search == fIndex.end()) return NULL;
+    return &fRuns[search->second];
+  }
+
+  // Find the run whose [unixStart, unixStop) contains this time.  NULL if it's between runs.
+  const RunBounds* FindRun(double unixTime)
+  {
+    Sort();
+    auto it = std::upper_bound(fRuns.begin(), fRuns.end(), unixTime,
+      [](double t, const RunBounds &rb) { return t < rb.unixStart; });
+    if (it == fRuns.begin()) return NULL;
+    --it;
+    if (unixTime >= it->unixStop) return NULL;
+    return &(*it);
+  }
+
+  // local digitizer time (sec) in a run --> global unix time
+  bool ToGlobal(int run, double localTime, double &unixTime)
+  {
+    const RunBounds *rb = GetRun(run);
+    if (rb == NULL) return false;
+    unixTime = (localTime - rb->digStart) + rb->unixStart;
+    return true;
+  }
+
+  // global unix time --> run and local digitizer time (sec)
+  bool ToLocal(double unixTime, int &run, double &localTime)
+  {
+    const RunBounds *rb = FindRun(unixTime);
+    if (rb == NULL) return false;
+    run = rb->run;
+    localTime = (unixTime - rb->unixStart) + rb->digStart;
+    return true;
+  }
+
+private:
+  void Sort()
+  {
+    if (fSorted) return;
+    std::sort(fRuns.begin(), fRuns.end(),
+      [](const RunBounds &a, const RunBounds &b) { return a.unixStart < b.unixStart; });
+    fIndex.clear();
+    for (size_t i = 0; i < fRuns.size(); i++) fIndex[fRuns[i].run] = i;
+    fSorted = true;
+  }
+
+  std::vector<RunBounds> fRuns;
+  std::map<int,size_t> fIndex;
+  bool fSorted;
+};
+
+#endif
@@ -0,0 +1,85 @@
+// SkimIndex.hh
+// Persistent entry-list indexes for skim files, so repeated queries only read the
+// entries they select instead of rescanning multi-GB skims.
+// C. Wiseman, USC/Majorana
+//
+// ./skim-index builds, beside each skim file (skimDS3_12.root), an index file
+// (skimDS3_12.index.root) with one TEntryList per predicate.  A list holds the
+// skimTree entries (events) where at least one hit passes:
+//   highE_LG   : low-gain hit over the energy threshold (default trapENFCal > 2630 keV)
+//   highE_HG   : same, high gain
+//   muVeto     : hit in a muon veto window
+//   isLNFill   : hit in an LN fill window (either module)
+//   det_[detID]: hit in that detector
+//   [custom]   : any TTree::Draw selection, given to skim-index with -c [name] "[selection]"
+// Each index has a provenance manifest (Provenance.hh), so it's rebuilt when its skim changes.
+//
+// Reading:
+//   TChain *skim = new TChain("skimTree");  skim->Add(...);
+//   TEntryList *el = SkimIndex::GetEntryList(skim, "muVeto");   // NULL if any file has no index
+//   if (el) skim->SetEntryList(el);
+//   for (Long64_t i = 0; i < el->GetN(); i++) skim->GetEntry(skim->GetEntryNumber(i));
+// TTree::Draw & Project also respect the entry list.  Iterating over it also avoids
+// the GetV1() buffer limit of Draw.
+
+#ifndef SKIMINDEX_H_GUARD
+#define SKIMINDEX_H_GUARD
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "TFile.h"
+#include "TChain.h"
+#include "TEntryList.h"
+#include "TObjArray.h"
+
+namespace SkimIndex
+{
+  // skimDS3_12.root -> skimDS3_12.index.root
+  inline std::string IndexFileName(std::string skimFile)
+  {
+    std::string base = skimFile;
+    if (base.size() > 5 && base.substr(base.size()-5) == ".root") base = base.substr(0, base.size()-5);
+    return base + ".index.root";
+  }
+
+  // One file's list.  The caller owns it.  NULL if there's no index or no such list.
+  inline TEntryList* Load(std::string skimFile, std::string name)
+  {
+    TFile *f = TFile::Open(IndexFileName(skimFile).c_str());
+    if (f == NULL || f->IsZombie()) return NULL;
+    TEntryList *el = (TEntryList*)f->Get(name.c_str());
+    if (el != NULL) {
+      el = (TEntryList*)el->Clone();
+      el->SetDirectory(0);
+    }
+    f->Close();
+    delete f;
+    return el;
+  }
+
+  // A list for a whole chain, made from the index of every file in it.  The caller owns it.
+  inline TEntryList* GetEntryList(TChain *chain, std::string name)
+  {
+    if (chain == NULL || chain->GetListOfFiles() == NULL) return NULL;
+    TEntryList *all = new TEntryList(name.c_str(), name.c_str());
+    TObjArray *files = chain->GetListOfFiles();
+    for (int i = 0; i < files->GetEntries(); i++)
+    {
+      std::string skimFile = files->At(i)->GetTitle();
+      TEntryList *el = Load(skimFile, name);
+      if (el == NULL) {
+        std::cout << "SkimIndex: no \"" << name << "\" index for " << skimFile << ".  Run ./skim-index on it.\n";
+        delete all;
+        return NULL;
+      }
+      el->SetTreeName(chain->GetName());
+      el->SetFileName(skimFile.c_str());
+      all->Add(el);
+      delete el;
+    }
+    return all;
+  }
+}
+
+#endif
@@ -0,0 +1,73 @@
+// SkimPrefilter.hh
+// Two-phase reads for the skims.  First decide from a few small branches whether
+// any hit in an event can survive the skim's energy cut.  Only then read the rest
+// of the event.
+// C. Wiseman, USC/Majorana
+//
+// TTreeReader only reads a branch when its value is used.  But the TTreeCache learns
+// every branch used in the first entries, and then prefetches and decompresses all of
+// them for every cluster, whether or not the event is kept.  So the cache is given only
+// the phase-1 branches, with its learning phase ended (ReaderSetup.hh).  The other branches
+// are read on demand, and only for events that pass.  With a 200 keV or 2 MeV cut,
+// very few events pass, and most of the large branches are never read.
+//
+// Phase 1 branches: run, EventDC1Bits, channel, trapENFCal, trapECal.
+// Usage, before the event loop:
+//   SkimPrefilter pre(threshHG, threshLG);
+//   ReaderSetup io(gatChain);
+//   if (pre.IsRecommended()) io.SetBranches(SkimPrefilter::Phase1Branches());
+//   io.Apply();
+// and first thing in it (after the run-boundary and pulser checks):
+//   if (!pre.Pass(*channelIn, *trapENFCalIn, *trapECalIn)) continue;
+
+#ifndef SKIMPREFILTER_H_GUARD
+#define SKIMPREFILTER_H_GUARD
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdio>
+
+class SkimPrefilter
+{
+public:
+  // Thresholds (keV) for high gain (even channels) and low gain (odd channels).
+  SkimPrefilter(double threshHG=2., double threshLG=10.) : fThreshHG(threshHG), fThreshLG(threshLG), fNEvents(0), fNPassed(0) {}
+
+  static std::vector<std::string> Phase1Branches() {
+    return {"run", "EventDC1Bits", "channel", "trapENFCal", "trapECal"};
+  }
+
+  // Same cut as the skims' hit loop: a hit survives if trapENFCal or trapECal is over its gain's threshold.
+  bool Pass(const std::vector<double> &channel, const std::vector<double> &trapENFCal, const std::vector<double> &trapECal)
+  {
+    fNEvents++;
+    for (size_t i = 0; i < trapENFCal.size() && i < channel.size(); i++) {
+      double thresh = ((int)channel[i] % 2 == 0) ? fThreshHG : fThreshLG;
+      if (trapENFCal[i] >= thresh || trapECal[i] >= thresh) {
+        fNPassed++;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Without the phase-1 cache, the events that do pass are read without prefetching.
+  // That's only a win when most events fail, i.e. for the high-threshold skims.
+  bool IsRecommended() const { return (fThreshHG >= 100. && fThreshLG >= 100.); }
+
+  void Print() const
+  {
+    printf("Prefilter (HG %.0f keV, LG %.0f keV): %li of %li events read in full (%.2f%%)\n",
+      fThreshHG, fThreshLG, fNPassed, fNEvents, fNEvents > 0 ? 100.*fNPassed/fNEvents : 0.);
+  }
+
+  long GetNEvents() const { return fNEvents; }
+  long GetNPassed() const { return fNPassed; }
+
+private:
+  double fThreshHG, fThreshLG;
+  long fNEvents, fNPassed;
+};
+
+#endif
@@ -0,0 +1,393 @@
+// StreamMerge.hh
+// Merges time-ordered event streams (veto events from veto_run files, Ge hits from
+// gatified or skim files, muon lists, ...) into one time-ordered sequence, each event
+// tagged with the stream it came from, so a muon-Ge analysis is one forward pass.
+// C. Wiseman, USC/Majorana
+//
+// Each stream is read through a cursor, one per run and source.  The merge keeps a min-heap
+// of the next event of each open cursor.  Cursors are opened a run at a time, so only the
+// files of one run are open at once; this needs runs not to overlap in time, which holds
+// for real data.
+//
+// Times inside a run are the run's own clock (veto xTime, Ge timestamp/1E8, skim tloc_s, in
+// seconds).  The merged time adds a per-run offset (RunOffsets), which only changes where
+// the clock was reset: the new clock is started after the end of the previous run, plus the
+// unix time between the runs.  So times in the same run, or between runs on the same clock,
+// are exact, and times across a reset are good to the second.
+//
+// Usage:
+//   RunOffsets offsets;
+//   offsets.FromMetadata(RunMetadataStore::Default());
+//   StreamMerge merge(&offsets);
+//   merge.Add(new VetoRunCursor(kVeto, run, "veto_run16797.root"));
+//   merge.Add(new GeCursor(kGe, run, "mjd_run16797.root"));
+//   MergedEvent e;
+//   while (merge.Next(e)) ... e.source, e.run, e.time, e.type, e.value ...
+
+#ifndef STREAMMERGE_H_GUARD
+#define STREAMMERGE_H_GUARD
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <queue>
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include "TFile.h"
+#include "TTree.h"
+#include "MJVetoEvent.hh"
+#include "RunMetadata.hh"
+
+struct MergedEvent
+{
+  int source;         // the tag given to the cursor
+  int run;
+  long entry;         // tree entry (or list index)
+  int hit;            // hit in the entry (Ge), else 0
+  double localTime;   // run clock (sec)
+  double time;        // localTime + the run's offset (sec)
+  int type;           // veto: muon type (1 vertical, 2 side+bottom, 3 run gap).  Ge: channel.
+  double value;       // veto: time uncertainty.  Ge: trapENFCal.
+};
+
+// Seconds added to each run's clock, so that times keep increasing across clock resets.
+class RunOffsets
+{
+public:
+  RunOffsets() {}
+
+  void Set(int run, double offset) { fOffsets[run] = offset; }
+  double Get(int run) const
+  {
+    auto search = fOffsets.find(run);
+    return (search == fOffsets.end()) ? 0 : search->second;
+  }
+  bool Has(int run) const { return fOffsets.find(run) != fOffsets.end(); }
+  size_t GetNRuns() const { return fOffsets.size(); }
+
+  // From the first/last Ge times and unix start/stop of each run.  A run whose clock
+  // starts before the previous run's clock stopped is after a reset.
+  void FromMetadata(const RunMetadataStore &meta)
+  {
+    const RunRecord *prev = NULL;
+    double offset = 0;
+    for (auto &rec : meta.GetRecords()) {
+      const RunRecord &r = rec.second;
+      if (prev != NULL && r.firstGeTS < prev->lastGeTS)
+        offset = (prev->lastGeTS + offset) + (r.unixStart - prev->unixStop) - r.firstGeTS;
+      fOffsets[r.run] = offset;
+      prev = &r;
+    }
+  }
+
+  // Overrides, one per line: run offset.  '#' for comments.
+  bool Load(std::string file)
+  {
+    std::ifstream in(file.c_str());
+    if (!in.good()) return false;
+    std::string line;
+    while (getline(in, line)) {
+      if (line.empty() || line[0] == '#') continue;
+      std::istringstream iss(line);
+      int run;
+      double offset;
+      if (iss >> run >> offset) fOffsets[run] = offset;
+    }
+    return true;
+  }
+
+private:
+  std::map<int,double> fOffsets;
+};
+
+// One run of one stream.  Next() fills everything but 'source', 'run' and 'time'.
+class StreamCursor
+{
+public:
+  StreamCursor(int source, int run) : fSource(source), fRun(run) {}
+  virtual ~StreamCursor() {}
+  virtual bool Open() { return true; }
+  virtual bool Next(MergedEvent &e) = 0;
+  virtual void Close() {}
+  int GetSource() const { return fSource; }
+  int GetRun() const { return fRun; }
+protected:
+  int fSource, fRun;
+};
+
+// A list of times, e.g. one run of a RunCatalog muon list.
+class VectorCursor : public StreamCursor
+{
+public:
+  VectorCursor(int source, int run, const std::vector<double> &times, int type=0)
+    : StreamCursor(source, run), fTimes(times), fType(type), fNext(0) {}
+  bool Next(MergedEvent &e)
+  {
+    if (fNext >= fTimes.size()) return false;
+    e.entry = fNext;
+    e.hit = 0;
+    e.localTime = fTimes[fNext++];
+    e.type = fType;
+    e.value = 0;
+    return true;
+  }
+private:
+  std::vector<double> fTimes;
+  int fType;
+  size_t fNext;
+};
+
+// Muons from an auto-veto output file (vetoTree), typed like skim_mjd_data does:
+// CoinType[0] is type 1, CoinType[1] type 2, and the first entry of a run that starts
+// more than 10 s after the previous run's stop is type 3 (a gap with no veto coverage).
+// Bad scaler muons get an 8 s time uncertainty.
+// prevStop is the stop time of the last entry read, shared by the cursors of consecutive
+// runs (StreamMerge opens them in run order).  Without it, every run is taken to follow a gap.
+// With allEvents, every veto event is returned (type 0 if it isn't a muon).
+class VetoRunCursor : public StreamCursor
+{
+public:
+  VetoRunCursor(int source, int run, std::string file, bool allEvents=false, Long64_t *prevStop=NULL)
+    : StreamCursor(source, run), fFileName(file), fAll(allEvents), fFile(NULL), fTree(NULL), fVeto(NULL), fCoinType(NULL),
+      fStart(0), fStop(0), fPrevStop(prevStop), fOwnStop(0), fEntry(0)
+  {
+    if (fPrevStop == NULL) fPrevStop = &fOwnStop;
+  }
+  ~VetoRunCursor() { Close(); delete fVeto; }
+
+  bool Open()
+  {
+    fFile = TFile::Open(fFileName.c_str());
+    if (fFile == NULL || fFile->IsZombie()) { std::cout << "Couldn't open " << fFileName << std::endl; return false; }
+    fTree = (TTree*)fFile->Get("vetoTree");
+    if (fTree == NULL) { std::cout << fFileName << " has no vetoTree.\n"; return false; }
+    fTree->SetBranchStatus("*",0);
+    fTree->SetBranchStatus("xTime",1);
+    fTree->SetBranchStatus("timeUncert",1);
+    fTree->SetBranchStatus("CoinType",1);
+    fTree->SetBranchStatus("start",1);
+    fTree->SetBranchStatus("stop",1);
+    fTree->SetBranchStatus("vetoEvent",1);
+    fTree->SetBranchAddress("xTime",&fXTime);
+    fTree->SetBranchAddress("timeUncert",&fTimeUncert);
+    fTree->SetBranchAddress("CoinType",&fCoinType);
+    fTree->SetBranchAddress("start",&fStart);
+    fTree->SetBranchAddress("stop",&fStop);
+    fTree->SetBranchAddress("vetoEvent",&fVeto);
+    fEntry = 0;
+    return true;
+  }
+
+  bool Next(MergedEvent &e)
+  {
+    while (fTree != NULL && fEntry < fTree->GetEntries())
+    {
+      fTree->GetEntry(fEntry);
+      int type = 0;
+      if (fCoinType != NULL && fCoinType->size() > 1) {
+        if ((*fCoinType)[0]) type = 1;
+        if ((*fCoinType)[1]) type = 2;   // overrides type 1 if both are true
+      }
+      if (fEntry == 0 && (fStart - *fPrevStop) > 10) type = 3;
+      *fPrevStop = fStop;
+      e.entry = fEntry++;
+      if (type == 0 && !fAll) continue;
+      e.hit = 0;
+      e.localTime = fXTime;   // type 3: the time of the first veto entry in the run
+      e.type = type;
+      e.value = (fVeto != NULL && fVeto->GetBadScaler()) ? 8.0 : fTimeUncert;   // uncertainty for corrupted scalers
+      return true;
+    }
+    return false;
+  }
+
+  void Close()
+  {
+    if (fFile != NULL) { fFile->Close(); delete fFile; }
+    fFile = NULL;
+    fTree = NULL;
+  }
+
+private:
+  std::string fFileName;
+  bool fAll;
+  TFile *fFile;
+  TTree *fTree;
+  MJVetoEvent *fVeto;
+  double fXTime, fTimeUncert;
+  std::vector<int> *fCoinType;
+  Long64_t fStart, fStop;
+  Long64_t *fPrevStop, fOwnStop;
+  long fEntry;
+};
+
+// Ge hits from a gatified file (mjdTree: timestamp/1E8) or a skim file (skimTree: tloc_s).
+// The hits of an entry are returned in time order.  A skim file holds many runs: only the
+// entries of this cursor's run are returned, and since skim files are written in run order,
+// reading stops at the first entry of a later run.
+class GeCursor : public StreamCursor
+{
+public:
+  GeCursor(int source, int run, std::string file, double minEnergy=0)
+    : StreamCursor(source, run), fFileName(file), fMinE(minEnergy), fFile(NULL), fTree(NULL), fSkim(false),
+      fTime(NULL), fEnergy(NULL), fChanD(NULL), fChanI(NULL), fSkimRun(0), fEntry(-1), fNextHit(0) {}
+  ~GeCursor() { Close(); }
+
+  bool Open()
+  {
+    fFile = TFile::Open(fFileName.c_str());
+    if (fFile == NULL || fFile->IsZombie()) { std::cout << "Couldn't open " << fFileName << std::endl; return false; }
+    fTree = (TTree*)fFile->Get("skimTree");
+    fSkim = (fTree != NULL);
+    if (!fSkim) fTree = (TTree*)fFile->Get("mjdTree");
+    if (fTree == NULL) { std::cout << fFileName << " has no mjdTree or skimTree.\n"; return false; }
+    const char *timeName = fSkim ? "tloc_s" : "timestamp";
+    fTree->SetBranchStatus("*",0);
+    fTree->SetBranchStatus(timeName,1);
+    fTree->SetBranchStatus("channel",1);
+    fTree->SetBranchStatus("trapENFCal",1);
+    fTree->SetBranchAddress(timeName,&fTime);
+    fTree->SetBranchAddress("trapENFCal",&fEnergy);
+    if (fSkim) {
+      fTree->SetBranchStatus("run",1);
+      fTree->SetBranchAddress("run",&fSkimRun);
+      fTree->SetBranchAddress("channel",&fChanI);
+    }
+    else fTree->SetBranchAddress("channel",&fChanD);
+    fEntry = -1;
+    fOrder.clear();
+    fNextHit = 0;
+    return true;
+  }
+
+  bool Next(MergedEvent &e)
+  {
+    if (fTree == NULL) return false;
+    while (true)
+    {
+      while (fNextHit < fOrder.size()) {
+        int i = fOrder[fNextHit++];
+        if ((*fEnergy)[i] < fMinE) continue;
+        e.entry = fEntry;
+        e.hit = i;
+        e.localTime = fSkim ? (*fTime)[i] : (*fTime)[i]*1.e-8;
+        e.type = fSkim ? (*fChanI)[i] : (int)(*fChanD)[i];
+        e.value = (*fEnergy)[i];
+        return true;
+      }
+      if (++fEntry >= fTree->GetEntries()) return false;
+      fTree->GetEntry(fEntry);
+      if (fSkim && fSkimRun != fRun) {
+        if (fSkimRun > fRun) return false;
+        fOrder.clear();
+        fNextHit = 0;
+        continue;
+      }
+      size_t nHits = std::min(fTime->size(), fEnergy->size());
+      fOrder.resize(nHits);
+      for (size_t i = 0; i < nHits; i++) fOrder[i] = i;
+      const std::vector<double> &t = *fTime;
+      std::sort(fOrder.begin(), fOrder.end(), [&t](int a, int b) { return t[a] < t[b]; });
+      fNextHit = 0;
+    }
+  }
+
+  void Close()
+  {
+    if (fFile != NULL) { fFile->Close(); delete fFile; }
+    fFile = NULL;
+    fTree = NULL;
+  }
+
+private:
+  std::string fFileName;
+  double fMinE;
+  TFile *fFile;
+  TTree *fTree;
+  bool fSkim;
+  std::vector<double> *fTime, *fEnergy, *fChanD;
+  std::vector<int> *fChanI;
+  int fSkimRun;
+  long fEntry;
+  std::vector<int> fOrder;
+  size_t fNextHit;
+};
+
+class StreamMerge
+{
+public:
+  StreamMerge(const RunOffsets *offsets=NULL) : fOffsets(offsets), fNOut(0), fNBackwards(0), fLastTime(0) {}
+  ~StreamMerge()
+  {
+    for (auto &run : fPending) for (auto c : run.second) delete c;
+    for (auto c : fOpen) delete c;
+  }
+
+  // Takes ownership of the cursor.
+  void Add(StreamCursor *c) { fPending[c->GetRun()].push_back(c); }
+
+  bool Next(MergedEvent &e)
+  {
+    while (fHeap.empty() && OpenNextRun()) {}
+    if (fHeap.empty()) return false;
+    Head h = fHeap.top();
+    fHeap.pop();
+    e = fHead[h.second];
+    Advance(h.second);
+    if (fNOut > 0 && e.time < fLastTime) fNBackwards++;
+    fLastTime = e.time;
+    fNOut++;
+    return true;
+  }
+
+  long GetNEvents() const { return fNOut; }
+  long GetNBackwards() const { return fNBackwards; }   // events earlier than the one before (unsorted input)
+  size_t GetNRunsLeft() const { return fPending.size(); }
+
+private:
+  // time, then the cursor's place in fOpen (so ties keep the order the cursors were added in)
+  typedef std::pair<double,size_t> Head;
+
+  bool OpenNextRun()
+  {
+    for (auto c : fOpen) { c->Close(); delete c; }
+    fOpen.clear();
+    fHead.clear();
+    if (fPending.empty()) return false;
+    auto run = fPending.begin();
+    for (auto c : run->second) {
+      if (!c->Open()) { delete c; continue; }
+      fOpen.push_back(c);
+      fHead.push_back(MergedEvent());
+      Advance(fOpen.size()-1);
+    }
+    fPending.erase(run);
+    return true;
+  }
+
+  // Reads cursor i's next event into its head, and puts it on the heap.
+  void Advance(size_t i)
+  {
+    StreamCursor *c = fOpen[i];
+    MergedEvent &e = fHead[i];
+    if (!c->Next(e)) return;
+    e.source = c->GetSource();
+    e.run = c->GetRun();
+    e.time = e.localTime + ((fOffsets != NULL) ? fOffsets->Get(e.run) : 0);
+    fHeap.push(Head(e.time, i));
+  }
+
+  const RunOffsets *fOffsets;
+  std::map<int, std::vector<StreamCursor*> > fPending;
+  std::vector<StreamCursor*> fOpen;
+  std::vector<MergedEvent> fHead;
+  std::priority_queue<Head, std::vector<Head>, std::greater<Head> > fHeap;
+  long fNOut, fNBackwards;
+  double fLastTime;
+};
+
+#endif
@@ -0,0 +1,214 @@
+// ThresholdStore.hh
+// Run ranges with the same QDC software thresholds, built up from the thresholds
+// auto-veto measures in each run.  With a matching range, auto-veto uses its thresholds
+// and skips the separate MeasurePanelThresholds pass over the run.
+// C. Wiseman, USC/Majorana
+//
+// The pedestals are still histogrammed in auto-veto's first loop, so every run is checked.
+// If any panel's measured threshold is more than the tolerance away from the stored one,
+// the pedestals have shifted: the run is redone with the measured thresholds, and starts
+// a new range.  A run after the end of a range (by at most maxGap run numbers) is
+// assumed to belong to it until proven otherwise.
+//
+// Several auto-veto jobs can share one store: Update() locks it (FileLock.hh), re-reads it,
+// adds the run and saves it, so no job's update is lost.  Adding a run again (reprocessing)
+// doesn't count it twice, and a run with no measured thresholds isn't added.
+//
+// File format ($MJD_VETOTHRESH, or [outputDir]/vetoThresholds.txt), one range per line:
+//   firstRun lastRun nRuns [32 software thresholds]
+//
+// Usage:
+//   ThresholdStore store;
+//   store.Load(ThresholdStore::DefaultFile(outputDir));
+//   vector<int> thresholds;                 // (panel, threshold) pairs, as in auto-veto
+//   if (!store.Find(run, thresholds)) thresholds = MeasurePanelThresholds(...);
+//   ... measure the run's thresholds ...
+//   store.Update(ThresholdStore::DefaultFile(outputDir), run, measured);
+
+#ifndef THRESHOLDSTORE_H_GUARD
+#define THRESHOLDSTORE_H_GUARD
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include "FileLock.hh"
+
+struct ThresholdRange
+{
+  int firstRun, lastRun, nRuns;
+  int thresh[32];
+};
+
+class ThresholdStore
+{
+public:
+  ThresholdStore(int tolerance=10, int maxGap=50) : fTolerance(tolerance), fMaxGap(maxGap) {}
+
+  static std::string DefaultFile(std::string dir)
+  {
+    const char *env = getenv("MJD_VETOTHRESH");
+    return (env != NULL) ? env : dir + "/vetoThresholds.txt";
+  }
+
+  bool Load(std::string file)
+  {
+    fRanges.clear();
+    std::ifstream in(file.c_str());
+    if (!in.good()) return false;
+    std::string line;
+    while (getline(in, line))
+    {
+      if (line.empty() || line[0] == '#') continue;
+      std::istringstream iss(line);
+      ThresholdRange r;
+      if (!(iss >> r.firstRun >> r.lastRun >> r.nRuns)) continue;
+      int i = 0;
+      while (i < 32 && iss >> r.thresh[i]) i++;
+      if (i == 32) Insert(r);
+    }
+    return true;
+  }
+
+  // Rewrites the whole store.  With other jobs writing to it too, use Update.
+  bool Save(std::string file) const
+  {
+    std::string tmp = file + ".tmp";
+    std::ofstream out(tmp.c_str());
+    if (!out.good()) {
+      std::cout << "ThresholdStore: couldn't write " << file << std::endl;
+      return false;
+    }
+    out << "# firstRun  lastRun  nRuns  thresholds (panels 0-31)\n";
+    for (auto &r : fRanges) {
+      out << r.firstRun << " " << r.lastRun << " " << r.nRuns;
+      for (int i = 0; i < 32; i++) out << " " << r.thresh[i];
+      out << "\n";
+    }
+    out.close();
+    return (rename(tmp.c_str(), file.c_str()) == 0);
+  }
+
+  // The range for this run: one containing it, or the one just before it (within maxGap).  NULL if none.
+  const ThresholdRange* FindRange(int run) const
+  {
+    const ThresholdRange *prev = NULL;
+    for (auto &r : fRanges) {
+      if (r.firstRun <= run && run <= r.lastRun) return &r;
+      if (r.lastRun < run) prev = &r;
+    }
+    if (prev != NULL && run - prev->lastRun <= fMaxGap) return prev;
+    return NULL;
+  }
+
+  // (panel, threshold) pairs for this run.
+  bool Find(int run, std::vector<int> &thresholds) const
+  {
+    const ThresholdRange *r = FindRange(run);
+    if (r == NULL) return false;
+    thresholds.clear();
+    for (int i = 0; i < 32; i++) {
+      thresholds.push_back(i);
+      thresholds.push_back(r->thresh[i]);
+    }
+    return true;
+  }
+
+  // Do two sets of (panel, threshold) pairs differ by more than the tolerance?
+  bool Shifted(const std::vector<int> &a, const std::vector<int> &b, bool print=false) const
+  {
+    int ta[32], tb[32];
+    ToArray(a, ta);
+    ToArray(b, tb);
+    bool shifted = false;
+    for (int i = 0; i < 32; i++) {
+      bool off = (ta[i] == 9999 || tb[i] == 9999) ? (ta[i] != tb[i]) : (abs(ta[i] - tb[i]) > fTolerance);
+      if (off && print) printf("  Panel %i threshold moved: %i -> %i\n", i, ta[i], tb[i]);
+      shifted |= off;
+    }
+    return shifted;
+  }
+
+  // A run's measured thresholds.  Extends its range if they agree with it, otherwise starts a new range
+  // (splitting the old one, if the run was inside it).  Returns false if a new range was started.
+  // A run already inside a range it agrees with changes nothing, so reprocessing isn't counted again.
+  // (nRuns is the number of runs that started or extended the range.)
+  bool Add(int run, const std::vector<int> &thresholds)
+  {
+    if (thresholds.empty()) return true;
+    ThresholdRange n;
+    n.firstRun = n.lastRun = run;
+    n.nRuns = 1;
+    ToArray(thresholds, n.thresh);
+    for (size_t k = 0; k < fRanges.size(); k++)
+    {
+      ThresholdRange &r = fRanges[k];
+      bool inside = (r.firstRun <= run && run <= r.lastRun);
+      bool after = (r.lastRun < run && run - r.lastRun <= fMaxGap && (k+1 == fRanges.size() || fRanges[k+1].firstRun > run));
+      if (!inside && !after) continue;
+      std::vector<int> stored;
+      for (int i = 0; i < 32; i++) { stored.push_back(i); stored.push_back(r.thresh[i]); }
+      if (!Shifted(stored, thresholds)) {
+        if (after) { r.lastRun = run; r.nRuns++; }
+        return true;
+      }
+      if (after) break;
+      ThresholdRange hi = r;
+      r.lastRun = run - 1;
+      hi.firstRun = run + 1;
+      if (r.lastRun < r.firstRun) fRanges.erase(fRanges.begin()+k);
+      if (hi.firstRun <= hi.lastRun) Insert(hi);
+      break;
+    }
+    Insert(n);
+    return false;
+  }
+
+  // Add a run to the store in a file shared with other jobs: lock, re-read, add, save.
+  // Returns Add's result.
+  bool Update(std::string file, int run, const std::vector<int> &thresholds)
+  {
+    if (thresholds.empty()) return true;
+    FileLock lock(file);
+    Load(file);
+    bool extended = Add(run, thresholds);
+    Save(file);
+    return extended;
+  }
+
+  // The 32 thresholds of a set of (panel, threshold) pairs, space-separated (e.g. for a Manifest).
+  static std::string ToString(const std::vector<int> &thresholds)
+  {
+    int t[32];
+    ToArray(thresholds, t);
+    std::ostringstream oss;
+    for (int i = 0; i < 32; i++) oss << (i ? " " : "") << t[i];
+    return oss.str();
+  }
+
+  size_t GetNRanges() const { return fRanges.size(); }
+
+private:
+  static void ToArray(const std::vector<int> &pairs, int *thresh)
+  {
+    for (int i = 0; i < 32; i++) thresh[i] = 9999;
+    for (size_t i = 0; i + 1 < pairs.size(); i += 2)
+      if (pairs[i] >= 0 && pairs[i] < 32) thresh[pairs[i]] = pairs[i+1];
+  }
+
+  // Keep the ranges sorted by first run.
+  void Insert(const ThresholdRange &r)
+  {
+    size_t k = 0;
+    while (k < fRanges.size() && fRanges[k].firstRun < r.firstRun) k++;
+    fRanges.insert(fRanges.begin()+k, r);
+  }
+
+  int fTolerance, fMaxGap;
+  std::vector<ThresholdRange> fRanges;
+};
+
+#endif
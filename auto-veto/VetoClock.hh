@@ -0,0 +1,275 @@
+// VetoClock.hh
+// Per-run veto time model, shared by auto-veto and the vetoScan tools.
+// C. Wiseman, A. Lopez
+//
+// The veto has three clocks: the scaler (100 MHz card, resets each run), the SBC
+// (unix time of the readout, ~1 sec resolution), and the Ge trigger card, which is
+// what we ultimately want veto times in.  The model is piecewise linear:
+//   - good scaler:   t = scaler + scalerOffset + jump(entry)
+//   - bad scaler:    t = SBC + sbcOffset                (runs > 8557, SBC is valid)
+//   - no clock:      t = Ge interpolation (runs <= 8557) or the average of the
+//                    nearest timed neighbor entries
+// The SBC wins over a Ge interpolation, as it did in auto-veto before this model, so the
+// interpolated P3END times are only used for entries the SBC can't time.
+// where jump(entry) is the running sum of scaler/SBC desynch (error 18) corrections.
+//
+// Usage: one pass feeding AddEntry for every entry (including skipped ones),
+// optionally SetSync / SetInterp / SetFlushEntry(FindFlushEntry()), then Build().  After that,
+// GetTime(entry) and GetUncertainty(entry) are O(1) lookups.
+// The Ge-derived parameters (which need a scan of the built data) are cached in
+// a small text file, so later passes over the same run don't have to redo them.
+
+#ifndef VETOCLOCK_H_GUARD
+#define VETOCLOCK_H_GUARD
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+#include <cstdio>
+
+class VetoClock
+{
+public:
+  VetoClock(int runNum=0, long nEntries=0) { Reset(runNum, nEntries); }
+
+  void Reset(int runNum, long nEntries)
+  {
+    fRun = runNum;
+    fEntries = nEntries;
+    fScaler.assign(nEntries, 0);
+    fSBC.assign(nEntries, 0);
+    fBadScaler.assign(nEntries, true);
+    fJumpFlag.assign(nEntries, false);
+    fTime.clear();
+    fUnc.clear();
+    fJump.clear();
+    fInterpEntries.clear();
+    fInterpTimes.clear();
+    fInterpUnc.clear();
+    fPrevEntry = -1;
+    fPrevComplete = false;
+    fPrevIndex = -1;
+    fLastFlush = -1;
+    fFlushEntry = 0;
+    fFirstGoodEntry = -1;
+    fScalerOffset = 0;
+    fSBCOffset = 0;
+    fSyncUncert = 0;
+    fSynced = false;
+    fBuilt = false;
+  }
+
+  // Feed one entry.  'complete' is false when the event is missing packets (error 1).
+  // Scaler/SBC desynch (error 18) and buffer flushes (error 25: the scaler index moves
+  // by one) are found here, with the same rules as CheckErrors.
+  void AddEntry(long entry, double scaler, double sbc, bool badScaler, bool complete=true, long scalerIndex=-1)
+  {
+    if (entry < 0 || entry >= fEntries) return;
+    fScaler[entry] = scaler;
+    fSBC[entry] = sbc;
+    fBadScaler[entry] = badScaler;
+
+    if (fFirstGoodEntry < 0 && complete && !badScaler && scaler > 0 && sbc > 0)
+      fFirstGoodEntry = entry;
+
+    if (fPrevEntry >= 0 && complete && fPrevComplete && entry > 1 && scaler > 0 && sbc > 0
+        && !badScaler && !fBadScaler[fPrevEntry]
+        && fabs((scaler - fScaler[fPrevEntry]) - (sbc - fSBC[fPrevEntry])) > 1)
+      fJumpFlag[entry] = true;
+
+    if (fPrevEntry >= 0 && scalerIndex >= 0 && fPrevIndex >= 0 && std::abs(scalerIndex - fPrevIndex) == 1)
+      fLastFlush = entry;
+
+    fPrevEntry = entry;
+    fPrevComplete = complete;
+    fPrevIndex = scalerIndex;
+    fBuilt = false;
+  }
+
+  // Results of the veto-Ge sync (loop 1-a of auto-veto).
+  void SetSync(double scalerOffset, double sbcOffset, double syncUncert)
+  {
+    fScalerOffset = scalerOffset;
+    fSBCOffset = sbcOffset;
+    fSyncUncert = syncUncert;
+    fSynced = true;
+    fBuilt = false;
+  }
+
+  // Ge-interpolated times for bad scaler entries (DS-0 and P3END).
+  void SetInterp(const std::vector<int> &entries, const std::vector<double> &times, const std::vector<double> &unc)
+  {
+    fInterpEntries = entries;
+    fInterpTimes = times;
+    fInterpUnc = unc;
+    fBuilt = false;
+  }
+
+  // Ignore scaler jumps before this entry (deltaSBC is not trustworthy during a buffer flush).
+  void SetFlushEntry(long entry) { fFlushEntry = entry; fBuilt = false; }
+
+  // The first good scaler entry at least 'after' entries past the last buffer flush
+  // (the last entry, if there are only bad scalers left).  0 if there was no flush.
+  long FindFlushEntry(long after=5) const
+  {
+    if (fLastFlush < 0) return 0;
+    long entry = fLastFlush + after;
+    while (entry < fEntries-1 && fBadScaler[entry]) entry++;
+    return entry;
+  }
+
+  void Build()
+  {
+    fTime.assign(fEntries, -1);
+    fUnc.assign(fEntries, -1);
+    fJump.assign(fEntries, 0);
+
+    // Without a Ge sync, put the SBC onto the scaler timebase using the first good entry.
+    double sbcOffset = fSBCOffset;
+    if (!fSynced && fFirstGoodEntry >= 0)
+      sbcOffset = fScaler[fFirstGoodEntry] - fSBC[fFirstGoodEntry];
+    double scalerOffset = fSynced ? fScalerOffset : 0;
+
+    double jump = 0;
+    for (long i = 0; i < fEntries; i++)
+    {
+      if (i > fFlushEntry && fJumpFlag[i] && i > 0)
+        jump += (fSBC[i] - fSBC[i-1]) - (fScaler[i] - fScaler[i-1]);
+      fJump[i] = jump;
+
+      if (!fBadScaler[i]) {
+        fTime[i] = fScaler[i] + scalerOffset + jump;
+        fUnc[i] = fSyncUncert;
+      }
+      else if (fRun > 8557) {
+        fTime[i] = fSBC[i] + sbcOffset;
+        fUnc[i] = fSynced ? fSyncUncert : fSBCResolution;
+      }
+    }
+    for (size_t j = 0; j < fInterpEntries.size(); j++) {
+      long i = fInterpEntries[j];
+      if (i < 0 || i >= fEntries || j >= fInterpTimes.size() || fUnc[i] >= 0) continue;
+      fTime[i] = fInterpTimes[j];
+      fUnc[i] = fInterpUnc[j];
+    }
+
+    // Anything still without a time sits between its nearest timed neighbors.
+    long prevTimed = -1, next = 0;
+    for (long i = 0; i < fEntries; i++)
+    {
+      if (fUnc[i] >= 0) { prevTimed = i; continue; }
+      if (next <= i) {   // once per gap, not once per entry
+        next = i+1;
+        while (next < fEntries && fUnc[next] < 0) next++;
+      }
+      if (prevTimed < 0 || next >= fEntries) continue;
+      double t0 = fTime[prevTimed], t1 = fTime[next];
+      double frac = (double)(i - prevTimed)/(next - prevTimed);
+      fTime[i] = t0 + frac * (t1 - t0);
+      fUnc[i] = fabs(t1 - t0)/2. + std::max(fUnc[prevTimed], fUnc[next]);
+    }
+    fBuilt = true;
+  }
+
+  double GetTime(long entry) const {
+    if (!fBuilt || entry < 0 || entry >= (long)fTime.size()) return -1;
+    return fTime[entry];
+  }
+  double GetUncertainty(long entry) const {
+    if (!fBuilt || entry < 0 || entry >= (long)fUnc.size()) return -1;
+    return fUnc[entry];
+  }
+  double GetJumpCorrection(long entry) const {
+    if (!fBuilt || entry < 0 || entry >= (long)fJump.size()) return 0;
+    return fJump[entry];
+  }
+  bool IsJump(long entry) const {
+    return (entry > fFlushEntry && entry < fEntries && fJumpFlag[entry]);
+  }
+
+  int GetRun() const { return fRun; }
+  long GetEntries() const { return fEntries; }
+  bool IsSynced() const { return fSynced; }
+  bool IsBuilt() const { return fBuilt; }
+  double GetScalerOffset() const { return fScalerOffset; }
+  double GetSBCOffset() const { return fSBCOffset; }
+  double GetSyncUncert() const { return fSyncUncert; }
+  long GetFlushEntry() const { return fFlushEntry; }
+  size_t GetNInterp() const { return fInterpEntries.size(); }
+
+  // ======================= model parameter cache =======================
+
+  static std::string CacheName(std::string dir, int runNum) {
+    char name[500];
+    sprintf(name,"%s/vetoClock_run%i.txt",dir.c_str(),runNum);
+    return std::string(name);
+  }
+
+  // Saves the parameters that can't be recomputed from the veto data alone.
+  bool Save(std::string dir) const
+  {
+    std::ofstream out(CacheName(dir,fRun).c_str());
+    if (!out.good()) return false;
+    out.precision(12);
+    out << "run " << fRun << "\n"
+        << "entries " << fEntries << "\n"
+        << "synced " << fSynced << "\n"
+        << "scalerOffset " << fScalerOffset << "\n"
+        << "sbcOffset " << fSBCOffset << "\n"
+        << "syncUncert " << fSyncUncert << "\n"
+        << "flushEntry " << fFlushEntry << "\n"
+        << "interp " << fInterpEntries.size() << "\n";
+    for (size_t j = 0; j < fInterpEntries.size(); j++)
+      out << fInterpEntries[j] << " " << fInterpTimes[j] << " " << fInterpUnc[j] << "\n";
+    return true;
+  }
+
+  // Returns false (and leaves the model alone) if there is no cache for this run,
+  // or if it was made from a different number of entries.
+  bool Load(std::string dir)
+  {
+    std::ifstream in(CacheName(dir,fRun).c_str());
+    if (!in.good()) return false;
+    std::string key;
+    int run=0, synced=0;
+    long entries=0, flush=0;
+    size_t nInterp=0;
+    double scalerOffset=0, sbcOffset=0, syncUncert=0;
+    in >> key >> run >> key >> entries >> key >> synced
+       >> key >> scalerOffset >> key >> sbcOffset >> key >> syncUncert
+       >> key >> flush >> key >> nInterp;
+    if (in.fail() || run != fRun || entries != fEntries) return false;
+    std::vector<int> iEnt(nInterp);
+    std::vector<double> iTime(nInterp), iUnc(nInterp);
+    for (size_t j = 0; j < nInterp; j++) in >> iEnt[j] >> iTime[j] >> iUnc[j];
+    if (in.fail()) return false;
+
+    if (synced) SetSync(scalerOffset, sbcOffset, syncUncert);
+    SetFlushEntry(flush);
+    SetInterp(iEnt, iTime, iUnc);
+    return true;
+  }
+
+private:
+  int fRun;
+  long fEntries;
+  std::vector<double> fScaler, fSBC;
+  std::vector<bool> fBadScaler, fJumpFlag;
+  std::vector<double> fTime, fUnc, fJump;   // built model
+  std::vector<int> fInterpEntries;
+  std::vector<double> fInterpTimes, fInterpUnc;
+  long fPrevEntry;
+  bool fPrevComplete;
+  long fPrevIndex, fLastFlush;
+  long fFlushEntry;
+  long fFirstGoodEntry;
+  double fScalerOffset, fSBCOffset, fSyncUncert;
+  bool fSynced, fBuilt;
+  static constexpr double fSBCResolution = 1.0;  // sec
+};
+
+#endif
@@ -0,0 +1,90 @@
+// VetoCuts.hh
+// Muon & LED tagging parameters, shared by auto-veto's normal, streaming and retag modes.
+// C. Wiseman, USC/Majorana
+//
+// The defaults are the standard production cuts.  A cuts file overrides any of them,
+// one "key value" pair per line ('#' for comments), e.g.:
+//   LEDMultipThreshold 4
+//   muonQDC 450
+//
+// Keys:
+//   LEDMultipThreshold : LED events have multiplicity > (highest multiplicity in run - this)
+//   LEDSimpleThreshold : multiplicity threshold used when the LED frequency measurement is bad
+//   muonQDC            : QDC a panel must exceed to count toward the energy (gamma) cut
+//   muonPanels         : number of panels over muonQDC needed to pass the energy cut
+//   bothPlanes         : 1: a side (or top/bottom) is hit only if both its planes are.  0: either plane.
+
+#ifndef VETOCUTS_H_GUARD
+#define VETOCUTS_H_GUARD
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <cstdio>
+#include "Provenance.hh"
+
+struct VetoCuts
+{
+  int LEDMultipThreshold;
+  int LEDSimpleThreshold;
+  int muonQDC;
+  int muonPanels;
+  bool bothPlanes;
+
+  VetoCuts() : LEDMultipThreshold(5), LEDSimpleThreshold(10), muonQDC(500), muonPanels(2), bothPlanes(true) {}
+
+  // Returns false for an unknown key or a bad value.
+  bool Set(std::string key, std::string value)
+  {
+    std::istringstream iss(value);
+    int val;
+    if (!(iss >> val)) return false;
+    if (key == "LEDMultipThreshold") LEDMultipThreshold = val;
+    else if (key == "LEDSimpleThreshold") LEDSimpleThreshold = val;
+    else if (key == "muonQDC") muonQDC = val;
+    else if (key == "muonPanels") muonPanels = val;
+    else if (key == "bothPlanes") bothPlanes = (val != 0);
+    else return false;
+    return true;
+  }
+
+  bool Load(std::string file)
+  {
+    std::ifstream in(file.c_str());
+    if (!in.good()) {
+      std::cout << "Couldn't open cuts file " << file << std::endl;
+      return false;
+    }
+    std::string line, key, value;
+    while (getline(in, line))
+    {
+      if (line.empty() || line[0] == '#') continue;
+      std::istringstream iss(line);
+      if (!(iss >> key >> value)) continue;
+      if (!Set(key, value)) {
+        std::cout << "Bad line in cuts file " << file << ": " << line << std::endl;
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void Print() const
+  {
+    printf("Cuts: LEDMultipThreshold %i  LEDSimpleThreshold %i  muonQDC %i  muonPanels %i  bothPlanes %i\n",
+      LEDMultipThreshold, LEDSimpleThreshold, muonQDC, muonPanels, bothPlanes);
+  }
+
+  // Every cut changes the tagging, so they all go in the provenance manifest.
+  void AddParams(Manifest &manifest) const
+  {
+    manifest.AddParam("LEDMultipThreshold", LEDMultipThreshold);
+    manifest.AddParam("LEDSimpleThreshold", LEDSimpleThreshold);
+    manifest.AddParam("muonQDC", muonQDC);
+    manifest.AddParam("muonPanels", muonPanels);
+    manifest.AddParam("bothPlanes", bothPlanes);
+  }
+};
+
+#endif
@@ -0,0 +1,181 @@
+// VetoDecoder.hh
+// Reads only what the veto analysis uses from a VetoTree (32 QDCs, card indexes & event
+// counts, the scaler index, count & time stamp) into a flat VetoRecord, without building
+// an MJVetoEvent or reading the MJTRun in every entry.
+// C. Wiseman, USC/Majorana
+//
+// If the vetoEvent branch is split, the MJTVetoData members are read straight from
+// their leaves (the leaf names are found when the tree is opened).  Otherwise, or if
+// any leaf is missing, the MGTBasicEvent is read and its MJTVetoData copied out.
+// Both modes turn off every other branch of the chain, so give the decoder its own chain.
+//
+// Check it against MJVetoEvent on some runs (./veto-decode-check) before relying on it.
+//
+// Usage:
+//   VetoDecoder dec(vetoChain, run);
+//   VetoRecord r;
+//   for (long i = 0; i < vetoChain->GetEntries(); i++) {
+//     if (!dec.GetEntry(i, r)) continue;
+//     ... r.qdc[panel], r.timeSec, r.scalerIndex ...
+//   }
+
+#ifndef VETODECODER_H_GUARD
+#define VETODECODER_H_GUARD
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "TTree.h"
+#include "TLeaf.h"
+#include "TObjArray.h"
+#include "TClonesArray.h"
+#include "MGTBasicEvent.hh"
+#include "MJTVetoData.hh"
+
+struct VetoRecord
+{
+  long entry;
+  int nData;                  // MJTVetoData objects in the entry (32 if nothing is missing)
+  unsigned int mVeto;
+  uint32_t vetoBits;
+  int qdc[32];
+  bool underThresh[32], overflow[32];
+  long qdcIndex[2];           // ORCA packet index of each QDC card
+  long qec[2];                // each QDC card's event count
+  long scalerIndex, sec;      // scaler packet index & event count
+  unsigned long long timeStamp;
+  double timeSec;             // scaler time stamp / 1E8
+  bool badTS;
+};
+
+class VetoDecoder
+{
+public:
+  VetoDecoder(TTree *chain, int run) : fChain(chain), fEvt(NULL), fMVeto(0), fVetoBits(0), fTreeNum(-1), fSplit(false)
+  {
+    Cards(run, fCard[0], fCard[1]);
+    fChain->SetBranchStatus("*",0);
+    fChain->SetBranchStatus("mVeto",1);
+    fChain->SetBranchStatus("vetoBits",1);
+    fChain->SetBranchAddress("mVeto",&fMVeto);
+    fChain->SetBranchAddress("vetoBits",&fVetoBits);
+    if (fChain->LoadTree(0) >= 0) fSplit = FindLeaves();
+    if (fSplit) {
+      for (auto l : fLeafNames) if (l != "") fChain->SetBranchStatus(l.c_str(),1);
+      fChain->SetBranchStatus(fCountName.c_str(),1);
+    }
+    else {
+      fChain->SetBranchStatus("vetoEvent*",1);
+      fChain->SetBranchAddress("vetoEvent",&fEvt);
+    }
+  }
+
+  // Same VME slots as auto-veto's SetCardNumbers.
+  static void Cards(int run, int &card1, int &card2)
+  {
+    card1 = (run > 45000000) ? 11 : 13;
+    card2 = 18;
+  }
+
+  bool IsSplit() const { return fSplit; }
+
+  bool GetEntry(long i, VetoRecord &r)
+  {
+    if (fChain->GetEntry(i) <= 0) return false;
+    r.entry = i;
+    r.mVeto = fMVeto;
+    r.vetoBits = fVetoBits;
+    for (int j = 0; j < 32; j++) { r.qdc[j] = 0; r.underThresh[j] = r.overflow[j] = false; }
+    r.qdcIndex[0] = r.qdcIndex[1] = r.qec[0] = r.qec[1] = 0;
+    r.scalerIndex = r.sec = 0;
+    r.timeStamp = 0;
+    r.badTS = false;
+    r.nData = 0;
+    if (fSplit) {
+      if (fChain->GetTreeNumber() != fTreeNum && !FindLeaves()) {  // a TChain's leaves change with each file
+        std::cout << "VetoDecoder: file " << fChain->GetTreeNumber() << " of the chain isn't split like the first.  Use separate decoders.\n";
+        return false;
+      }
+      r.nData = (int)fCount->GetValue();
+      for (int k = 0; k < r.nData; k++)
+        Fill(r, (int)fLeaf[kCard]->GetValue(k), (int)fLeaf[kChannel]->GetValue(k), (int)fLeaf[kAmplitude]->GetValue(k),
+          fLeaf[kUnderThresh]->GetValue(k) != 0, fLeaf[kOverflow]->GetValue(k) != 0, (long)fLeaf[kIndex]->GetValue(k),
+          (long)fLeaf[kEventCount]->GetValue(k), (long)fLeaf[kScalerIndex]->GetValue(k), (long)fLeaf[kScalerCount]->GetValue(k),
+          (unsigned long long)fLeaf[kTimeStamp]->GetValue(k), fLeaf[kBadTS]->GetValue(k) != 0);
+    }
+    else {
+      if (fEvt == NULL || fEvt->GetDetectorData() == NULL) return false;
+      r.nData = fEvt->GetDetectorData()->GetEntriesFast();
+      for (int k = 0; k < r.nData; k++) {
+        MJTVetoData *vd = dynamic_cast<MJTVetoData*>(fEvt->GetDetectorData()->At(k));
+        if (vd == NULL) continue;
+        Fill(r, vd->GetCard(), vd->GetChannel(), (int)vd->GetAmplitude(), vd->IsUnderThreshold(), vd->IsOverflow(),
+          vd->GetIndex(), vd->GetEventCount(), vd->GetScalerIndex(), vd->GetScalerCount(), vd->GetTimeStamp(), vd->IsBadTS());
+      }
+    }
+    r.timeSec = r.timeStamp/1E8;
+    return true;
+  }
+
+private:
+  enum { kCard, kChannel, kAmplitude, kUnderThresh, kOverflow, kIndex, kEventCount, kScalerIndex, kScalerCount, kTimeStamp, kBadTS, nLeaves };
+
+  void Fill(VetoRecord &r, int card, int ch, int amp, bool uth, bool ovf, long index, long evtCount,
+    long sIndex, long sCount, unsigned long long ts, bool badTS)
+  {
+    int c = (card == fCard[0]) ? 0 : (card == fCard[1]) ? 1 : -1;
+    if (c < 0 || ch < 0 || ch > 15) return;
+    r.qdc[16*c + ch] = amp;
+    r.underThresh[16*c + ch] = uth;
+    r.overflow[16*c + ch] = ovf;
+    r.qdcIndex[c] = index;
+    r.qec[c] = evtCount;
+    r.scalerIndex = sIndex;
+    r.sec = sCount;
+    r.timeStamp = ts;
+    r.badTS = badTS;
+  }
+
+  // The split leaves of the MJTVetoData members, by the end of their names (MJTVetoData.hh & its bases).
+  bool FindLeaves()
+  {
+    static const std::vector<std::vector<std::string> > members = {
+      {"fCard"}, {"fChannel"}, {"fAmplitude", "fEnergy"}, {"fIsUnderThreshold", "fUnderThreshold"},
+      {"fIsOverflow", "fOverflow"}, {"fIndex"}, {"fEventCount"}, {"fScalerIndex"}, {"fScalerCount"},
+      {"fTimeStamp"}, {"fIsBadTS", "fBadTS"}};
+    fTreeNum = fChain->GetTreeNumber();
+    fLeafNames.assign(nLeaves, "");
+    fCountName = "";
+    TTree *t = fChain->GetTree();
+    TObjArray *leaves = (t != NULL) ? t->GetListOfLeaves() : NULL;
+    if (leaves == NULL) return false;
+    for (int i = 0; i < leaves->GetEntries(); i++) {
+      std::string name = leaves->At(i)->GetName();
+      if (name.find("vetoEvent") != 0 || name.find("fDetectorData") == std::string::npos) continue;
+      if (name.size() > 1 && name.compare(name.size()-1, 1, "_") == 0) fCountName = name;
+      for (int m = 0; m < nLeaves; m++)
+        for (auto &suffix : members[m]) {
+          std::string end = "." + suffix;
+          if (name.size() > end.size() && name.compare(name.size()-end.size(), end.size(), end) == 0) fLeafNames[m] = name;
+        }
+    }
+    if (fCountName == "") return false;
+    for (auto &l : fLeafNames) if (l == "") return false;
+    fCount = t->GetLeaf(fCountName.c_str());
+    for (int m = 0; m < nLeaves; m++) fLeaf[m] = t->GetLeaf(fLeafNames[m].c_str());
+    return true;
+  }
+
+  TTree *fChain;
+  MGTBasicEvent *fEvt;
+  unsigned int fMVeto;
+  uint32_t fVetoBits;
+  int fCard[2];
+  int fTreeNum;
+  bool fSplit;
+  std::string fCountName;
+  std::vector<std::string> fLeafNames;
+  TLeaf *fCount, *fLeaf[nLeaves];
+};
+
+#endif
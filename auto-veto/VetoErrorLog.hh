@@ -0,0 +1,136 @@
+// VetoErrorLog.hh
+// Veto data-quality errors, kept as small binary records instead of being printed
+// one line at a time.  Written as "errorTree" in the veto_run file, and read back with
+// ./veto-errors, which prints or filters them.
+// C. Wiseman, USC/Majorana
+//
+// The records are held in a fixed-size ring, so a run with thousands of buffer flushes
+// (error 25) costs a fixed amount of memory.  If it fills, the oldest records are dropped.
+// The per-code totals are always exact.  Codes 7, 10 and 11 are counted but not recorded
+// (they're set in most entries, since the veto counters aren't reset at the start of runs).
+// Run-level errors (26-30) are recorded with entry = -1.
+//
+// Usage:
+//   VetoErrorLog errLog(nErrs);
+//   errLog.AddEvent(i, Error, veto.GetScalerIndex(), veto.GetTimeSec(), veto.GetTimeSBC(),
+//                   prev.GetTimeSec(), prev.GetTimeSBC());      // once per entry
+//   errLog.Add(-1, 26);                                         // run-level
+//   errLog.Write(runNum);                                       // to the current directory
+
+#ifndef VETOERRORLOG_H_GUARD
+#define VETOERRORLOG_H_GUARD
+
+#include <iostream>
+#include <vector>
+#include "TTree.h"
+
+struct VetoErrorRecord
+{
+  long entry;         // -1 for run-level errors
+  int code;
+  long scalerIndex;
+  double scalerTime, sbcTime;
+  float dScaler, dSBC;  // change since the previous entry
+};
+
+class VetoErrorLog
+{
+public:
+  VetoErrorLog(int nCodes, size_t capacity=100000) : fCount(nCodes, 0), fRecord(nCodes, true),
+    fRing(capacity), fNext(0), fSize(0), fDropped(0)
+  {
+    for (int c : {0, 7, 10, 11}) if (c < nCodes) fRecord[c] = false;
+  }
+
+  // Errors that get reported for every run they're in.
+  static std::vector<int> SeriousCodes() { return {1, 4, 13, 14, 18, 19, 20, 21, 22, 23, 24, 25, 26}; }
+
+  static const char* CodeName(int code)
+  {
+    static const char *names[] = {"",
+      "Missing channels", "Extra channels", "Scaler only", "Bad timestamp", "QDC/scaler index",
+      "Duplicate channels", "HW count mismatch", "Run number mismatch", "MJTVetoData cast failed", "SEC != entry",
+      "SEC != QEC1", "QEC1 != QEC2", "QDC1 index mismatch", "QDC2 index mismatch", "QDC index precedes scaler",
+      "QDC index equals scaler", "Unknown card", "Scaler/SBC desynch", "SEC reset", "SEC jump",
+      "QEC1 reset", "QEC1 jump", "QEC2 reset", "QEC2 jump", "Buffer flush",
+      "Bad LED rate", "No QDC threshold", "No events over threshold", "LED QDC off", "Panel hit rate off"};
+    return (code > 0 && code < (int)(sizeof(names)/sizeof(names[0]))) ? names[code] : "Unknown";
+  }
+
+  void SetRecorded(int code, bool rec) { if (code >= 0 && code < (int)fRecord.size()) fRecord[code] = rec; }
+
+  void Add(long entry, int code, long scalerIndex=0, double scalerTime=0, double sbcTime=0, float dScaler=0, float dSBC=0)
+  {
+    if (code < 0 || code >= (int)fCount.size()) return;
+    fCount[code]++;
+    if (!fRecord[code] || fRing.empty()) return;
+    VetoErrorRecord &r = fRing[fNext];
+    r.entry = entry;
+    r.code = code;
+    r.scalerIndex = scalerIndex;
+    r.scalerTime = scalerTime;
+    r.sbcTime = sbcTime;
+    r.dScaler = dScaler;
+    r.dSBC = dSBC;
+    fNext = (fNext + 1) % fRing.size();
+    if (fSize < fRing.size()) fSize++;
+    else fDropped++;
+  }
+
+  // Every error set in one entry's error vector (as filled by CheckErrors).
+  void AddEvent(long entry, const std::vector<int> &errors, long scalerIndex, double scalerTime, double sbcTime,
+    double prevScalerTime, double prevSBCTime)
+  {
+    for (size_t c = 1; c < errors.size() && c < fCount.size(); c++)
+      if (errors[c]) Add(entry, c, scalerIndex, scalerTime, sbcTime, scalerTime-prevScalerTime, sbcTime-prevSBCTime);
+  }
+
+  long GetCount(int code) const { return (code >= 0 && code < (int)fCount.size()) ? fCount[code] : 0; }
+  size_t GetNRecords() const { return fSize; }
+  long GetNDropped() const { return fDropped; }
+
+  // i-th record, oldest first.
+  const VetoErrorRecord& GetRecord(size_t i) const
+  {
+    size_t first = (fSize < fRing.size()) ? 0 : fNext;
+    return fRing[(first + i) % fRing.size()];
+  }
+
+  // One tree entry per record, in the current directory.  The totals go in "errorCounts".
+  void Write(int run) const
+  {
+    VetoErrorRecord r;
+    TTree *t = new TTree("errorTree", "veto error records");
+    t->Branch("run", &run);
+    t->Branch("entry", &r.entry, "entry/L");
+    t->Branch("code", &r.code, "code/I");
+    t->Branch("scalerIndex", &r.scalerIndex, "scalerIndex/L");
+    t->Branch("scalerTime", &r.scalerTime, "scalerTime/D");
+    t->Branch("sbcTime", &r.sbcTime, "sbcTime/D");
+    t->Branch("dScaler", &r.dScaler, "dScaler/F");
+    t->Branch("dSBC", &r.dSBC, "dSBC/F");
+    for (size_t i = 0; i < fSize; i++) {
+      r = GetRecord(i);
+      t->Fill();
+    }
+    t->Write("", TObject::kOverwrite);
+
+    std::vector<long> counts = fCount;
+    long dropped = fDropped;
+    TTree *c = new TTree("errorCounts", "veto error totals");
+    c->Branch("run", &run);
+    c->Branch("counts", &counts);
+    c->Branch("dropped", &dropped, "dropped/L");
+    c->Fill();
+    c->Write("", TObject::kOverwrite);
+  }
+
+private:
+  std::vector<long> fCount;
+  std::vector<bool> fRecord;
+  std::vector<VetoErrorRecord> fRing;
+  size_t fNext, fSize;
+  long fDropped;
+};
+
+#endif
@@ -0,0 +1,337 @@
+// VetoEventBuilder.hh
+// Builds veto events from raw MJTVetoData records, matching the two QDC cards by their
+// EventCounts in a small reorder buffer, so events split across VetoTree entries by a
+// buffer flush (auto-veto errors 1 and 25) are put back together instead of skipped.
+// C. Wiseman, USC/Majorana
+//
+// The two cards count events separately, and their counters can disagree (error 12) or
+// reset on their own (errors 21, 23).  So each card's EventCount is turned into a common
+// sequence number with its own offset:
+//  - A clean VetoTree entry (16 channels from each card, one EventCount per card, one
+//    scaler index) is one event, so it lines card 2's offset up with card 1's.  A new
+//    offset is taken on the first clean entry, right after a card's reset, or once two
+//    clean entries in a row agree on it (so one odd entry doesn't move it).
+//  - A jump back to an EventCount under 'depth', from further on than 'depth', is a reset
+//    of that card: its sequence carries on from the last number it had.
+//  - A record from before its card's last reset (EventCount well above the card's new
+//    counter) keeps the old offset: it's added to its event if that's still buffered,
+//    or dropped as late.
+// Each record goes in the buffer under its sequence number.  The oldest event leaves the
+// buffer when both cards have all 16 channels, or when the buffer holds more than 'depth'
+// events, so events come out in order, and a card can arrive up to 'depth' events late.
+// Any other record behind the last event sent out is dropped as late.
+//
+// Status of each built event:
+//   kBuilt           both cards, from one VetoTree entry
+//   kRecovered       both cards, from more than one entry (skipped by CheckErrors before)
+//   kMissingCard     one card never arrived
+//   kMissingChannels both cards, but fewer than 32 channels
+//
+// Usage:
+//   VetoEventBuilder builder(run);
+//   BuiltVetoEvent evt;
+//   for each VetoTree entry i:
+//     builder.AddEvent(i, vetoEvent);              // or AddEntry(records of the entry)
+//     while (builder.Next(evt)) ... evt.qdc[panel], evt.status ...
+//   builder.Finish();
+//   while (builder.Next(evt)) ...
+
+#ifndef VETOEVENTBUILDER_H_GUARD
+#define VETOEVENTBUILDER_H_GUARD
+
+#include <iostream>
+#include <cstdio>
+#include <map>
+#include <vector>
+#include <deque>
+#include <utility>
+#include "MGTBasicEvent.hh"
+#include "MJTVetoData.hh"
+
+enum VetoBuildStatus { kBuilt, kRecovered, kMissingCard, kMissingChannels, nBuildStatus };
+
+inline const char* BuildStatusName(int status)
+{
+  if (status==kBuilt) return "built";
+  if (status==kRecovered) return "recovered";
+  if (status==kMissingCard) return "missing card";
+  if (status==kMissingChannels) return "missing channels";
+  return "unknown";
+}
+
+// One MJTVetoData record, and the VetoTree entry it came from.
+struct VetoFragment
+{
+  long entry;
+  int card, channel, amp;
+  bool underThresh, overflow;
+  long index;                   // ORCA packet index of the QDC card
+  unsigned int eventCount;      // QDC card event count
+  long scalerIndex, scalerCount;
+  unsigned long long timeStamp;
+  bool badTS;
+};
+
+struct BuiltVetoEvent
+{
+  int status;
+  long long seq;                // sequence number in the builder (see above)
+  unsigned int eventCount[2];   // each card's EventCount (0 if the card is missing)
+  long firstEntry, lastEntry;   // VetoTree entries its records came from
+  int nChannels;
+  int qdc[32];
+  bool underThresh[32], overflow[32];
+  long qdcIndex[2];
+  long scalerIndex, sec;        // from the first record to arrive
+  unsigned long long timeStamp;
+  double timeSec;
+  bool badTS;
+};
+
+class VetoEventBuilder
+{
+public:
+  // Same VME slots as auto-veto's SetCardNumbers.
+  VetoEventBuilder(int run, size_t depth=16) : fDepth(depth), fAnyOut(false), fLastOut(0), fLearned(false), fHaveCandidate(false),
+    fCandidate(0), fNFragments(0), fNEntries(0), fNPartialEntries(0), fNLate(0), fNDuplicate(0), fNUnknownCard(0), fNResets(0),
+    fNRealigned(0), fMaxSize(0)
+  {
+    fCard[0] = (run > 45000000) ? 11 : 13;
+    fCard[1] = 18;
+    for (int i = 0; i < nBuildStatus; i++) fNBuilt[i] = 0;
+  }
+
+  // Adds every MJTVetoData of a VetoTree entry.  Returns the number added.
+  int AddEvent(long entry, MGTBasicEvent *evt)
+  {
+    fRecords.clear();
+    if (evt != NULL && evt->GetDetectorData() != NULL)
+      for (int k = 0; k < (int)evt->GetDetectorData()->GetEntriesFast(); k++)
+      {
+        MJTVetoData *vd = dynamic_cast<MJTVetoData*>(evt->GetDetectorData()->At(k));
+        if (vd == NULL) continue;
+        VetoFragment f = {entry, (int)vd->GetCard(), vd->GetChannel(), (int)vd->GetAmplitude(), vd->IsUnderThreshold(),
+          vd->IsOverflow(), (long)vd->GetIndex(), vd->GetEventCount(), vd->GetScalerIndex(), (long)vd->GetScalerCount(),
+          vd->GetTimeStamp(), vd->IsBadTS()};
+        fRecords.push_back(f);
+      }
+    return AddEntry(fRecords);
+  }
+
+  // Adds the records of one VetoTree entry.  A clean entry lines the cards' counters up first.
+  int AddEntry(const std::vector<VetoFragment> &records)
+  {
+    fNEntries++;
+    if (records.size() != 32) fNPartialEntries++;
+    else Align(records);
+    for (auto &f : records) Add(f);
+    return (int)records.size();
+  }
+
+  // Adds one record.  (AddEntry does this for each record of an entry.)
+  void Add(const VetoFragment &f)
+  {
+    fNFragments++;
+    int c = CardSlot(f.card);
+    if (c < 0 || f.channel < 0 || f.channel > 15) { fNUnknownCard++; return; }
+    long long seq = Seq(c, f.eventCount);
+    if (fAnyOut && seq <= fLastOut) { fNLate++; return; }
+
+    auto it = fBuf.find(seq);
+    if (it == fBuf.end()) {
+      Pending p;
+      Clear(p, f, seq);
+      it = fBuf.insert(std::make_pair(seq, p)).first;
+    }
+    Pending &p = it->second;
+    unsigned short bit = 1 << f.channel;
+    if (p.chans[c] & bit) { fNDuplicate++; return; }
+    p.chans[c] |= bit;
+    int panel = 16*c + f.channel;
+    p.evt.qdc[panel] = f.amp;
+    p.evt.underThresh[panel] = f.underThresh;
+    p.evt.overflow[panel] = f.overflow;
+    p.evt.qdcIndex[c] = f.index;
+    p.evt.eventCount[c] = f.eventCount;
+    if (f.entry < p.evt.firstEntry) p.evt.firstEntry = f.entry;
+    if (f.entry > p.evt.lastEntry) p.evt.lastEntry = f.entry;
+    Release();
+    if (fBuf.size() > fMaxSize) fMaxSize = fBuf.size();
+  }
+
+  // Takes the next built event, if there is one.
+  bool Next(BuiltVetoEvent &evt)
+  {
+    if (fReady.empty()) return false;
+    evt = fReady.front();
+    fReady.pop_front();
+    return true;
+  }
+
+  // End of the data: send out everything still buffered.
+  void Finish() { while (!fBuf.empty()) Emit(); }
+
+  long GetNBuilt(int status) const { return (status >= 0 && status < nBuildStatus) ? fNBuilt[status] : 0; }
+  long GetNFragments() const { return fNFragments; }
+  long GetNPartialEntries() const { return fNPartialEntries; }
+  long GetNLate() const { return fNLate; }
+  long GetNDuplicate() const { return fNDuplicate; }
+  int GetNResets() const { return fNResets; }
+  int GetNRealigned() const { return fNRealigned; }
+  size_t GetMaxSize() const { return fMaxSize; }
+
+  void Print() const
+  {
+    long nOut = 0;
+    for (int i = 0; i < nBuildStatus; i++) nOut += fNBuilt[i];
+    printf("Event builder: %li records", fNFragments);
+    if (fNEntries > 0) printf(" from %li entries (%li without 32 records)", fNEntries, fNPartialEntries);
+    printf(" -> %li events\n", nOut);
+    for (int i = 0; i < nBuildStatus; i++) printf("  %-17s %li\n", BuildStatusName(i), fNBuilt[i]);
+    printf("  Dropped: %li late, %li duplicate, %li unknown card.  %i EventCount resets (card 1: %i, card 2: %i), card 2 counter offset %lli (moved %i times).\n",
+      fNLate, fNDuplicate, fNUnknownCard, fNResets, fCounter[0].resets, fCounter[1].resets, fCounter[1].offset - fCounter[0].offset, fNRealigned);
+    printf("  Buffer depth %zu, max used %zu.\n", fDepth, fMaxSize);
+  }
+
+private:
+  struct Pending
+  {
+    BuiltVetoEvent evt;
+    unsigned short chans[2];    // channels received from each card
+  };
+
+  // One card's EventCount -> sequence number.
+  struct Counter
+  {
+    Counter() : seen(false), lastEC(0), prevLastEC(0), offset(0), prevOffset(0), lastSeq(0), resets(0) {}
+    bool seen;
+    unsigned int lastEC, prevLastEC;      // highest EventCount since (and before) the last reset
+    long long offset, prevOffset;
+    long long lastSeq;
+    int resets;
+  };
+
+  int CardSlot(int card) const { return (card == fCard[0]) ? 0 : (card == fCard[1]) ? 1 : -1; }
+
+  // Sequence number of a card's EventCount.  Finds the card's resets.
+  long long Seq(int c, unsigned int ec)
+  {
+    Counter &k = fCounter[c];
+    if (!k.seen) {
+      k.seen = true;
+      k.lastEC = ec;
+      k.lastSeq = ec + k.offset;
+      return k.lastSeq;
+    }
+    // from before the card's last reset
+    if (k.resets > 0 && (unsigned long)ec > (unsigned long)k.lastEC + fDepth && (unsigned long)ec <= (unsigned long)k.prevLastEC + fDepth)
+      return ec + k.prevOffset;
+    // counter reset: back near zero, from further than the buffer can reorder
+    if (ec < fDepth && (unsigned long)ec + fDepth < k.lastEC) {
+      k.prevOffset = k.offset;
+      k.prevLastEC = k.lastEC;
+      k.offset = k.lastSeq + 1 - ec;
+      k.lastEC = ec;
+      k.resets++;
+      fNResets++;
+    }
+    long long seq = ec + k.offset;
+    if (ec > k.lastEC) k.lastEC = ec;
+    if (seq > k.lastSeq) k.lastSeq = seq;
+    return seq;
+  }
+
+  // If the entry is one whole event, line card 2's sequence up with card 1's.
+  void Align(const std::vector<VetoFragment> &records)
+  {
+    unsigned short chans[2] = {0, 0};
+    unsigned int ec[2] = {0, 0};
+    for (auto &f : records) {
+      int c = CardSlot(f.card);
+      if (c < 0 || f.channel < 0 || f.channel > 15) return;
+      if (chans[c] != 0 && f.eventCount != ec[c]) return;
+      if (f.scalerIndex != records[0].scalerIndex) return;
+      ec[c] = f.eventCount;
+      chans[c] |= 1 << f.channel;
+    }
+    if (chans[0] != 0xFFFF || chans[1] != 0xFFFF) return;
+    int resets = fCounter[1].resets;
+    long long s0 = Seq(0, ec[0]);
+    Seq(1, ec[1]);
+    long long want = s0 - ec[1];
+    Counter &k = fCounter[1];
+    if (want == k.offset) { fHaveCandidate = false; fLearned = true; return; }
+    if (!fLearned || k.resets != resets || (fHaveCandidate && want == fCandidate)) {
+      if (fLearned) fNRealigned++;
+      k.offset = want;
+      k.lastSeq = s0;
+      fHaveCandidate = false;
+    }
+    else {
+      fHaveCandidate = true;
+      fCandidate = want;
+    }
+    fLearned = true;
+  }
+
+  void Clear(Pending &p, const VetoFragment &f, long long seq)
+  {
+    p.chans[0] = p.chans[1] = 0;
+    BuiltVetoEvent &e = p.evt;
+    e.status = kBuilt;
+    e.seq = seq;
+    e.eventCount[0] = e.eventCount[1] = 0;
+    e.firstEntry = e.lastEntry = f.entry;
+    e.nChannels = 0;
+    for (int j = 0; j < 32; j++) { e.qdc[j] = 0; e.underThresh[j] = e.overflow[j] = false; }
+    e.qdcIndex[0] = e.qdcIndex[1] = 0;
+    e.scalerIndex = f.scalerIndex;
+    e.sec = f.scalerCount;
+    e.timeStamp = f.timeStamp;
+    e.timeSec = f.timeStamp/1E8;
+    e.badTS = f.badTS;
+  }
+
+  void Release()
+  {
+    while (!fBuf.empty()) {
+      const Pending &p = fBuf.begin()->second;
+      if ((p.chans[0] == 0xFFFF && p.chans[1] == 0xFFFF) || fBuf.size() > fDepth) Emit();
+      else break;
+    }
+  }
+
+  // Moves the oldest buffered event to the output.
+  void Emit()
+  {
+    auto it = fBuf.begin();
+    Pending &p = it->second;
+    BuiltVetoEvent &e = p.evt;
+    e.nChannels = __builtin_popcount(p.chans[0]) + __builtin_popcount(p.chans[1]);
+    if (e.nChannels == 32) e.status = (e.firstEntry != e.lastEntry) ? kRecovered : kBuilt;
+    else if (p.chans[0] == 0 || p.chans[1] == 0) e.status = kMissingCard;
+    else e.status = kMissingChannels;
+    fNBuilt[e.status]++;
+    fLastOut = e.seq;
+    fAnyOut = true;
+    fReady.push_back(e);
+    fBuf.erase(it);
+  }
+
+  size_t fDepth;
+  int fCard[2];
+  Counter fCounter[2];
+  bool fAnyOut;
+  long long fLastOut;
+  bool fLearned, fHaveCandidate;        // card 2's offset: set yet?  a new one seen once?
+  long long fCandidate;
+  std::vector<VetoFragment> fRecords;
+  std::map<long long, Pending> fBuf;
+  std::deque<BuiltVetoEvent> fReady;
+  long fNBuilt[nBuildStatus];
+  long fNFragments, fNEntries, fNPartialEntries, fNLate, fNDuplicate, fNUnknownCard;
+  int fNResets, fNRealigned;
+  size_t fMaxSize;
+};
+
+#endif
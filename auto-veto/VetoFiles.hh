@@ -0,0 +1,147 @@
+// VetoFiles.hh
+// Catalog of the veto-only files written by veto-extract, so the veto tools can read
+// a few MB of VetoTree instead of opening the full built file (and its MGTree).
+// C. Wiseman, USC/Majorana
+//
+// Catalog format (one run per line, '#' for comments):
+//   [run] [veto file] [built file] [entries] [built bytes] [veto bytes] [compression] [built mtime]
+// The built file's size and mtime are checked before a veto file is used: if the built file
+// has been rewritten since the extraction, the veto file is stale and is ignored.
+// Set $MJD_VETOFILES to use something other than runs/vetoFiles.txt in the auto-veto
+// directory (MJDVETO_DIR, set by the auto-veto, vetoScan and vetoCheck Makefiles), so the
+// tools find it from any directory.  Save() takes the catalog's FileLock, so parallel
+// veto-extract jobs keep each other's runs.
+//
+// Usage (fall back to the built data if the run hasn't been extracted):
+//   TChain *v = GetExtractedVetoChain(run);
+//   if (v == NULL) v = ds->GetVetoChain();
+
+#ifndef VETOFILES_H_GUARD
+#define VETOFILES_H_GUARD
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <map>
+#include <set>
+#include <cstdlib>
+#include <sys/stat.h>
+#include "TChain.h"
+#include "FileLock.hh"
+
+#ifndef MJDVETO_DIR
+#define MJDVETO_DIR "."
+#endif
+
+class VetoFileCatalog
+{
+public:
+  struct Entry {
+    std::string vetoFile, builtFile;
+    long entries, builtBytes, vetoBytes;
+    int compression;  // -1: fast-cloned, with the built file's compression
+    long builtMtime;  // -1: not recorded (older catalogs), so never matches
+  };
+
+  static std::string DefaultFile()
+  {
+    const char *env = getenv("MJD_VETOFILES");
+    return (env != NULL) ? env : std::string(MJDVETO_DIR) + "/runs/vetoFiles.txt";
+  }
+
+  bool Load(std::string file=DefaultFile())
+  {
+    fEntries.clear();
+    return Read(file, fEntries);
+  }
+
+  // Rewrites the catalog under its lock.  Runs set by someone else since the Load are kept.
+  bool Save(std::string file=DefaultFile())
+  {
+    FileLock lock(file);
+    std::map<int, Entry> onDisk;
+    Read(file, onDisk);
+    for (auto &r : onDisk)
+      if (fSet.find(r.first) == fSet.end()) fEntries[r.first] = r.second;
+    std::string tmp = file + ".tmp";
+    std::ofstream out(tmp.c_str());
+    if (!out.good()) {
+      std::cout << "VetoFileCatalog: couldn't write " << file << std::endl;
+      return false;
+    }
+    out << "# run  vetoFile  builtFile  entries  builtBytes  vetoBytes  compression  builtMtime\n";
+    for (auto &r : fEntries) {
+      const Entry &e = r.second;
+      out << r.first << " " << e.vetoFile << " " << e.builtFile << " " << e.entries << " "
+          << e.builtBytes << " " << e.vetoBytes << " " << e.compression << " " << e.builtMtime << "\n";
+    }
+    out.close();
+    if (rename(tmp.c_str(), file.c_str()) != 0) return false;
+    fSet.clear();
+    return true;
+  }
+
+  void Set(int run, const Entry &e) { fEntries[run] = e; fSet.insert(run); }
+
+  // NULL if the run isn't in the catalog.
+  const Entry* Find(int run) const
+  {
+    auto it = fEntries.find(run);
+    return (it != fEntries.end()) ? &(it->second) : NULL;
+  }
+
+  size_t GetNRuns() const { return fEntries.size(); }
+
+private:
+  static bool Read(std::string file, std::map<int, Entry> &entries)
+  {
+    std::ifstream in(file.c_str());
+    if (!in.good()) return false;
+    std::string line;
+    while (getline(in, line))
+    {
+      if (line.empty() || line[0] == '#') continue;
+      std::istringstream iss(line);
+      int run;
+      Entry e;
+      if (!(iss >> run >> e.vetoFile >> e.builtFile >> e.entries >> e.builtBytes >> e.vetoBytes >> e.compression)) continue;
+      if (!(iss >> e.builtMtime)) e.builtMtime = -1;
+      entries[run] = e;
+    }
+    return true;
+  }
+
+  std::map<int, Entry> fEntries;
+  std::set<int> fSet;   // runs set since the last save
+};
+
+// Path to the run's veto-only file, or "" if it hasn't been extracted, has since been removed,
+// or the built file has changed since (different size or mtime).  If the built file isn't
+// there at all, the veto file is all there is, so it's used.
+inline std::string GetExtractedVetoPath(int run)
+{
+  static VetoFileCatalog cat;
+  static bool loaded = false;
+  if (!loaded) { cat.Load(); loaded = true; }
+  const VetoFileCatalog::Entry *e = cat.Find(run);
+  struct stat st;
+  if (e == NULL || stat(e->vetoFile.c_str(), &st) != 0) return "";
+  if (stat(e->builtFile.c_str(), &st) == 0 && ((long)st.st_size != e->builtBytes || (long)st.st_mtime != e->builtMtime)) {
+    std::cout << "Run " << run << ": " << e->builtFile << " changed since it was extracted.  Ignoring " << e->vetoFile << std::endl;
+    return "";
+  }
+  return e->vetoFile;
+}
+
+// A VetoTree chain on the run's veto-only file.  The caller owns it.  NULL if there isn't one.
+inline TChain* GetExtractedVetoChain(int run)
+{
+  std::string path = GetExtractedVetoPath(run);
+  if (path == "") return NULL;
+  TChain *v = new TChain("VetoTree");
+  if (!v->Add(path.c_str())) { delete v; return NULL; }
+  return v;
+}
+
+#endif
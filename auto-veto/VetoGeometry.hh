@@ -0,0 +1,88 @@
+// VetoGeometry.hh
+// Panel -> plane map for the veto, by run range.  Shared by auto-veto and veto-sweep.
+// C. Wiseman, USC/Majorana
+
+#ifndef VETOGEOMETRY_H_GUARD
+#define VETOGEOMETRY_H_GUARD
+
+#include <map>
+
+inline int PlaneMap(int qdcChan, int runNum=0)
+{
+  // For tagging plane-based coincidences.
+  // This uses a zero-indexed map: {panel number, plane number}
+  std::map<int,int> planes;
+
+  // Geometric planes:
+  // 0: Lower Bottom 	1: Upper Bottom
+  // 2: Top Inner		3: Top Outer
+  // 4: North Inner		5: North Outer
+  // 6: South Inner 	7: South Outer
+  // 8: West Inner		9: West Outer
+  // 10: East Inner 	11: East Outer
+
+  // 32-panel config (default) - began 7/10/15
+  if (runNum < 45000000 && runNum >= 3057) {
+    std::map<int,int> tempMap =
+    {{0,0},  {1,0},  {2,0},  {3,0}, {4,0}, {5,0},
+     {6,1},  {7,1},  {8,1},  {9,1}, {10,1}, {11,1},
+     {12,8}, {13,8}, {14,9}, {15,5},
+     {16,5}, {17,3}, {18,3}, {19,4},
+     {20,2}, {21,2}, {22,9}, {23,4},
+     {24,6}, {25,7}, {26,6}, {27,7},
+     {28,10},{29,11},{30,10},{31,11}};
+    planes = tempMap;
+  }
+  // 1st prototype config (24 panels)
+   else if (runNum >= 45000509 && runNum <= 45004116) {
+    std::map<int,int> tempMap =
+    {{0,0},  {1,0},  {2,0},  {3,0}, {4,0}, {5,0},
+     {6,1},  {7,1},  {8,1},  {9,1}, {10,1}, {11,1},
+     {12,2}, {13,2}, {14,9}, {15,5},
+     {16,5}, {17,3}, {18,3}, {19,4},
+     {20,8}, {21,8}, {22,9}, {23,4},
+     {24,-1},{25,-1},{26,-1},{27,-1},
+     {28,-1},{29,-1},{30,-1},{31,-1}};
+    planes = tempMap;
+  }
+  // 2nd prototype config (24 panels)
+   else if (runNum >= 45004117 && runNum <= 45008659) {
+    std::map<int,int> tempMap =
+    {{0,0},  {1,0},  {2,0},  {3,0}, {4,0}, {5,0},
+     {6,1},  {7,1},  {8,1},  {9,1}, {10,1}, {11,1},
+     {12,8}, {13,8}, {14,9}, {15,5},
+     {16,5}, {17,3}, {18,3}, {19,4},
+     {20,2}, {21,2}, {22,9}, {23,4},
+     {24,-1},{25,-1},{26,-1},{27,-1},
+     {28,-1},{29,-1},{30,-1},{31,-1}};
+    planes = tempMap;
+  }
+  // 1st module 1 (P3JDY) config, 6/24/15 - 7/7/15
+  else if (runNum > 0 && runNum <=3056){
+    std::map<int,int> tempMap =
+    {{0,0},  {1,0},  {2,0},  {3,0}, {4,0}, {5,0},
+     {6,1},  {7,1},  {8,1},  {9,1}, {10,1}, {11,1},
+     {12,8}, {13,8}, {14,9}, {15,5},
+     {16,5}, {17,3}, {18,3}, {19,4},
+     {20,2}, {21,2}, {22,9}, {23,4},
+     {24,-1},{25,-1},{26,-1},{27,-1},
+     {28,-1},{29,-1},{30,-1},{31,-1}};
+    planes = tempMap;
+  }
+  // If the panel is not installed for this run, return -1.
+  else return -1;
+
+  // Otherwise, return the plane index for this panel.
+  int plane = -1;
+  auto search = planes.find(qdcChan);
+  if(search != planes.end()) plane=search->second;
+  return plane;
+}
+
+// The whole map for a run, for loops that look up every panel of every event.
+inline void FillPlaneMap(int runNum, int planes[32])
+{
+  for (int i = 0; i < 32; i++) planes[i] = PlaneMap(i, runNum);
+}
+
+#endif
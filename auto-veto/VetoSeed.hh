@@ -0,0 +1,85 @@
+// VetoSeed.hh
+// Per-run QDC thresholds and LED settings, saved at the end of each auto-veto
+// pass so that the next run can start from them.  The streaming mode (auto-veto -t)
+// has to tag events before it has seen enough of the run to measure these itself.
+// C. Wiseman, USC/Majorana
+//
+// File format (outputDir/vetoSeed_run[run].txt):
+//   run [run]
+//   thresh [32 software thresholds]
+//   LEDperiod [sec]  multipThreshold [m]  highestMultip [m]  badLED [0/1]
+
+#ifndef VETOSEED_H_GUARD
+#define VETOSEED_H_GUARD
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cstdio>
+
+struct VetoSeed
+{
+  int run;
+  int thresh[32];
+  double LEDperiod;
+  int multipThreshold;
+  int highestMultip;
+  bool badLED;
+
+  VetoSeed() : run(0), LEDperiod(9999), multipThreshold(0), highestMultip(0), badLED(true)
+  {
+    for (int i = 0; i < 32; i++) thresh[i] = 9999;
+  }
+
+  static std::string FileName(std::string dir, int runNum) {
+    char name[500];
+    sprintf(name,"%s/vetoSeed_run%i.txt",dir.c_str(),runNum);
+    return std::string(name);
+  }
+
+  bool Save(std::string dir) const
+  {
+    std::ofstream out(FileName(dir,run).c_str());
+    if (!out.good()) return false;
+    out << "run " << run << "\nthresh";
+    for (int i = 0; i < 32; i++) out << " " << thresh[i];
+    out << "\nLEDperiod " << LEDperiod << "  multipThreshold " << multipThreshold
+        << "  highestMultip " << highestMultip << "  badLED " << badLED << "\n";
+    return true;
+  }
+
+  bool Load(std::string dir, int runNum)
+  {
+    std::ifstream in(FileName(dir,runNum).c_str());
+    if (!in.good()) return false;
+    std::string key;
+    VetoSeed s;
+    in >> key >> s.run >> key;
+    for (int i = 0; i < 32; i++) in >> s.thresh[i];
+    in >> key >> s.LEDperiod >> key >> s.multipThreshold >> key >> s.highestMultip >> key >> s.badLED;
+    if (in.fail() || s.run != runNum) return false;
+    *this = s;
+    return true;
+  }
+
+  // The most recent seed before this run, looking back at most maxBack run numbers.
+  bool LoadPrevious(std::string dir, int runNum, int maxBack=50)
+  {
+    for (int r = runNum-1; r >= runNum-maxBack && r > 0; r--)
+      if (Load(dir, r)) return true;
+    return false;
+  }
+};
+
+// The run-level LED decision (auto-veto Error 26: LED off, or a bad LED rate) for a processed run.
+// It's read from the run's seed.  Outputs without one only have the histogram frequency (LEDfreq).
+inline bool IsLEDOff(std::string dir, int run, double LEDfreq, bool &fromSeed)
+{
+  VetoSeed seed;
+  fromSeed = seed.Load(dir, run);
+  if (fromSeed) return seed.badLED;
+  double LEDperiod = (LEDfreq > 0) ? 1/LEDfreq : -1;
+  return (LEDfreq == 9999 || LEDperiod > 20 || LEDperiod < 0);
+}
+
+#endif
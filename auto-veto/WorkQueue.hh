@@ -0,0 +1,172 @@
+// WorkQueue.hh
+// Persistent per-run work queue for the auto-veto daemon (veto-daemon.cc).
+// C. Wiseman, USC/Majorana
+//
+// One record per run: status, number of attempts, and the size & mtime of the
+// built file it was queued for.  The queue is rewritten after every change, so
+// a daemon that's killed picks up where it left off (runs that were in progress
+// go back in the queue).  All methods are safe to call from worker threads.
+// A job that exits with kExitNothingToDo (auto-veto: no veto data in the run) is
+// marked skipped, and isn't retried until its file changes.
+//
+// File format (one run per line, '#' for comments):
+//   run status attempts fileSize mtime path
+
+#ifndef WORKQUEUE_H_GUARD
+#define WORKQUEUE_H_GUARD
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <map>
+#include <mutex>
+#include <cstdio>
+
+class WorkQueue
+{
+public:
+  enum Status { kQueued=0, kRunning=1, kDone=2, kFailed=3, kSkipped=4 };
+  enum { kExitNothingToDo = 2 };
+
+  struct Job {
+    int run;
+    Status status;
+    int attempts;
+    long long fileSize;
+    long mtime;
+    std::string path;
+  };
+
+  WorkQueue(std::string file="", int maxAttempts=3) : fFile(file), fMaxAttempts(maxAttempts) {}
+
+  static const char* StatusName(Status s) {
+    const char *names[] = {"queued","running","done","failed","skipped"};
+    return names[s];
+  }
+
+  bool Load()
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    std::ifstream in(fFile.c_str());
+    if (!in.good()) return false;
+    std::string line, status;
+    while (getline(in, line))
+    {
+      if (line.empty() || line[0] == '#') continue;
+      std::istringstream iss(line);
+      Job j;
+      if (!(iss >> j.run >> status >> j.attempts >> j.fileSize >> j.mtime >> j.path)) continue;
+      j.status = kQueued;
+      if (status == "done") j.status = kDone;
+      else if (status == "failed") j.status = kFailed;
+      else if (status == "skipped") j.status = kSkipped;
+      fJobs[j.run] = j;   // "running" jobs were interrupted: back in the queue
+    }
+    return true;
+  }
+
+  // Queue a run, unless it's already queued, running, or done with this exact file.
+  // A changed file resets the attempt count.  Returns true if the run was (re)queued.
+  bool Enqueue(int run, std::string path, long long fileSize, long mtime)
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    auto search = fJobs.find(run);
+    if (search != fJobs.end()) {
+      Job &j = search->second;
+      bool sameFile = (j.fileSize == fileSize && j.mtime == mtime);
+      if (j.status == kRunning || (sameFile && j.status != kFailed)) return false;
+      if (sameFile && j.attempts >= fMaxAttempts) return false;
+      if (!sameFile) j.attempts = 0;
+      j.status = kQueued;
+      j.fileSize = fileSize;
+      j.mtime = mtime;
+      j.path = path;
+    }
+    else {
+      Job j = {run, kQueued, 0, fileSize, mtime, path};
+      fJobs[run] = j;
+    }
+    SaveLocked();
+    return true;
+  }
+
+  // Claim the next queued run (lowest run number first).  Returns false if there's nothing to do.
+  bool Next(Job &job)
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    for (auto &it : fJobs) {
+      if (it.second.status != kQueued) continue;
+      it.second.status = kRunning;
+      it.second.attempts++;
+      job = it.second;
+      SaveLocked();
+      return true;
+    }
+    return false;
+  }
+
+  // Failed runs are retried until they've had maxAttempts tries.  Skipped runs aren't.
+  void Finish(int run, bool success, bool skipped=false)
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    auto search = fJobs.find(run);
+    if (search == fJobs.end()) return;
+    Job &j = search->second;
+    if (skipped) j.status = kSkipped;
+    else if (success) j.status = kDone;
+    else j.status = (j.attempts < fMaxAttempts) ? kQueued : kFailed;
+    SaveLocked();
+  }
+
+  // Put everything that was done (or gave up) back in the queue, e.g. after a code change.
+  void RequeueAll()
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    for (auto &it : fJobs)
+      if (it.second.status != kRunning) { it.second.status = kQueued; it.second.attempts = 0; }
+    SaveLocked();
+  }
+
+  size_t Count(Status s)
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    size_t n = 0;
+    for (auto &it : fJobs) if (it.second.status == s) n++;
+    return n;
+  }
+
+  bool IsIdle() { return (Count(kQueued) == 0 && Count(kRunning) == 0); }
+
+  void Print()
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    for (auto &it : fJobs)
+      printf("%i  %-8s  attempts %i  %s\n", it.first, StatusName(it.second.status), it.second.attempts, it.second.path.c_str());
+  }
+
+private:
+  // Write to a temp file and rename, so a crash never leaves half a queue.
+  void SaveLocked()
+  {
+    if (fFile == "") return;
+    std::string tmp = fFile + ".tmp";
+    std::ofstream out(tmp.c_str());
+    if (!out.good()) return;
+    out << "# run status attempts fileSize mtime path\n";
+    for (auto &it : fJobs) {
+      const Job &j = it.second;
+      out << j.run << " " << StatusName(j.status) << " " << j.attempts << " "
+          << j.fileSize << " " << j.mtime << " " << j.path << "\n";
+    }
+    out.close();
+    rename(tmp.c_str(), fFile.c_str());
+  }
+
+  std::map<int,Job> fJobs;
+  std::string fFile;
+  int fMaxAttempts;
+  std::mutex fMutex;
+};
+
+#endif
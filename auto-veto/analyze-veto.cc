@@ -42,11 +42,10 @@ int main(int argc, const char** argv)
 void CheckTimingResolution()
 {
   int dsNum = 5;
-  map<int,int> dsMap = {{0,76},{1,51},{3,24},{4,22},{5,80}};
 
   TH1D *hDelta = new TH1D("hDelta","hDelta",1000,-0.001,0.001);
 
-  // for (int i = 0; i <= dsMap[dsNum]; i++) {
+  // for (int i = 0; i < GetNRunSeqs(dsNum); i++) {
   for (int i = 0; i <= 0; i++)
   {
     cout << "Loading DS-" << dsNum << " run sequence " << i << endl;
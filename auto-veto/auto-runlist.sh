@@ -42,5 +42,8 @@ while ((i < ${#RunList[@]})); do
 done
 qsub auto-multijob.sh $tempArray
 
-# 6. clean up
+# 6. daemon mode - keep processing new/changed runs with 8 local workers (see veto-daemon.cc)
+# ./veto-daemon -w /path/to/built/files -o avout -j 8
+
+# 7. clean up
 # cat runs/ds5-incomplete.txt | while read -r line; do mv ./avout/veto_run$line.root ./avout/DS5/; done
\ No newline at end of file
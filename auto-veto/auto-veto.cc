@@ -11,67 +11,148 @@
 #include <fstream>
 #include <string>
 #include <map>
+#include <chrono>
+#include <thread>
 #include "TTreeReader.h"
 #include "TTreeReaderValue.h"
 #include "TTreeReaderArray.h"
 #include "TH1.h"
-#include "TCanvas.h"
-#include "TLine.h"
-#include "TStyle.h"
 #include "TFile.h"
 #include "MJVetoEvent.hh"
 #include "GATDataSet.hh"
 #include "MGTEvent.hh"
 #include "MGVDigitizerData.hh"
+#include "VetoClock.hh"
+#include "VetoSeed.hh"
+#include "Provenance.hh"
+#include "VetoCuts.hh"
+#include "VetoGeometry.hh"
+#include "VetoFiles.hh"
+#include "ReaderSetup.hh"
+#include "VetoErrorLog.hh"
+#include "PanelMonitor.hh"
+#include "ThresholdStore.hh"
+#include "QDCSpectra.hh"
+#include "PlotRecorder.hh"
+#include "WorkQueue.hh"
 
 using namespace std;
 
 const int nErrs = 31;
-vector<int> MeasurePanelThresholds(TChain *vetoChain, string outputDir, bool makePlots=false);
-void ProcessVetoData(TChain *vetoChain, vector<int> thresholds, string outputDir, bool errorCheckOnly=false, bool vetoOnly=false);
+
+// Settings that change the output (these, and the VetoCuts, go in the provenance manifest)
+const int defThreshVal = 35;           // how many QDC above the pedestal we set the threshold at
+const vector<int> SeriousErrors = VetoErrorLog::SeriousCodes();
+vector<int> MeasurePanelThresholds(TChain *vetoChain);
+bool ProcessVetoData(TChain *vetoChain, vector<int> thresholds, string outputDir, const VetoCuts &cuts, bool errorCheckOnly=false, bool vetoOnly=false, bool forceSync=false,
+  vector<int> *measured=NULL, const ThresholdStore *checkThresh=NULL, bool makePlots=false);
+bool StreamVetoData(int run, string runPath, string outputDir, const VetoCuts &cuts, double pollSec=2, double idleSec=600);
+bool RetagVetoData(int run, string outputDir, const VetoCuts &cuts);
 
 void SetCardNumbers(int runNum, int &card1, int &card2);
 int FindThreshold(TH1D *qdcHist, int threshVal, int panel, int runNum);
-int PlaneMap(int qdcChan, int runNum=0);
 bool CheckErrors(MJVetoEvent veto, MJVetoEvent prev, vector<int> &ErrorVec);
 bool CheckErrors(MJVetoEvent veto, MJVetoEvent prev);
+bool IsSeriousError(const vector<int> &ErrorVec);
+int TagMuon(MJVetoEvent &veto, int runNum, const VetoCuts &cuts, bool LEDCut, vector<int> &CoinType, vector<int> &Plane, int &over500Count);
+const char* HitTypeName(int type);
 void FillInterpTimeVectors(int runNum, vector<int> &badEntries, vector<double> &interpTimes,
   vector<double> &interpUnc, vector<long> &packetList);
-double PanelInfo(int run, int panel, string option);
 
 int main(int argc, char** argv)
 {
   // get command line args
   if (argc < 2) {
     cout << "Usage: ./auto-veto [run number]\n"
-         << "                   [-d (optional: draws QDC & multiplicity plots)]\n"
+         << "                   [-d (optional: saves QDC & multiplicity plots in the output.  Draw them with ./veto-render)]\n"
          << "                   [-e (optional: error check only)]\n"
          << "                   [-v (optional: don't access Ge data)]\n"
-         << "                   [-o [directory] (options: specify output location)]\n";
+         << "                   [-s (optional: re-sync with Ge data, ignoring any cached clock model)]\n"
+         << "                   [-o [directory] (options: specify output location)]\n"
+         << "                   [-t (optional: follow a run that's still being written, then process it)]\n"
+         << "                   [-f [file] (optional: built file to use, instead of looking up the run.  default: veto-extract file, if any)]\n"
+         << "                   [--only-stale (optional: skip the run if its output's inputs & settings haven't changed)]\n"
+         << "                   [-c [file] (optional: muon/LED cuts file, see VetoCuts.hh)]\n"
+         << "                   [--remeasure (optional: measure the QDC thresholds, even if the threshold store has them)]\n"
+         << "                   [--retag (optional: re-tag muons & LEDs in an existing veto_run file with new cuts)]\n"
+         << "                   [--io-stats (optional: print read calls & cache efficiency)]\n"
+         << "                   [--prefetch (optional: async prefetching of the input files)]\n";
     return 1;
   }
   int run = stoi(argv[1]);
   if (run > 60000000 && run < 70000000) {
     cout << "Veto data not present in Module 2 runs.  Exiting ...\n";
-    return 1;
+    return WorkQueue::kExitNothingToDo;
   }
   string outputDir = "./";
-  bool makePlots = false, errorCheckOnly = false, vetoOnly = false;
+  string runPath = "";
+  bool makePlots = false, errorCheckOnly = false, vetoOnly = false, forceSync = false, tail = false, onlyStale = false, retag = false, remeasure = false;
   vector<string> opt(argc);
   for (int i=0; i<argc-2; i++) opt[i]=argv[i+2];
   if (find(opt.begin(), opt.end(), "-d") != opt.end()) makePlots=true;
   if (find(opt.begin(), opt.end(), "-e") != opt.end()) errorCheckOnly=true;
   if (find(opt.begin(), opt.end(), "-v") != opt.end()) vetoOnly=true;
+  if (find(opt.begin(), opt.end(), "-s") != opt.end()) forceSync=true;
+  if (find(opt.begin(), opt.end(), "-t") != opt.end()) tail=true;
+  if (find(opt.begin(), opt.end(), "--only-stale") != opt.end()) onlyStale=true;
+  if (find(opt.begin(), opt.end(), "--retag") != opt.end()) retag=true;
+  if (find(opt.begin(), opt.end(), "--remeasure") != opt.end()) remeasure=true;
+  ReaderSetup::ParseArgs(argc, argv);
+  if (find(opt.begin(), opt.end(), "-f") != opt.end()) {
+    int pos = find(opt.begin(), opt.end(), "-f") - opt.begin();
+    runPath = opt[pos+1];
+  }
   if (find(opt.begin(), opt.end(), "-o") != opt.end()) {
     int pos = find(opt.begin(), opt.end(), "-o") - opt.begin();
     outputDir = opt[pos+1]+"/";
   }
+  VetoCuts cuts;
+  if (find(opt.begin(), opt.end(), "-c") != opt.end()) {
+    int pos = find(opt.begin(), opt.end(), "-c") - opt.begin();
+    if (!cuts.Load(opt[pos+1])) return 1;
+    cuts.Print();
+  }
+
+  // Only re-do the tagging, from the decoded events in veto_run.  Doesn't touch the built data.
+  if (retag) return RetagVetoData(run, outputDir, cuts) ? 0 : 1;
 
-  // Only get the run path (so we can use veto-only runs if necessary)
+  // Only get the run path (so we can use veto-only runs if necessary).
+  // A veto-only file from veto-extract is much smaller than the built file, so use it if there is one.
   GATDataSet ds;
-  string runPath = ds.GetPathToRun(run,GATDataSet::kBuilt);
+  if (runPath == "" && !tail) runPath = GetExtractedVetoPath(run);
+  if (runPath == "") runPath = ds.GetPathToRun(run,GATDataSet::kBuilt);
   // string runPath = "./stage/OR_run"+std::to_string(run)+".root"; // manually set path
 
+  // Watch the run as it's written, then do the standard processing on the finished file.
+  if (tail && !StreamVetoData(run, runPath, outputDir, cuts)) return 1;
+
+  // QDC thresholds from the threshold store, if it has them for this run range.
+  ThresholdStore store;
+  string storeFile = ThresholdStore::DefaultFile(outputDir);
+  store.Load(storeFile);
+  vector<int> thresholds, measured;
+  bool stored = !remeasure && store.Find(run, thresholds);
+
+  // Provenance: the built file, the settings that change veto_run, and the QDC thresholds used.
+  // Measured thresholds aren't known until the run is read, so a run without stored ones is never up to date.
+  char outputFile[200];
+  sprintf(outputFile,"%s/veto_run%i.root",outputDir.c_str(),run);
+  Manifest manifest("auto-veto"), prevManifest;
+  manifest.AddInput(runPath);
+  manifest.AddParam("threshVal", defThreshVal);
+  cuts.AddParams(manifest);
+  manifest.AddParam("vetoOnly", vetoOnly);
+  manifest.AddParam("thresholds", stored ? ThresholdStore::ToString(thresholds) : "measured");
+  bool havePrev = prevManifest.Load(Manifest::FileName(outputFile));
+  if (onlyStale && !errorCheckOnly && !tail) {
+    string why = "no stored QDC thresholds";
+    if (stored && manifest.IsUpToDate(outputFile, why)) {
+      cout << "Run " << run << " is up to date (" << Manifest::FileName(outputFile) << ").  Skipping ...\n";
+      return 0;
+    }
+    cout << "Run " << run << " is stale: " << why << endl;
+  }
+
   TChain *vetoChain = new TChain("VetoTree");
   if (!vetoChain->Add(runPath.c_str())){
     cout << "File doesn't exist.  Exiting ...\n";
@@ -80,27 +161,42 @@ int main(int argc, char** argv)
 
   printf("\n========= Processing run %i ... %lli entries. =========\n",run,vetoChain->GetEntries());
   cout << "Path: " << runPath << endl;
-  if (vetoChain->GetEntries() < 1) { cout << "Warning: no veto data in run. Exiting...\n"; return 1; }
+  if (vetoChain->GetEntries() < 1) { cout << "Warning: no veto data in run. Exiting...\n"; return WorkQueue::kExitNothingToDo; }
 
   // Find the QDC pedestal location in each channel.
   // Set a software threshold value above this location,
   // and optionally output plots that confirm this choice.
-  vector<int> thresholds = MeasurePanelThresholds(vetoChain, outputDir, makePlots);
+  // If the threshold store has them for this run range, skip the pass over the run to find them.
+  ReaderSetup vetoIO(vetoChain, "VetoTree");
+  vetoIO.SetBranches({"run","mVeto","vetoBits","vetoEvent"});
+  vetoIO.Apply();
+  if (stored) printf("Using stored QDC thresholds for run %i (%s)\n", run, storeFile.c_str());
+  else thresholds = MeasurePanelThresholds(vetoChain);
 
   // Check for data quality errors,
   // tag muon and LED events in veto data,
   // and output a ROOT file for further analysis.
-  ProcessVetoData(vetoChain, thresholds, outputDir, errorCheckOnly, vetoOnly);
+  // If the stored thresholds turn out to be off (the pedestals shifted), redo the run with the measured ones.
+  if (!ProcessVetoData(vetoChain, thresholds, outputDir, cuts, errorCheckOnly, vetoOnly, forceSync, &measured, stored ? &store : NULL, makePlots)) {
+    cout << "Pedestals have shifted since the stored thresholds.  Re-processing with the measured ones ...\n";
+    thresholds = measured;
+    ProcessVetoData(vetoChain, thresholds, outputDir, cuts, errorCheckOnly, vetoOnly, forceSync, &measured, NULL, makePlots);
+  }
+  vetoIO.Finish();
+  // (Other auto-veto jobs may be updating the store too: Update locks it and re-reads it first.)
+  if (!measured.empty() && !store.Update(storeFile, run, measured)) printf("Started a new QDC threshold range at run %i.\n", run);
+  manifest.AddParam("thresholds", ThresholdStore::ToString(thresholds));
+  if (!errorCheckOnly) manifest.Save(Manifest::FileName(outputFile), havePrev ? &prevManifest : NULL);
 
   printf("=================== Done processing. ====================\n\n");
   return 0;
 }
 
-vector<int> MeasurePanelThresholds(TChain *vetoChain, string outputDir, bool makePlots)
+vector<int> MeasurePanelThresholds(TChain *vetoChain)
 {
   // format: (panel 1) (threshold 1) (panel 2) (threshold 2) ...
   vector<int> thresholds;
-  int threshVal = 35;	// how many QDC above the pedestal we set the threshold at
+  int threshVal = defThreshVal;
 
   long vEntries = vetoChain->GetEntries();
   TTreeReader reader(vetoChain);
@@ -112,19 +208,13 @@ vector<int> MeasurePanelThresholds(TChain *vetoChain, string outputDir, bool mak
   int runNum = vRun->GetRunNumber();
   reader.SetTree(vetoChain);  // resets the reader
 
-  gStyle->SetOptStat(0);
   int bins=500, lower=0, upper=500;
   TH1D *hLowQDC[32];
-  TH1D *hFullQDC[32];
   char hname[50];
   for (int i = 0; i < 32; i++) {
     sprintf(hname,"hLowQDC%d",i);
     hLowQDC[i] = new TH1D(hname,hname,bins,lower,upper);
-    sprintf(hname,"hFullQDC%d",i);
-    hFullQDC[i] = new TH1D(hname,hname,420,0,4200);
   }
-  sprintf(hname,"Run %i Hit Multiplicity",runNum);
-  TH1D *hMultip = new TH1D("hMultip",hname,32,0,32);
 
   // Set all thresholds to 1, causing all entries to have a multiplicity of 32
   int def[32] = {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1};
@@ -153,7 +243,6 @@ vector<int> MeasurePanelThresholds(TChain *vetoChain, string outputDir, bool mak
       }
       for (int q = 0; q < 32; q++) {
         hLowQDC[q]->Fill(veto.GetQDC(q));
-        hFullQDC[q]->Fill(veto.GetQDC(q));
     }
     // save previous entries for the event error check
     prev = veto;
@@ -172,84 +261,31 @@ vector<int> MeasurePanelThresholds(TChain *vetoChain, string outputDir, bool mak
   // for (int i = 0; i < 32; i++)
     // cout << i << " " << thresh[i] << endl;
 
-  if (makePlots)
-  {
-    // re-scan with the found thresholds to make a multiplicity plot
-    reader.SetTree(vetoChain);  // resets the reader
-    while (reader.Next())
-    {
-      long i = reader.GetCurrentEntry();
-      int run = vRun->GetRunNumber();
-      veto.SetSWThresh(thresh);
-      veto.WriteEvent(i,&*vRun,&*vEvt,*vBits,run,true);
-      if (CheckErrors(veto,prev))
-      {
-        skippedEvents++;
-        // do the end of event resets before continuing
-        prev = veto;
-        veto.Clear();
-          continue;
-        }
-      hMultip->Fill(veto.GetMultip());
-      // save previous entries for the event error check
-      prev = veto;
-      veto.Clear();
-    }
-    TCanvas *c1 = new TCanvas("c1","full QDC",1600,1200);
-    c1->Divide(8,4,0,0);
-    for (int i=0; i<32; i++)
-    {
-      c1->cd(i+1);
-      TVirtualPad *vpad1 = c1->cd(i+1); vpad1->SetLogy();
-      hFullQDC[i]->Draw();
-    }
-    TCanvas *c2 = new TCanvas("c2","QDC thresholds",1600,1200);
-    c2->Divide(8,4,0,0);
-    for (int i=0; i<32; i++)
-    {
-      c2->cd(i+1);
-      TVirtualPad *vpad2 = c2->cd(i+1); vpad2->SetLogy();
-      hLowQDC[i]->GetXaxis()->SetRange(lower,upper);
-      hLowQDC[i]->Draw();
-      double ymax = hLowQDC[i]->GetMaximum();
-      TLine *line = new TLine(thresh[i],0,thresh[i],ymax+10);
-      line->SetLineColor(kRed);
-      line->SetLineWidth(2.0);
-      line->Draw();
-    }
-    TCanvas *c3 = new TCanvas("c3","multiplicity",800,600);
-    c3->cd();
-    c3->SetLogy();
-    hMultip->Draw();
-
-    c1->Print(TString::Format("%s/veto-%i-qdc.pdf",outputDir.c_str(),runNum));
-    c2->Print(TString::Format("%s/veto-%i-qdcThresh.pdf",outputDir.c_str(),runNum));
-    c3->Print(TString::Format("%s/veto-%i-multip.pdf",outputDir.c_str(),runNum));
-  }
+  for (int i = 0; i < 32; i++) delete hLowQDC[i];
   return thresholds;
 }
 
-void ProcessVetoData(TChain *vetoChain, vector<int> thresholds, string outputDir, bool errorCheckOnly, bool vetoOnly)
+bool ProcessVetoData(TChain *vetoChain, vector<int> thresholds, string outputDir, const VetoCuts &cuts, bool errorCheckOnly, bool vetoOnly, bool forceSync,
+  vector<int> *measured, const ThresholdStore *checkThresh, bool makePlots)
 {
+  // Returns false (and stops after the 1st loop) if checkThresh is given and the
+  // thresholds differ from the ones measured in this run.
   // QDC software threshold (obtained from MeasurePanelThresholds)
   int swThresh[32] = {0};
   for (int i = 0; i < (int)thresholds.size(); i+=2)
     swThresh[thresholds[i]] = thresholds[i+1];
 
   // LED variables
-  int LEDMultipThreshold=5;  // "multipThreshold" = "highestMultip" - "LEDMultipThreshold"
-  int LEDSimpleThreshold=10;  // used when LED frequency measurement is bad.
+  int LEDMultipThreshold = cuts.LEDMultipThreshold;
+  int LEDSimpleThreshold = cuts.LEDSimpleThreshold;
   int highestMultip=0, multipThreshold=0;
   double LEDfreq=0, LEDperiod=0;
   bool badLEDFreq=false;
   bool LEDTurnedOff = false;
   int simpleLEDCount=0;
   bool useSimpleThreshold=false;
-  double LEDQDCTotal[32] = {0};
-  int nonLEDHitCount[32] = {0};
 
   // Error check variables
-  vector<int> SeriousErrors = {1, 4, 13, 14, 18, 19, 20, 21, 22, 23, 24, 25, 26};
   int SeriousErrorCount = 0;
   int TotalErrorCount = 0;
   vector<int> Error(nErrs); // write this to ROOT tree
@@ -271,7 +307,6 @@ void ProcessVetoData(TChain *vetoChain, vector<int> thresholds, string outputDir
 
   // muon ID variables
   bool LEDCut = true;
-  bool EnergyCut = false;
   vector<int> CoinType(32), Plane(32);
 
   // initialize input data
@@ -336,6 +371,9 @@ void ProcessVetoData(TChain *vetoChain, vector<int> thresholds, string outputDir
   // error variables
   vetoTree->Branch("Errors",&Error);
 
+  // Error records, written as errorTree (VetoErrorLog.hh)
+  VetoErrorLog errLog(nErrs);
+
   // Error "garbage event" tree
   TTree *skipTree = new TTree("skipTree","skipped veto events");
   skipTree->Branch("run",&runNum);
@@ -354,17 +392,29 @@ void ProcessVetoData(TChain *vetoChain, vector<int> thresholds, string outputDir
   vector<int> badEntries;
   vector<long> packetList;
 
+  // Every entry (including skipped ones) goes into the time model.
+  VetoClock clock(runNum, vEntries);
+  PanelMonitor panels(runNum);  // per-panel hit rates & QDC, for errors 29 and 30
+  if (start > 0 && stop > start) panels.SetDuration(unixDuration);   // bounds the rate bins
+
   int syncEvent = 5;
   if (syncEvent > vEntries) syncEvent=1;
   bool foundSyncEvent = false;
-  bool foundBufferFlush = false;
   TH1D *LEDDeltaT = new TH1D("LEDDeltaT","LEDDeltaT",100000,0,100); // 0.001 sec/bin
+  TH1D *hPedQDC[32];  // same as MeasurePanelThresholds, to check (or store) the thresholds without another pass
+  for (int j = 0; j < 32; j++) hPedQDC[j] = new TH1D(TString::Format("hPedQDC%d",j),"",500,0,500);
+  TH1D *hFullQDC[32] = {NULL}, *hMultip = NULL;  // -d
+  if (makePlots) {
+    for (int j = 0; j < 32; j++) hFullQDC[j] = new TH1D(TString::Format("hFullQDC%d",j),TString::Format("hFullQDC%d",j),420,0,4200);
+    hMultip = new TH1D("hMultip",TString::Format("Run %i Hit Multiplicity",runNum),32,0,32);
+  }
   while(reader.Next())
   {
     long i = reader.GetCurrentEntry();
     veto.Clear();
     veto.SetSWThresh(swThresh);
     veto.WriteEvent(i,&*vRun,&*vEvt,*vBits,runNum,true);
+    clock.AddEntry(i, veto.GetTimeSec(), veto.GetTimeSBC(), veto.GetBadScaler(), !veto.GetError(1), veto.GetScalerIndex());
 
     if (veto.GetBadScaler() && (runNum < 6965 || runNum > 45000000)) {
       badEntries.push_back(i);
@@ -375,13 +425,11 @@ void ProcessVetoData(TChain *vetoChain, vector<int> thresholds, string outputDir
       firstGoodScaler = veto.GetTimeSec();
     if (!veto.GetBadScaler()) lastGoodScaler = veto.GetTimeSec();
 
-    if (CheckErrors(veto,prev,Error)){
+    // Count (and record) the errors here, so there's no separate pass over the run for them.
+    bool skip = CheckErrors(veto,prev,Error);
+    errLog.AddEvent(i, Error, veto.GetScalerIndex(), veto.GetTimeSec(), veto.GetTimeSBC(), prev.GetTimeSec(), prev.GetTimeSBC());
+    if (skip){
       skippedEvents++;
-      if (Error[25]) {
-        foundBufferFlush = true;
-        entryAfterFlush = i;
-        // cout << i << " Found buffer flush.  Index: " << veto.GetScalerIndex() << endl;
-      }
       // do end of loop reset
       prev = veto;
       continue;
@@ -391,36 +439,63 @@ void ProcessVetoData(TChain *vetoChain, vector<int> thresholds, string outputDir
       foundSyncEvent = true;
       sync = veto;
     }
+    for (int j = 0; j < 32; j++) hPedQDC[j]->Fill(veto.GetQDC(j));
+    if (makePlots) {
+      for (int j = 0; j < 32; j++) hFullQDC[j]->Fill(veto.GetQDC(j));
+      hMultip->Fill(veto.GetMultip());
+    }
     if (veto.GetMultip() > highestMultip)
       highestMultip = veto.GetMultip();
 
     if (veto.GetMultip() > LEDSimpleThreshold) {
       LEDDeltaT->Fill(veto.GetTimeSec()-prev.GetTimeSec());
       simpleLEDCount++;
-
-      // Find total qdc for error 29
-      for (int j = 0; j < 32; j++) LEDQDCTotal[j] += veto.GetQDC(j);
     }
-
-    // Count number of non-LED panel hits
-    for (int j = 0; j < 32; j++)
-      if (veto.GetQDC(j) > veto.GetSWThresh(j) && veto.GetMultip() <= LEDSimpleThreshold)
-        nonLEDHitCount[j]++;
+    panels.Fill(veto, veto.GetTimeSec(), veto.GetMultip() > LEDSimpleThreshold);
 
     // end of loop reset
     prev = veto;
   }
-  if (foundBufferFlush) {
-    entryAfterFlush += syncEvent;
-    while(1){
-      if (entryAfterFlush >= vEntries-1) break;
-      cout << "Warning: found buffer flush.  Syncing with entry : " << entryAfterFlush << endl;
-      reader.SetTree(vetoChain); // reset the reader
-      reader.SetEntry(entryAfterFlush);
-      sync.WriteEvent(entryAfterFlush,&*vRun,&*vEvt,*vBits,runNum,true);
-      if (!sync.GetBadScaler()) break; // don't sync off a bad scaler
-      else entryAfterFlush++;
+  for (int j=0; j<nErrs; j++) ErrorCount[j] = errLog.GetCount(j);
+  std::fill(Error.begin(), Error.end(), 0);
+
+  // This run's own thresholds.  If they don't match the ones we were given, the caller re-runs with them.
+  // The spectra are saved in the output (qdcSpectra), so ./veto-rethresh can redo this later.
+  // With -d, the QDC & multiplicity plots are saved as plotData, for ./veto-render.
+  vector<int> runThresh;
+  QDCSpectra spectra(runNum);
+  PlotRecorder plots;
+  string qdcName = TString::Format("veto-%i-qdc",runNum).Data(), threshName = TString::Format("veto-%i-qdcThresh",runNum).Data();
+  plots.SetLayout(qdcName, 8, 4, 1600, 1200);
+  plots.SetLayout(threshName, 8, 4, 1600, 1200);
+  for (int j = 0; j < 32; j++) {
+    spectra.Fill(j, hPedQDC[j]);
+    runThresh.push_back(j);
+    runThresh.push_back(FindThreshold(hPedQDC[j],defThreshVal,j,runNum));
+    if (makePlots) {
+      plots.AddHist(qdcName, j+1, hFullQDC[j], true);
+      plots.AddHist(threshName, j+1, hPedQDC[j], true, swThresh[j]);
+      delete hFullQDC[j];
     }
+    delete hPedQDC[j];
+  }
+  if (makePlots) {
+    plots.AddHist(TString::Format("veto-%i-multip",runNum).Data(), 0, hMultip, true);
+    delete hMultip;
+  }
+  if (measured != NULL) *measured = runThresh;
+  if (checkThresh != NULL && checkThresh->Shifted(thresholds, runThresh, true)) {
+    delete LEDDeltaT;
+    RootFile->Close();
+    return false;
+  }
+  // After a buffer flush, sync off the first good scaler a few entries past it.
+  entryAfterFlush = clock.FindFlushEntry(syncEvent);
+  if (entryAfterFlush > 0 && entryAfterFlush < vEntries-1) {
+    cout << "Warning: found buffer flush.  Syncing with entry : " << entryAfterFlush << endl;
+    reader.SetTree(vetoChain); // reset the reader
+    reader.SetEntry(entryAfterFlush);
+    sync.WriteEvent(entryAfterFlush,&*vRun,&*vEvt,*vBits,runNum,true);
   }
 
   // ============== Loop 1-a: Scan built data for rough sync ==============
@@ -428,14 +503,28 @@ void ProcessVetoData(TChain *vetoChain, vector<int> thresholds, string outputDir
   // Find times of Ge events whose packets are immediately before and after the "sync" event.
   // NOTE: In the event that "sync" is still within a buffer flush, this may fail to
   //       find a "before" event.  (this is rare.)
-
-  if (foundSyncEvent && !vetoOnly)
+  // If a previous pass left a clock model for this run, its sync results are reused.
+
+  bool cachedClock = (!forceSync && clock.Load(outputDir));
+  if (cachedClock) {
+    cout << "Using cached clock model: " << VetoClock::CacheName(outputDir,runNum) << endl;
+    applyOffset = clock.IsSynced();
+    scalerOffset = clock.GetScalerOffset();
+    sbcOffset = clock.GetSBCOffset();
+    syncUncert = clock.GetSyncUncert();
+    sbcUnc = syncUncert;
+  }
+  else if (foundSyncEvent && !vetoOnly)
   {
     GATDataSet *ds = new GATDataSet(runNum);
     TChain *builtChain = ds->GetBuiltChain(false);
     MGTEvent *evt=0;
     MGVDigitizerData *dig=0;
     builtChain->SetBranchAddress("event",&evt);
+    ReaderSetup builtIO(builtChain, "MGTree");
+    builtIO.SetBranches({"event"});
+    builtIO.SetDisableOthers(true);
+    builtIO.Apply();
     double bTimeFirst=0, bTimeBefore=0, bTimeAfter=0;
     uint64_t bItr=0,bIndex=0;
     int packetDiff = 99999999, minPacketDiff = 99999999;
@@ -499,12 +588,20 @@ void ProcessVetoData(TChain *vetoChain, vector<int> thresholds, string outputDir
     sbcOffset=0;
     sbcUnc=0;
   }
+  else if (!cachedClock) clock.SetSync(scalerOffset, sbcOffset, syncUncert);
 
   // If we're in DS-0 or P3END, find interpolated times for bad scalers.
-  vector<double> interpTimes(badEntries.size());
-  vector<double> interpUnc(badEntries.size());
-  if (runNum <= 6965 || runNum > 45000000)
+  if (!cachedClock && (runNum <= 6965 || runNum > 45000000)) {
+    vector<double> interpTimes(badEntries.size());
+    vector<double> interpUnc(badEntries.size());
     FillInterpTimeVectors(runNum, badEntries, interpTimes, interpUnc, packetList);
+    clock.SetInterp(badEntries, interpTimes, interpUnc);
+  }
+
+  // Build the time model, and save it if we did the (slow) Ge scans for it.
+  clock.SetFlushEntry(entryAfterFlush);
+  clock.Build();
+  if (!cachedClock && !vetoOnly) clock.Save(outputDir);
 
   // =======================================================================
   cout << "===================== Veto Error Report =====================\n";
@@ -525,6 +622,7 @@ void ProcessVetoData(TChain *vetoChain, vector<int> thresholds, string outputDir
   for (int i=0; i < 32; i++) if (swThresh[i] == 9999) {
     Error[27]=true;
     ErrorCount[27]++;
+    errLog.Add(-1,27);
     cout << "Warning: Couldn't find QDC threshold for panel " << i << ". Set to 9999\n";
   }
 
@@ -560,127 +658,49 @@ void ProcessVetoData(TChain *vetoChain, vector<int> thresholds, string outputDir
   // Error 26: LED frequency very low/high, corrupted, or LED's off.
   if (LEDperiod > 20 || LEDperiod < 0 || badLEDFreq) {
     ErrorCount[26]++;
+    errLog.Add(-1,26);
     Error[26] = true;
   }
 
+  // Save the thresholds and LED settings, so the next run can be streamed with them.
+  VetoSeed seed;
+  seed.run = runNum;
+  for (int i = 0; i < 32; i++) seed.thresh[i] = swThresh[i];
+  seed.LEDperiod = LEDperiod;
+  seed.multipThreshold = multipThreshold;
+  seed.highestMultip = highestMultip;
+  seed.badLED = Error[26];
+  seed.Save(outputDir);
+
   // Error 29: LED-QDC mean deviates from expected value by > 3 sigma
-  // Implemented for DS3 and onward.
-  if (simpleLEDCount > 30 && runNum > 16797 && runNum < 4500000) {
-    for (int j = 0; j < 32; j++){
-      if (fabs(PanelInfo(runNum,j,"qdcMean") - LEDQDCTotal[j]/simpleLEDCount) > 3.0*PanelInfo(runNum,j,"qdcSigma")){
-        ErrorCount[29]++;
-        Error[29] = true;
-      }
-    }
-  }
   // Error 30: non-LED Panel Hit Rate deviates from expected value by > 3 sigma
-  // Implemented for DS3 and onward.
-  if (unixDuration > 300 && runNum > 16797 && runNum < 4500000) {
-    for (int j = 0; j< 32; j++) {
-      if (fabs(PanelInfo(runNum,j,"hitRateMean") - nonLEDHitCount[j]/unixDuration) > 3.0*PanelInfo(runNum,j,"hitRateSigma")){
-        ErrorCount[30]++;
-        Error[30] = true;
-      }
-    }
+  // Implemented for DS3 and onward (PanelReference).
+  panels.SetDuration(unixDuration);
+  if (panels.GetNOutOfRange() > 0)
+    cout << "Warning: " << panels.GetNOutOfRange() << " entries have scaler times past the end of the run (not in the panel rate bins).\n";
+  vector<int> badQDC = panels.FlagLEDQDC(3.0), badRate = panels.FlagRate(3.0);
+  for (size_t j = 0; j < badQDC.size(); j++) {
+    ErrorCount[29]++;
+    errLog.Add(-1,29);
+    Error[29] = true;
+  }
+  for (size_t j = 0; j < badRate.size(); j++) {
+    ErrorCount[30]++;
+    errLog.Add(-1,30);
+    Error[30] = true;
+  }
+  if (!badQDC.empty() || !badRate.empty()) {
+    cout << "Panels off by > 3 sigma (Run " << runNum << ") -- LED QDC:";
+    for (auto j : badQDC) cout << " " << j;
+    cout << "  Hit rate:";
+    for (auto j : badRate) cout << " " << j;
+    cout << "  (see panelTree)\n";
   }
 
   // ========================================================================
-  // ================ 2nd loop over entries - Error checks ==================
-  // We don't skip any events, and we count the number of each type of error.
+  // ===================== Error summary (from loop 1) =====================
+  // The serious errors in each entry are in errorTree.  List them with ./veto-errors.
 
-  reader.SetTree(vetoChain); // reset the reader
-  std::fill(Error.begin(), Error.end(), 0); // reset error bools
-  while(reader.Next())
-  {
-    long i = reader.GetCurrentEntry();
-    veto.Clear();
-    veto.SetSWThresh(swThresh);
-    veto.WriteEvent(i,&*vRun,&*vEvt,*vBits,runNum,true);
-    CheckErrors(veto,prev,Error);
-    for (int j=0; j<nErrs; j++) if (Error[j]==1) ErrorCount[j]++;
-
-    // Print errors to screen
-    bool PrintError = false;
-    for (auto i : SeriousErrors){
-      if (Error[i]) {
-        PrintError = true;
-        break;
-      }
-    }
-    if (PrintError)
-    {
-      if (Error[1] && Error[25])  cout << i << ":[1] Missing Packet & [25] Buffer Flush.";
-      if (Error[1] && !Error[25]) cout << i << ":[1] Missing Packet.";
-      if (!Error[1] && Error[25]) cout << i << ":[25] Buffer Flush.";
-      if (Error[1] || Error[25])
-        printf("  Index %li  Scaler %-5.2f  d(sca) %-5.3f  d(sbc) %-5.3f\n", veto.GetScalerIndex(),veto.GetTimeSec(),veto.GetTimeSec()-prev.GetTimeSec(),veto.GetTimeSBC()-prev.GetTimeSBC());
-
-      if (Error[13])
-        cout << i << ":[13] Indexes of QDC1 and Scaler differ by more than 2."
-           << "\n    Scaler Index " << veto.GetScalerIndex()
-           << "  QDC1 Index " << veto.GetQDC1Index()
-           << "\n    Previous scaler Index " << prev.GetScalerIndex()
-           << "  Previous QDC1 Index " << prev.GetQDC1Index() << endl;
-
-      if (Error[14])
-        cout << i << ":[14] Indexes of QDC2 and Scaler differ by more than 2."
-           << "\n    Scaler Index " << veto.GetScalerIndex()
-           << "  QDC2 Index " << veto.GetQDC2Index()
-           << "\n    Previous scaler Index " << prev.GetScalerIndex()
-           << "  Previous QDC2 Index " << prev.GetQDC2Index() << endl;
-
-      if (Error[18])
-        cout << i << ":[18] Scaler/SBC Desynch."
-            << "\n    Scaler " << veto.GetTimeSec() << "  SBC " << (long)veto.GetTimeSBC()
-            << "\n    Delta(scaler) " << veto.GetTimeSec() - prev.GetTimeSec()
-            << "\n    Delta(sbc) " << veto.GetTimeSBC() - prev.GetTimeSBC()
-            << "\n    Scaler jump correction: " << (veto.GetTimeSBC()-prev.GetTimeSBC()) - (veto.GetTimeSec()-prev.GetTimeSec())
-            << "\n    Adjusted time: "
-            << veto.GetTimeSec() + (veto.GetTimeSBC()-prev.GetTimeSBC()) - (veto.GetTimeSec()-prev.GetTimeSec()) << endl;
-
-      if (Error[19])
-        cout << i << ":[19] Scaler Event Count Reset. "
-           << "\n    Scaler Index " << veto.GetScalerIndex()
-           << "  SEC " << veto.GetSEC()
-           << "  Previous SEC " << prev.GetSEC() << "\n";
-
-      if (Error[20])
-        cout << i << ":[20] Scaler Event Count Jump."
-           << "\n    Scaler Time " << veto.GetTimeSec()
-           << "  Scaler Index " << veto.GetScalerIndex()
-           << "  Prev scaler time " << prev.GetTimeSec()
-           << "\n    SEC " << veto.GetSEC()
-           << "  Previous SEC " << prev.GetSEC() << "\n";
-
-      if (Error[21])
-        cout << i << ":[21] QDC1 Event Count Reset."
-           << "\n    Scaler Index " << veto.GetScalerIndex()
-           << "  QEC1 " << veto.GetQEC()
-           << "  Previous QEC1 " << prev.GetQEC() << "\n";
-      if(Error[22])
-        cout << i << ":[22] QDC 1 Event Count Jump."
-           << "\n    Scaler time " << veto.GetTimeSec()
-           << "  QDC 1 Index " << veto.GetQDC1Index()
-           << "  QEC 1 " << veto.GetQEC()
-           << "  Previous QEC 1 " << prev.GetQEC() << "\n";
-
-      if (Error[23])
-        cout << i << ":[23] QDC2 Event Count Reset."
-           << "\n    Scaler Index " << veto.GetScalerIndex()
-           << "  QEC2 " << veto.GetQEC2()
-           << "  Previous QEC2 " << prev.GetQEC2() << "\n";
-
-      if(Error[24])
-        cout << i << ":[24] QDC 2 Event Count Jump."
-           << "\n    Scaler time " << veto.GetTimeSec()
-           << "  QDC 2 Index " << veto.GetQDC2Index()
-           << "  QEC 2 " << veto.GetQEC2()
-           << "  Previous QEC 2 " << prev.GetQEC2() << "\n";
-    }
-    // end of event resets
-    prev = veto;
-    std::fill(Error.begin(), Error.end(), 0);
-  }
   // Calculate total errors and total serious errors
   // Ignore Error 10 & 11 - the veto counters are not reset at the beginning of runs.
   for (int i = 1; i < nErrs; i++) {
@@ -711,10 +731,20 @@ void ProcessVetoData(TChain *vetoChain, vector<int> thresholds, string outputDir
     // cout << "For reference, \"serious\" error types are: ";
     // for (auto i : SeriousErrors) cout << i << " ";
     // cout << "\nPlease report these to the veto group.\n";
+    printf("  %zu error records in errorTree%s.  List them with: ./veto-errors %s -s\n",
+      errLog.GetNRecords(), errLog.GetNDropped() > 0 ? " (oldest dropped)" : "", outputFile);
+  }
+  RootFile->cd();
+  errLog.Write(runNum);
+  panels.Write(3.0);
+  spectra.Write();
+  if (makePlots) plots.Write();
+  if (errorCheckOnly) {
+    RootFile->Close();
+    return true;
   }
-  if (errorCheckOnly) return;
 
-  // ================ 3nd loop over entries - Find muons! =================
+  // ================ 2nd loop over entries - Find muons! =================
   // Determine event time, skip bad entries, and apply all cuts for muon ID.
 
   cout << "=================== Scanning for muons ... ==================\n";
@@ -735,37 +765,13 @@ void ProcessVetoData(TChain *vetoChain, vector<int> thresholds, string outputDir
     deltaScaler = veto.GetTimeSec()-prev.GetTimeSec();
     deltaSBC = veto.GetTimeSBC()-prev.GetTimeSBC();
 
-    // Apply the results from the veto-ge sync to xTime
-    timeUncert = syncUncert;
-    if (!veto.GetBadScaler()) {
-      xTime = veto.GetTimeSec();
-      if (applyOffset) xTime += scalerOffset;
-    }
-    else if (veto.GetBadScaler() && runNum > 8557){
-      xTime = veto.GetTimeSBC();
-      if (applyOffset) xTime += sbcOffset;
-    }
-    else if (veto.GetBadScaler() && (runNum <= 8557 || runNum > 45000000))
-    {
-      auto it = find(badEntries.begin(), badEntries.end(), i);
-      if (it != badEntries.end()) {
-        auto idx = distance(badEntries.begin(), it);
-        xTime = interpTimes[idx];
-        timeUncert = interpUnc[idx];
-      }
-      else {
-        xTime=-1;
-        timeUncert=-1;
-      }
-    }
-
-    // Scaler jump handling: Calculate the jumpCorrection and save it to the ROOT output.
-    // Ignore any scaler jumps that happen during a buffer flush, because deltaSBC is not trustworthy.
-    if (i > entryAfterFlush && Error[18]) {
-      jumpCorrection += deltaSBC - deltaScaler;
-      printf("Scaler jump found.  Applying jump correction: %.2f  Before %.2f  After %.2f\n", jumpCorrection,xTime,xTime+jumpCorrection);
-    }
-    xTime += jumpCorrection;
+    // Event time from the clock model (veto-ge sync, SBC / Ge interpolation for bad scalers,
+    // and the running scaler jump correction, which ignores jumps during a buffer flush.)
+    xTime = clock.GetTime(i);
+    timeUncert = clock.GetUncertainty(i);
+    jumpCorrection = clock.GetJumpCorrection(i);
+    if (clock.IsJump(i))
+      printf("Scaler jump found.  Applying jump correction: %.2f  Before %.2f  After %.2f\n", jumpCorrection,xTime-jumpCorrection,xTime);
     // if (i > 715 && i < 720)  // debug block (don't delete!)
     // printf("%li  ind %li  e1 %i  e18 %i  e19 %i  scaler %-5.2f  dScaler %-5.2f  dSBC %-5.2f  jumpCor %-5.2f\n" ,i,veto.GetScalerIndex(),Error[1],Error[18],Error[19],veto.GetTimeSec(),deltaScaler,deltaSBC,jumpCorrection);
 
@@ -786,108 +792,11 @@ void ProcessVetoData(TChain *vetoChain, vector<int> thresholds, string outputDir
     if (veto.GetMultip() < multipThreshold && !LEDTurnedOff) LEDCut = true;
     else if (LEDTurnedOff) LEDCut = true;
 
-    // Energy (Gamma) Cut
-    // The measured muon energy threshold is QDC = 500.
-    // Set TRUE if at least TWO panels are over 500.
-    EnergyCut = false;
+    // Energy cut, hit pattern, and muon type
     int over500Count = 0;
-    for (int q = 0; q < 32; q++) {
-      if (veto.GetQDC(q) > 500)
-        over500Count++;
-    }
-    if (over500Count >= 2) EnergyCut = true;
-
-    // debug block (don't delete!)
-    // if (veto.GetMultip() < 27 && veto.GetMultip() > 1)
-    // printf("Entry %li  Time %-6.2f  QDC %-5i  Mult %i  Ov500 %i  Loff? %i  LEDCut %i  ECut %i  \n",i,veto.GetTimeSec(),veto.GetTotE(),veto.GetMultip(),over500Count,LEDTurnedOff,LEDCut,EnergyCut);
-
-    // Muon Identification:
-    // Use EnergyCut, LEDCut, and the Hit Pattern to identify them sumbitches.
-    for (int k = 0; k < 12; k++) Plane[k] = 0;
-    for (int k = 0; k < 32; k++) {
-      if (veto.GetQDC(k) > veto.GetSWThresh(k)) {
-        if (PlaneMap(k,runNum)==0)       Plane[0]=1;  // 0: Lower Bottom
-        else if (PlaneMap(k,runNum)==1)  Plane[1]=1;  // 1: Upper Bottom
-        else if (PlaneMap(k,runNum)==2)  Plane[2]=1;  // 3: Top Inner
-        else if (PlaneMap(k,runNum)==3)  Plane[3]=1;  // 4: Top Outer
-        else if (PlaneMap(k,runNum)==4)  Plane[4]=1;  // 5: North Inner
-        else if (PlaneMap(k,runNum)==5)  Plane[5]=1;  // 6: North Outer
-        else if (PlaneMap(k,runNum)==6)  Plane[6]=1;  // 7: South Inner
-        else if (PlaneMap(k,runNum)==7)  Plane[7]=1;  // 8: South Outer
-        else if (PlaneMap(k,runNum)==8)  Plane[8]=1;  // 9: West Inner
-        else if (PlaneMap(k,runNum)==9)  Plane[9]=1;  // 10: West Outer
-        else if (PlaneMap(k,runNum)==10) Plane[10]=1; // 11: East Inner
-        else if (PlaneMap(k,runNum)==11) Plane[11]=1; // 12: East Outer
-        else if (PlaneMap(k,runNum)==-1)
-          cout << "Error: Panel " << k << " was not installed for this run and should not be giving counts above threshold.\n";
-      }
-    }
-    std::fill(CoinType.begin(), CoinType.end(), 0);  // reset
-    if (LEDCut && EnergyCut)
-    {
-      CoinType[0] = true;
-      int type = 0;
-      bool a=0,b=0,c=0;
-
-      // debug block (don't delete!)
-      // cout << "\nQDC-panel-plane: ";
-      // for (int i=0; i<32; i++) {
-      // 	int qdc=0;
-      // 	if (veto.GetQDC(i) > veto.GetSWThresh(i)) {
-      // 		qdc = veto.GetQDC(i);
-      // 		cout << i << "-" << i+1 << "-p" << PlaneMap(i,run) << ":" << qdc << "  ";}
-      // }
-      // cout << endl;
-      // cout << "Planes:\n";
-      // cout << "0: Lower Bottom  1: Upper Bottom\n"
-      // 	  << "2: Top Inner     3: Top Outer\n"
-      // 	  << "4: North Inner   5: North Outer\n"
-      // 	  << "6: South Inner   7: South Outer\n"
-      // 	  << "8: West Inner    9: West Outer\n"
-      // 	  << "10: East Inner   11: East Outer\n";
-      // for (int i=0; i<12; i++) cout << "p" << i << ":" << Plane[i] << "  ";
-      // cout << endl;
-
-      // Type 1: vertical muons
-      if (Plane[0] && Plane[1] && Plane[2] && Plane[3]) {
-        CoinType[1]=true;
-        a=true;
-        type=1;
-      }
-      // Type 2: (both planes of a side) + both bottom planes
-      if ((Plane[0] && Plane[1]) &&
-          ((Plane[4] && Plane[5])
-          || (Plane[6] && Plane[7])
-          || (Plane[8] && Plane[9])
-          || (Plane[10] && Plane[11])))
-      {
-        CoinType[2] = true;
-        b=true;
-        type = 2;
-      }
-      // Type 3: (both top planes) + (both planes of a side)
-      if ((Plane[2] && Plane[3]) &&
-          ((Plane[4] && Plane[5])
-          || (Plane[6] && Plane[7])
-          || (Plane[8] && Plane[9])
-          || (Plane[10] && Plane[11]))) {
-        CoinType[3] = true;
-        c=true;
-        type = 3;
-      }
-      // Type 4: compound hit (combination of types 1-3)
-      if ((a && b)||(a && c)||(b && c)) type = 4;
-
-      char hitType[200];
-      if (type==0) sprintf(hitType,"2+ panels");
-      if (type==1) sprintf(hitType,"vertical");
-      if (type==2) sprintf(hitType,"side+bottom");
-      if (type==3) sprintf(hitType,"top+sides");
-      if (type==4) sprintf(hitType,"compound");
-
-      // print the details of the hit
-      printf("Hit: %-12s Entry %-4li Time %-6.2f  QDC %-5i  Mult %i  Ov500 %i  LEDoff %i\n", hitType,i,xTime,veto.GetTotE(),veto.GetMultip(),over500Count,LEDTurnedOff);
-    }
+    int type = TagMuon(veto, runNum, cuts, LEDCut, CoinType, Plane, over500Count);
+    if (type >= 0)
+      printf("Hit: %-12s Entry %-4li Time %-6.2f  QDC %-5i  Mult %i  Ov500 %i  LEDoff %i\n", HitTypeName(type),i,xTime,veto.GetTotE(),veto.GetMultip(),over500Count,LEDTurnedOff);
 
     out = veto;
     vetoTree->Fill();
@@ -905,6 +814,258 @@ void ProcessVetoData(TChain *vetoChain, vector<int> thresholds, string outputDir
   cout << "Wrote ROOT file: " << outputFile << endl;
 
   RootFile->Close();
+  return true;
+}
+
+bool StreamVetoData(int run, string runPath, string outputDir, const VetoCuts &cuts, double pollSec, double idleSec)
+{
+  // Follows a built file that's still being written (or a local copy that's being appended to).
+  // Each poll re-reads the VetoTree header and checks only the new entries, printing
+  // serious errors, LED dropouts, and muon candidates as they come in.
+  // There isn't enough data early in a run to measure the QDC thresholds or LED rate,
+  // so those are seeded from the last run auto-veto processed.
+  // Returns true when the run has ended: the stop packet is in, or no new entries for idleSec.
+  // Each alert is one line.  Once each of its error codes has been printed a few times, an alert is
+  // just counted, and summarized with the status lines (error 25 can come in floods).
+  // (Event times here are raw scaler times.  The clock model is only built in ProcessVetoData.)
+
+  typedef std::chrono::steady_clock Clock;
+  auto Elapsed = [](Clock::time_point t0) {
+    return std::chrono::duration<double>(Clock::now() - t0).count();
+  };
+
+  VetoSeed seed;
+  bool seeded = seed.LoadPrevious(outputDir, run);
+  if (seeded)
+    printf("Streaming run %i.  Seeded from run %i: LED period %.2f sec, LED multiplicity threshold %i\n",
+      run,seed.run,seed.LEDperiod,seed.multipThreshold);
+  else
+    printf("Streaming run %i.  No previous run in %s to seed from: only checking errors.\n",run,outputDir.c_str());
+  bool checkLED = (seeded && !seed.badLED);
+
+  // Wait for the file to show up.
+  Clock::time_point lastNew = Clock::now();
+  TFile *f = NULL;
+  TTree *vetoTree = NULL;
+  while (true)
+  {
+    if (runPath != "") f = TFile::Open(runPath.c_str());
+    if (f != NULL && !f->IsZombie()) vetoTree = (TTree*)f->Get("VetoTree");
+    if (vetoTree != NULL) break;
+    if (f != NULL) { delete f; f = NULL; }
+    if (Elapsed(lastNew) > idleSec) {
+      cout << "No VetoTree in " << runPath << " after " << idleSec << " sec.  Exiting ...\n";
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::duration<double>(pollSec));
+  }
+  cout << "Path: " << runPath << endl;
+
+  MJTRun *vRun = new MJTRun();
+  MGTBasicEvent *vEvt = new MGTBasicEvent();
+  uint32_t vBits = 0;
+  vetoTree->SetBranchAddress("run",&vRun);
+  vetoTree->SetBranchAddress("vetoEvent",&vEvt);
+  vetoTree->SetBranchAddress("vetoBits",&vBits);
+
+  int card1=0, card2=0;
+  SetCardNumbers(run,card1,card2);
+  MJVetoEvent veto(card1,card2);
+  MJVetoEvent prev;
+  vector<int> Error(nErrs), CoinType(32), Plane(32);
+
+  long nDone = 0, nMuons = 0, nAlerts = 0;
+  const long maxAlertLines = 10;   // per error code
+  map<int,long> alertCount, alertsHidden;
+  auto PrintHiddenAlerts = [&]() {
+    if (alertsHidden.empty()) return;
+    printf("Run %i: alerts not printed since the last status:",run);
+    for (auto &a : alertsHidden) printf("  [%i] %s x%li",a.first,VetoErrorLog::CodeName(a.first),a.second);
+    printf("\n");
+    alertsHidden.clear();
+  };
+  double timePrevLED = -1;
+  bool LEDTurnedOff = false, stopPacket = false;
+  Clock::time_point lastStatus = Clock::now();
+  while (true)
+  {
+    vetoTree->Refresh();
+    long nEntries = vetoTree->GetEntries();
+    for (long i = nDone; i < nEntries; i++)
+    {
+      vetoTree->GetEntry(i);
+      veto.Clear();
+      veto.SetSWThresh(seed.thresh);
+      veto.WriteEvent(i,vRun,vEvt,vBits,run,true);
+      bool skip = CheckErrors(veto,prev,Error);
+      if (IsSeriousError(Error)) {
+        string codes = "";
+        bool show = false;
+        for (auto e : SeriousErrors) {
+          if (!Error[e]) continue;
+          codes += " [" + to_string(e) + "] " + VetoErrorLog::CodeName(e);
+          if (++alertCount[e] <= maxAlertLines) show = true;
+        }
+        if (show)
+          printf("ALERT run %i entry %li:%s.  Index %li  Scaler %.2f  d(sca) %.3f  d(sbc) %.3f\n",run,i,codes.c_str(),
+            veto.GetScalerIndex(),veto.GetTimeSec(),veto.GetTimeSec()-prev.GetTimeSec(),veto.GetTimeSBC()-prev.GetTimeSBC());
+        else
+          for (auto e : SeriousErrors) if (Error[e]) alertsHidden[e]++;
+        nAlerts++;
+      }
+      if (vRun->GetStopTime() > 0) stopPacket = true;
+      if (skip) {
+        prev = veto;
+        continue;
+      }
+
+      // LED status: the LED should fire every LEDperiod seconds.
+      if (checkLED && !veto.GetBadScaler())
+      {
+        if (veto.GetMultip() > seed.multipThreshold) {
+          if (LEDTurnedOff)
+            printf("Run %i: LED is back on.  Entry %li  Scaler %.2f\n",run,i,veto.GetTimeSec());
+          LEDTurnedOff = false;
+          timePrevLED = veto.GetTimeSec();
+        }
+        else if (!LEDTurnedOff && timePrevLED > 0 && veto.GetTimeSec() - timePrevLED > 3*seed.LEDperiod) {
+          printf("ALERT run %i: no LED events for %.1f sec (period %.2f).  LED may be off.  Entry %li\n",
+            run,veto.GetTimeSec()-timePrevLED,seed.LEDperiod,i);
+          LEDTurnedOff = true;
+          nAlerts++;
+        }
+      }
+
+      // same cuts as ProcessVetoData
+      bool LEDCut = (veto.GetMultip() < seed.multipThreshold) || LEDTurnedOff || !checkLED;
+      int over500Count = 0;
+      int type = TagMuon(veto, run, cuts, LEDCut, CoinType, Plane, over500Count);
+      if (seeded && type >= 0) {
+        printf("Hit: %-12s Entry %-4li Scaler %-6.2f  SBC %li  QDC %-5i  Mult %i  Ov500 %i  LEDoff %i\n",
+          HitTypeName(type),i,veto.GetTimeSec(),(long)veto.GetTimeSBC(),veto.GetTotE(),veto.GetMultip(),over500Count,LEDTurnedOff);
+        nMuons++;
+      }
+      prev = veto;
+    }
+    bool foundNew = (nEntries > nDone);
+    nDone = nEntries;
+    if (foundNew) lastNew = Clock::now();
+
+    if (Elapsed(lastStatus) > 60) {
+      printf("Run %i: %li entries, %li muon candidates, %li alerts.\n",run,nDone,nMuons,nAlerts);
+      PrintHiddenAlerts();
+      lastStatus = Clock::now();
+    }
+    if (stopPacket && !foundNew) {
+      cout << "Found stop packet.  Run " << run << " is done.\n";
+      break;
+    }
+    if (Elapsed(lastNew) > idleSec) {
+      printf("No new entries for %.0f sec.  Assuming run %i is done.\n",idleSec,run);
+      break;
+    }
+    std::this_thread::sleep_for(std::chrono::duration<double>(pollSec));
+  }
+  PrintHiddenAlerts();
+  printf("Streamed run %i: %li entries, %li muon candidates, %li alerts.\n",run,nDone,nMuons,nAlerts);
+  f->Close();
+  delete f;
+  return (nDone > 0);
+}
+
+bool RetagVetoData(int run, string outputDir, const VetoCuts &cuts)
+{
+  // Re-does the LED & muon tagging on the events in an existing veto_run file,
+  // so the cuts can be tuned without decoding and syncing the built data again.
+  // Writes a friend tree (vetoTag_run[run].root) with the new tags, entry-for-entry with vetoTree:
+  //   vetoTree->AddFriend("vetoTag","vetoTag_run[run].root");
+  // The skipped (bad) events aren't in vetoTree and aren't re-tagged.
+  // The LED period measurement depends on LEDSimpleThreshold and isn't redone,
+  // so changing that cut still needs a full auto-veto pass.
+
+  char inputFile[200], tagFile[200];
+  sprintf(inputFile,"%s/veto_run%i.root",outputDir.c_str(),run);
+  sprintf(tagFile,"%s/vetoTag_run%i.root",outputDir.c_str(),run);
+  TFile *inFile = TFile::Open(inputFile);
+  if (inFile == NULL || inFile->IsZombie()) {
+    cout << "Couldn't open " << inputFile << ".  Run auto-veto on it first.  Exiting ...\n";
+    return false;
+  }
+  TTree *vetoTree = (TTree*)inFile->Get("vetoTree");
+  if (vetoTree == NULL || vetoTree->GetEntries() < 1) {
+    cout << "No vetoTree entries in " << inputFile << ".  Exiting ...\n";
+    return false;
+  }
+  long vEntries = vetoTree->GetEntries();
+  printf("\n========= Re-tagging run %i ... %li entries. =========\n",run,vEntries);
+  cuts.Print();
+
+  TTreeReader reader(vetoTree);
+  TTreeReaderValue<MJVetoEvent> vEvent(reader,"vetoEvent");
+  TTreeReaderValue<double> vTime(reader,"xTime");
+  TTreeReaderValue<int> vHighestMultip(reader,"highestMultip");
+  TTreeReaderValue<double> vLEDfreq(reader,"LEDfreq");
+  reader.SetEntry(0);
+  int highestMultip = *vHighestMultip;
+  double LEDfreq = *vLEDfreq;
+  reader.SetTree(vetoTree);
+
+  // Error 26 (LED off or bad frequency) is a run-level decision from ProcessVetoData.
+  bool fromSeed = false;
+  bool LEDTurnedOff = IsLEDOff(outputDir, run, LEDfreq, fromSeed);
+  if (!fromSeed)
+    cout << "Warning: no " << VetoSeed::FileName(outputDir,run) << ".  LED status taken from LEDfreq: "
+         << (LEDTurnedOff ? "off" : "on") << endl;
+  int multipThreshold = highestMultip - cuts.LEDMultipThreshold;
+  if (multipThreshold < 0) multipThreshold = 0;
+  printf("Highest mult. %i  LED threshold %i  LEDoff %i\n", highestMultip,multipThreshold,LEDTurnedOff);
+
+  // friend tree
+  int runNum = run, muonType = -1, over500Count = 0;
+  int LEDMultipThreshold = cuts.LEDMultipThreshold, muonQDC = cuts.muonQDC, muonPanels = cuts.muonPanels;
+  bool LEDCut = false, bothPlanes = cuts.bothPlanes;
+  vector<int> CoinType(32), Plane(32);
+  TFile *outFile = new TFile(tagFile, "RECREATE");
+  TTree *tagTree = new TTree("vetoTag","MJD Veto re-tagged events");
+  tagTree->Branch("run",&runNum);
+  tagTree->Branch("LEDCut",&LEDCut);
+  tagTree->Branch("muonType",&muonType);
+  tagTree->Branch("over500Count",&over500Count);
+  tagTree->Branch("CoinType",&CoinType);
+  tagTree->Branch("Plane",&Plane);
+  tagTree->Branch("multipThreshold",&multipThreshold);
+  tagTree->Branch("LEDMultipThreshold",&LEDMultipThreshold);
+  tagTree->Branch("muonQDC",&muonQDC);
+  tagTree->Branch("muonPanels",&muonPanels);
+  tagTree->Branch("bothPlanes",&bothPlanes);
+
+  // same cuts as the 2nd loop of ProcessVetoData
+  long nMuons = 0;
+  while(reader.Next())
+  {
+    long i = reader.GetCurrentEntry();
+    MJVetoEvent veto = *vEvent;
+    LEDCut = (veto.GetMultip() < multipThreshold) || LEDTurnedOff;
+    muonType = TagMuon(veto, run, cuts, LEDCut, CoinType, Plane, over500Count);
+    if (muonType >= 0) {
+      printf("Hit: %-12s Entry %-4li Time %-6.2f  QDC %-5i  Mult %i  Ov500 %i  LEDoff %i\n", HitTypeName(muonType),i,*vTime,veto.GetTotE(),veto.GetMultip(),over500Count,LEDTurnedOff);
+      nMuons++;
+    }
+    tagTree->Fill();
+  }
+  outFile->cd();
+  tagTree->Write("",TObject::kOverwrite);
+  outFile->Close();
+  inFile->Close();
+  printf("Re-tagged run %i: %li muon candidates.  Wrote friend tree: %s\n",run,nMuons,tagFile);
+
+  // Provenance for the tag file: the veto_run file it came from, and the cuts.
+  Manifest manifest("auto-veto-retag"), prevManifest;
+  manifest.AddInput(inputFile);
+  cuts.AddParams(manifest);
+  bool havePrev = prevManifest.Load(Manifest::FileName(tagFile));
+  manifest.Save(Manifest::FileName(tagFile), havePrev ? &prevManifest : NULL);
+  return true;
 }
 
 // ====================================================================================
@@ -925,88 +1086,124 @@ int FindThreshold(TH1D *qdcHist, int threshVal, int panel, int runNum)
   // This (intentionally) causes that panel to not contribute to multiplicity or total QDC.
   // This is the run-level error 27/28, and is checked between loop 1 and loop 2.
 
-  if (runNum > 45000000 && panel > 23)
-    return 9999;
+  // The rule itself is QDCSpectra::PedestalRule, which veto-rethresh also uses.
+  QDCSpectra spec(runNum);
+  spec.Fill(panel, qdcHist);
+  return QDCSpectra::PedestalRule(spec.Counts(panel), panel, runNum, threshVal);
+}
 
-  int firstNonzeroBin = qdcHist->FindFirstBinAbove(1,1);
-  qdcHist->GetXaxis()->SetRange(firstNonzeroBin-10,firstNonzeroBin+50);
-  //qdcHist->GetXaxis()->SetRangeUser(0,500); //alternate method of finding pedestal
-  int bin = qdcHist->GetMaximumBin();
-  if (firstNonzeroBin == -1) return 9999;
-  double xval = qdcHist->GetXaxis()->GetBinCenter(bin);
-  return xval+threshVal;
+bool IsSeriousError(const vector<int> &ErrorVec)
+{
+  for (auto i : SeriousErrors) if (ErrorVec[i]) return true;
+  return false;
 }
 
-int PlaneMap(int qdcChan, int runNum)
+// Fills Plane (hit planes) and CoinType (muon coincidence types).
+// Returns the muon type (0: 2+ panels, 1: vertical, 2: side+bottom, 3: top+sides, 4: compound),
+// or -1 if the event fails the LED or energy cut.
+int TagMuon(MJVetoEvent &veto, int runNum, const VetoCuts &cuts, bool LEDCut, vector<int> &CoinType, vector<int> &Plane, int &over500Count)
 {
-  // For tagging plane-based coincidences.
-  // This uses a zero-indexed map: {panel number, plane number}
-  map<int,int> planes;
-
-  // Geometric planes:
-  // 0: Lower Bottom 	1: Upper Bottom
-  // 2: Top Inner		3: Top Outer
-  // 4: North Inner		5: North Outer
-  // 6: South Inner 	7: South Outer
-  // 8: West Inner		9: West Outer
-  // 10: East Inner 	11: East Outer
-
-  // 32-panel config (default) - began 7/10/15
-  if (runNum < 45000000 && runNum >= 3057) {
-    map<int,int> tempMap =
-    {{0,0},  {1,0},  {2,0},  {3,0}, {4,0}, {5,0},
-     {6,1},  {7,1},  {8,1},  {9,1}, {10,1}, {11,1},
-     {12,8}, {13,8}, {14,9}, {15,5},
-     {16,5}, {17,3}, {18,3}, {19,4},
-     {20,2}, {21,2}, {22,9}, {23,4},
-     {24,6}, {25,7}, {26,6}, {27,7},
-     {28,10},{29,11},{30,10},{31,11}};
-    planes = tempMap;
-  }
-  // 1st prototype config (24 panels)
-   else if (runNum >= 45000509 && runNum <= 45004116) {
-    map<int,int> tempMap =
-    {{0,0},  {1,0},  {2,0},  {3,0}, {4,0}, {5,0},
-     {6,1},  {7,1},  {8,1},  {9,1}, {10,1}, {11,1},
-     {12,2}, {13,2}, {14,9}, {15,5},
-     {16,5}, {17,3}, {18,3}, {19,4},
-     {20,8}, {21,8}, {22,9}, {23,4},
-     {24,-1},{25,-1},{26,-1},{27,-1},
-     {28,-1},{29,-1},{30,-1},{31,-1}};
-    planes = tempMap;
+  // Energy (Gamma) Cut
+  // The measured muon energy threshold is QDC = 500 (cuts.muonQDC).
+  // Set TRUE if at least TWO panels (cuts.muonPanels) are over 500.
+  bool EnergyCut = false;
+  over500Count = 0;
+  for (int q = 0; q < 32; q++) {
+    if (veto.GetQDC(q) > cuts.muonQDC)
+      over500Count++;
   }
-  // 2nd prototype config (24 panels)
-   else if (runNum >= 45004117 && runNum <= 45008659) {
-    map<int,int> tempMap =
-    {{0,0},  {1,0},  {2,0},  {3,0}, {4,0}, {5,0},
-     {6,1},  {7,1},  {8,1},  {9,1}, {10,1}, {11,1},
-     {12,8}, {13,8}, {14,9}, {15,5},
-     {16,5}, {17,3}, {18,3}, {19,4},
-     {20,2}, {21,2}, {22,9}, {23,4},
-     {24,-1},{25,-1},{26,-1},{27,-1},
-     {28,-1},{29,-1},{30,-1},{31,-1}};
-    planes = tempMap;
+  if (over500Count >= cuts.muonPanels) EnergyCut = true;
+
+  // debug block (don't delete!)
+  // if (veto.GetMultip() < 27 && veto.GetMultip() > 1)
+  // printf("Entry %li  Time %-6.2f  QDC %-5i  Mult %i  Ov500 %i  Loff? %i  LEDCut %i  ECut %i  \n",i,veto.GetTimeSec(),veto.GetTotE(),veto.GetMultip(),over500Count,LEDTurnedOff,LEDCut,EnergyCut);
+
+  // Muon Identification:
+  // Use EnergyCut, LEDCut, and the Hit Pattern to identify them sumbitches.
+  for (int k = 0; k < 12; k++) Plane[k] = 0;
+  for (int k = 0; k < 32; k++) {
+    if (veto.GetQDC(k) > veto.GetSWThresh(k)) {
+      if (PlaneMap(k,runNum)==0)       Plane[0]=1;  // 0: Lower Bottom
+      else if (PlaneMap(k,runNum)==1)  Plane[1]=1;  // 1: Upper Bottom
+      else if (PlaneMap(k,runNum)==2)  Plane[2]=1;  // 3: Top Inner
+      else if (PlaneMap(k,runNum)==3)  Plane[3]=1;  // 4: Top Outer
+      else if (PlaneMap(k,runNum)==4)  Plane[4]=1;  // 5: North Inner
+      else if (PlaneMap(k,runNum)==5)  Plane[5]=1;  // 6: North Outer
+      else if (PlaneMap(k,runNum)==6)  Plane[6]=1;  // 7: South Inner
+      else if (PlaneMap(k,runNum)==7)  Plane[7]=1;  // 8: South Outer
+      else if (PlaneMap(k,runNum)==8)  Plane[8]=1;  // 9: West Inner
+      else if (PlaneMap(k,runNum)==9)  Plane[9]=1;  // 10: West Outer
+      else if (PlaneMap(k,runNum)==10) Plane[10]=1; // 11: East Inner
+      else if (PlaneMap(k,runNum)==11) Plane[11]=1; // 12: East Outer
+      else if (PlaneMap(k,runNum)==-1)
+        cout << "Error: Panel " << k << " was not installed for this run and should not be giving counts above threshold.\n";
+    }
   }
-  // 1st module 1 (P3JDY) config, 6/24/15 - 7/7/15
-  else if (runNum > 0 && runNum <=3056){
-    map<int,int> tempMap =
-    {{0,0},  {1,0},  {2,0},  {3,0}, {4,0}, {5,0},
-     {6,1},  {7,1},  {8,1},  {9,1}, {10,1}, {11,1},
-     {12,8}, {13,8}, {14,9}, {15,5},
-     {16,5}, {17,3}, {18,3}, {19,4},
-     {20,2}, {21,2}, {22,9}, {23,4},
-     {24,-1},{25,-1},{26,-1},{27,-1},
-     {28,-1},{29,-1},{30,-1},{31,-1}};
-    planes = tempMap;
+  std::fill(CoinType.begin(), CoinType.end(), 0);  // reset
+  if (LEDCut && EnergyCut)
+  {
+    CoinType[0] = true;
+    int type = 0;
+    bool a=0,b=0,c=0;
+
+    // A side (or the top, or the bottom) is hit if both its planes are,
+    // or either one with cuts.bothPlanes off.
+    auto Side = [&](int p1, int p2) { return cuts.bothPlanes ? (Plane[p1] && Plane[p2]) : (Plane[p1] || Plane[p2]); };
+    bool anySide = Side(4,5) || Side(6,7) || Side(8,9) || Side(10,11);
+
+    // debug block (don't delete!)
+    // cout << "\nQDC-panel-plane: ";
+    // for (int i=0; i<32; i++) {
+    // 	int qdc=0;
+    // 	if (veto.GetQDC(i) > veto.GetSWThresh(i)) {
+    // 		qdc = veto.GetQDC(i);
+    // 		cout << i << "-" << i+1 << "-p" << PlaneMap(i,run) << ":" << qdc << "  ";}
+    // }
+    // cout << endl;
+    // cout << "Planes:\n";
+    // cout << "0: Lower Bottom  1: Upper Bottom\n"
+    // 	  << "2: Top Inner     3: Top Outer\n"
+    // 	  << "4: North Inner   5: North Outer\n"
+    // 	  << "6: South Inner   7: South Outer\n"
+    // 	  << "8: West Inner    9: West Outer\n"
+    // 	  << "10: East Inner   11: East Outer\n";
+    // for (int i=0; i<12; i++) cout << "p" << i << ":" << Plane[i] << "  ";
+    // cout << endl;
+
+    // Type 1: vertical muons
+    if (Side(0,1) && Side(2,3)) {
+      CoinType[1]=true;
+      a=true;
+      type=1;
+    }
+    // Type 2: (both planes of a side) + both bottom planes
+    if (Side(0,1) && anySide)
+    {
+      CoinType[2] = true;
+      b=true;
+      type = 2;
+    }
+    // Type 3: (both top planes) + (both planes of a side)
+    if (Side(2,3) && anySide) {
+      CoinType[3] = true;
+      c=true;
+      type = 3;
+    }
+    // Type 4: compound hit (combination of types 1-3)
+    if ((a && b)||(a && c)||(b && c)) type = 4;
+
+    return type;
   }
-  // If the panel is not installed for this run, return -1.
-  else return -1;
-
-  // Otherwise, return the plane index for this panel.
-  int plane = -1;
-  auto search = planes.find(qdcChan);
-  if(search != planes.end()) plane=search->second;
-  return plane;
+  return -1;
+}
+
+const char* HitTypeName(int type)
+{
+  if (type==1) return "vertical";
+  if (type==2) return "side+bottom";
+  if (type==3) return "top+sides";
+  if (type==4) return "compound";
+  return "2+ panels";
 }
 
 // This is overloaded so we don't have to use the error vector if we don't need it
@@ -1131,6 +1328,10 @@ void FillInterpTimeVectors(int runNum, vector<int> &badEntries, vector<double> &
   MGTEvent *evt=0;
   MGVDigitizerData *dig=0;
   builtChain->SetBranchAddress("event",&evt);
+  ReaderSetup builtIO(builtChain, "MGTree");
+  builtIO.SetBranches({"event"});
+  builtIO.SetDisableOthers(true);
+  builtIO.Apply();
   double bTimeBefore=0, bTimeAfter=0;
   uint64_t bIndex=0;
   int bItr = 0;
@@ -1161,34 +1362,3 @@ void FillInterpTimeVectors(int runNum, vector<int> &badEntries, vector<double> &
   }
   delete ds;
 }
-
-double PanelInfo(int run, int panel, string option)
-{
-  // Implemented for DS3 and onward.
-
-  // Each panel's mean hit rate:
-
-  vector<double> hitRateMean =  {0.007338, 0.007482, 0.007730, 0.009183, 0.005995, 0.005272, 0.005786, 0.013200, 0.007360, 0.008041, 0.006708, 0.004830, 0.006750, 0.010310, 0.011600, 0.020450, 0.006718, 0.028900, 0.008145, 0.025110, 0.002854, 0.003381, 0.006357, 0.002808, 0.0006327, 0.0010950, 0.0003902, 0.003375, 0.0022120, 0.005735, 0.0007639, 0.005983};
-
-  vector<double> hitRateSig = {0.001709, 0.001793, 0.001888, 0.002020, 0.001848, 0.00145 , 0.001414, 0.002276, 0.001566, 0.001775, 0.001587, 0.001344, 0.001948, 0.001995, 0.002273, 0.002962, 0.001635, 0.003787, 0.002711, 0.003167, 0.001129, 0.001145, 0.001727, 0.001200, 0.0004681, 0.0006459, 0.0003892, 0.001133, 0.0009158, 0.001850, 0.0005355, 0.001726};
-
-  // Each panel's mean qdc value:
-
-  vector<double> qdcMean = {925, 629.8, 1268, 993.4, 2151, 849.8, 720.2, 2997, 1585, 1185, 1495, 1207, 709.9, 1007, 1702, 2592, 643.2, 1040, 1115, 1307, 1917, 2027, 1214, 1069, 3783, 638.7, 1595, 1138, 1079, 1699, 2476, 3843};
-
-  vector<double> qdcSig = {220, 108.9, 175.6, 136.8, 309.9, 131.9, 115.1, 396.4, 228.5, 182.1, 230.5, 170.5, 93.33, 119.2, 207.9, 319.6, 155.6, 142,  217.2, 173.4, 272.5, 264.5, 145,  215.5, 269.2, 164.6, 263.8, 186.3, 204.9, 253.8, 282.3, 209.7};
-
-  // For runs > 19091:
-
-  vector<double> qdcMean2 = {3772, 520.1, 1491, 1110, 2306, 970.3, 2380, 3445, 1676, 1433, 1617, 1292, 857.2, 1124, 2104, 2576, 701.3, 1160, 1312, 1409, 2131, 2279, 1383, 1199, 1048, 743.7, 1688, 1220, 1343, 1760, 2212, 1828};
-
-  vector<double> qdcSig2 =  {297, 92.38, 199.9, 150.1, 321.5, 149.5, 299.3, 387.1, 239.2, 212.6, 244.3, 178.9, 113,  129.6, 245.3, 312.3, 162.3, 154.5, 255.4, 184.5, 292.5, 288.8, 161, 228.7, 210, 176,  270.8, 194.4, 230.4, 261.8, 316, 230.8};
-
-  if (option=="hitRateMean") return hitRateMean[panel];
-  if (option=="hitRateSig") return hitRateSig[panel];
-  if (option=="qdcMean" && run > 19091 && run < 4500000) return qdcMean2[panel];
-  if (option=="qdcMean" && run < 19091 && run < 4500000) return qdcMean[panel];
-  if (option=="qdcSig" && run > 19091 && run > 16797) return qdcSig2[panel];
-  if (option=="qdcSig" && run > 19091 && run > 16797) return qdcSig[panel];
-  return 0;
-}
\ No newline at end of file
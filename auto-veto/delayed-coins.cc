@@ -0,0 +1,113 @@
+// delayed-coins.cc
+// Searches for delayed Ge signals after muons (neutron capture, activation, ...) over
+// windows up to minutes long, in one time-ordered pass over the veto and Ge data of a
+// list of runs.  See DelayedCoincidence.hh and StreamMerge.hh.
+// C. Wiseman, USC/Majorana
+//
+// Muons come from auto-veto's veto_run files, Ge hits from the gatified data.  Windows can
+// run over into the next run: run clocks are lined up with RunOffsets, from the run metadata
+// cache.  Muons are forgotten at the start of a run that isn't in the cache.  Run gap entries
+// (type 3) aren't muons and are skipped.
+//
+// Usage: ./delayed-coins [run list file] or -r [first] [last]
+//        (-v [veto_run directory]) (-w [window file]) (-e [min keV]) (-n [bins]) (-o [output file])
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include "TFile.h"
+#include "TStopwatch.h"
+#include "GATDataSet.hh"
+#include "StreamMerge.hh"
+#include "DelayedCoincidence.hh"
+
+using namespace std;
+
+enum { kVeto, kGe };
+
+int main(int argc, char** argv)
+{
+  if (argc < 2) {
+    cout << "Usage: ./delayed-coins [run list file]\n"
+         << "                       [-r [first] [last] (instead of a run list)]\n"
+         << "                       [-v [directory] (veto_run files, default ./avout)]\n"
+         << "                       [-w [file] (windows after the muon, one \"name lo hi\" per line.  default 1 s, 1 min, 5 min)]\n"
+         << "                       [-e [keV] (min Ge energy, default 2)]\n"
+         << "                       [-n [bins] (per dt spectrum, default 600)]\n"
+         << "                       [-o [file] (default ./delayedCoins.root)]\n";
+    return 1;
+  }
+  string runFile = "", vetoDir = "./avout", windowFile = "", outFile = "./delayedCoins.root";
+  int firstRun = 0, lastRun = -1, nBins = 600;
+  double eMin = 2;
+  for (int i = 1; i < argc; i++) {
+    string opt = argv[i];
+    if (opt == "-r" && i+2 < argc) { firstRun = stoi(argv[++i]); lastRun = stoi(argv[++i]); }
+    else if (opt == "-v" && i+1 < argc) vetoDir = argv[++i];
+    else if (opt == "-w" && i+1 < argc) windowFile = argv[++i];
+    else if (opt == "-e" && i+1 < argc) eMin = stod(argv[++i]);
+    else if (opt == "-n" && i+1 < argc) nBins = stoi(argv[++i]);
+    else if (opt == "-o" && i+1 < argc) outFile = argv[++i];
+    else runFile = opt;
+  }
+  vector<int> runs;
+  if (runFile != "") {
+    ifstream in(runFile.c_str());
+    if (!in.good()) { cout << "Couldn't open " << runFile << endl; return 1; }
+    int run;
+    while (in >> run) runs.push_back(run);
+  }
+  for (int run = firstRun; run <= lastRun; run++) runs.push_back(run);
+  if (runs.empty()) { cout << "No runs.\n"; return 1; }
+
+  vector<CoinWindow> windows;
+  if (windowFile != "") {
+    if (!LoadCoinWindows(windowFile, windows)) return 1;
+  }
+  else windows = {{"1s",0,1}, {"1min",0,60}, {"5min",0,300}};
+
+  RunOffsets offsets;
+  offsets.FromMetadata(RunMetadataStore::Default());
+  GATDataSet ds;
+  StreamMerge merge(&offsets);
+  Long64_t vetoStop = 0;   // run gap muons need the previous run's stop time
+  for (auto run : runs) {
+    merge.Add(new VetoRunCursor(kVeto, run, TString::Format("%s/veto_run%i.root", vetoDir.c_str(), run).Data(), false, &vetoStop));
+    merge.Add(new GeCursor(kGe, run, ds.GetPathToRun(run, GATDataSet::kGatified), eMin));
+  }
+  double longest = 0;
+  for (auto &w : windows) if (w.hi > longest) longest = w.hi;
+  printf("Scanning %zu runs, %zu windows (longest %g s).\n", runs.size(), windows.size(), longest);
+
+  DelayedCoincidence dc(windows, nBins);
+  MergedEvent e;
+  int prevRun = -1;
+  TStopwatch timer;
+  timer.Start();
+  while (merge.Next(e))
+  {
+    if (e.run != prevRun) {
+      if (!offsets.Has(e.run)) dc.ClearMuons();
+      prevRun = e.run;
+    }
+    if (e.source == kVeto) {
+      if (e.type == 3) continue;   // run gaps aren't muons
+      dc.AddMuon(e.time, e.type, e.run);
+    }
+    else dc.AddHit(e.time, e.type);
+  }
+  timer.Stop();
+  dc.Print();
+  if (merge.GetNBackwards() > 0)
+    printf("Warning: %li events were out of time order (overlapping runs, or unsorted input).\n", merge.GetNBackwards());
+  double sec = timer.RealTime();
+  printf("%li events in %.1f s (%.0f events/s)\n", merge.GetNEvents(), sec, (sec > 0) ? merge.GetNEvents()/sec : 0);
+
+  TFile *out = new TFile(outFile.c_str(), "RECREATE");
+  dc.Write(out);
+  out->Close();
+  cout << "Wrote " << outFile << endl;
+  return 0;
+}
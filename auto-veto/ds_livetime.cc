@@ -1,57 +1,80 @@
 // MJD Data Set Livetime Calculator.
-// Future: Add corrections from LN fill, muon veto cut, and others.
+// Dead time from the muon veto cut (including bad-scaler muons) and LN fills,
+// as the union of the cut windows clipped to the run boundaries.  See Livetime.hh.
+// With -m, also the exposure of each detector, from a detector list with one
+// "[detector] [module] [active mass (g)]" per line ('#' for comments).
 //
 // Clint Wiseman, USC/Majorana
 // 10/6/2016
 
 #include <iostream>
+#include <fstream>
+#include <sstream>
 #include <map>
 #include "TTreeReader.h"
 #include "TTreeReaderArray.h"
 #include "GATDataSet.hh"
 #include "DataSetInfo.hh"
 #include "MJVetoEvent.hh"
+#include "RunTimeline.hh"
+#include "LNFillTimes.hh"
+#include "Livetime.hh"
+#include "ReaderSetup.hh"
 
 using namespace std;
 
-double vetoReduction(GATDataSet &ds, int dsNum);
+double vetoReduction(GATDataSet &ds, int dsNum, const map<int,double> &detMass, const map<int,int> &detModule);
+bool LoadDetectorMasses(string file, map<int,double> &detMass, map<int,int> &detModule);
 
 int main(int argc, char** argv)
 {
 	if (argc < 2) {
-		cout << "Usage: ./ds_livetime [dataset number]\n";
+		cout << "Usage: ./ds_livetime [dataset number] (-m [detector list: detector module mass_g]) (--io-stats) (--prefetch)\n";
 		return 1;
 	}
 	int dsNum = stoi(argv[1]);
+  ReaderSetup::ParseArgs(argc, argv);
+  map<int,double> detMass;
+  map<int,int> detModule;
+  for (int i = 2; i < argc; i++) {
+    if (string(argv[i]) == "-m" && i+1 < argc && !LoadDetectorMasses(argv[++i], detMass, detModule))
+      return 1;
+  }
 
-  // this must match the run sequences in DataSetInfo.hh
-  map<int,int> dsMap = {{0,76},{1,51},{2,7},{3,24},{4,22},{5,80}};
   GATDataSet ds;
-  for (int i = 0; i < dsMap[dsNum]; i++) {
+  for (int i = 0; i < GetNRunSeqs(dsNum); i++) {
     LoadDataSet(ds, dsNum, i);
   }
-  double vetoDeadTime = vetoReduction(ds, dsNum);
+  double vetoDeadTime = vetoReduction(ds, dsNum, detMass, detModule);
+  cout << Form("DS-%i  Veto dead time (all detectors): %.2f sec\n",dsNum,vetoDeadTime);
 
-  // NOTE: This assumes the veto'd time is within the run boundary.
-  // DS-0 3159.18
-  // Total dead time: 3159.18 seconds from 1623 muon candidate events.
-  // DS-1 3323.95
-  // Total dead time: 3323.95 seconds from 3023 muon candidate events.
-  // DS-2 572.603
-  // Total dead time: 572.603 seconds from 532 muon candidate events.
-  // DS-3 1093.16
-  // Total dead time: 1093.16 seconds from 1067 muon candidate events.
-  // DS-4 9986.62
-  // Total dead time: 9986.62 seconds from 1034 muon candidate events.
-  // DS-5 FIXME
-  // Total dead time: -9.07416e+06 seconds from 2607 muon candidate events.
+  // Old method (sum of 1+2*unc windows, no overlap or run boundary handling):
+  // DS-0 3159.18 s, 1623 muons.  DS-1 3323.95 s, 3023 muons.  DS-2 572.603 s, 532 muons.
+  // DS-3 1093.16 s, 1067 muons.  DS-4 9986.62 s, 1034 muons.  DS-5 -9.07416e+06 s, 2607 muons (negative uncertainties).
+}
 
-  // double totalLiveTime = ds.GetRunTime()/1e9; // this can take a while
-  // double adjLiveTime = totalLiveTime - vetoDeadTime;
-  // cout << Form("DS-%i  Total %.2f sec, Veto Dead %.2f sec.  Adjusted: %.2f sec\n",dsNum,totalLiveTime,vetoDeadTime,adjLiveTime);
+bool LoadDetectorMasses(string file, map<int,double> &detMass, map<int,int> &detModule)
+{
+  ifstream in(file.c_str());
+  if (!in.good()) {
+    cout << "Couldn't open detector list " << file << endl;
+    return false;
+  }
+  string line;
+  while (getline(in, line)) {
+    if (line.empty() || line[0] == '#') continue;
+    istringstream iss(line);
+    int det, mod;
+    double mass;
+    if (!(iss >> det >> mod >> mass)) continue;
+    detMass[det] = mass;
+    detModule[det] = mod;
+  }
+  cout << "Loaded " << detMass.size() << " detectors from " << file << endl;
+  return !detMass.empty();
 }
 
-double vetoReduction(GATDataSet &ds, int dsNum)
+double vetoReduction(GATDataSet &ds, int dsNum, const map<int,double> &detMass, const map<int,int> &detModule)
 {
   TChain *vetoChain = NULL;
 
@@ -65,8 +88,13 @@ double vetoReduction(GATDataSet &ds, int dsNum)
   vector<double> muRunTStarts;
   vector<double> muTimes;
   vector<double> muUncert;
+  vector<bool> muBadScaler;
+  map<int, pair<double,double> > runBounds;
   if (dsNum != 4)
   {
+    ReaderSetup vetoIO(vetoChain, "vetoChain");
+    vetoIO.SetBranches({"vetoEvent","run","start","stop","xTime","timeUncert","CoinType"});
+    vetoIO.Apply();
     TTreeReader vetoReader(vetoChain);
     TTreeReaderValue<MJVetoEvent> vetoEventIn(vetoReader,"vetoEvent");
     TTreeReaderValue<int> vetoRunIn(vetoReader,"run");
@@ -82,6 +110,7 @@ double vetoReduction(GATDataSet &ds, int dsNum)
   	{
       MJVetoEvent veto = *vetoEventIn;
       int run = *vetoRunIn;
+      runBounds[run] = make_pair((double)*vetoStart, (double)*vetoStop);
   		if (run != prevRun) newRun=true;
   		else newRun = false;
   		int type = 0;
@@ -96,12 +125,17 @@ double vetoReduction(GATDataSet &ds, int dsNum)
         else muTimes.push_back(*xTime); // time of the first veto entry in the run
         if (!veto.GetBadScaler()) muUncert.push_back(*timeUncert);
         else muUncert.push_back(8.0); // uncertainty for corrupted scalers
+        muBadScaler.push_back(veto.GetBadScaler());
       }
   		prevStop = *vetoStop;  // end of entry, save the run and stop time
   		prevRun = run;
   	}
+    vetoIO.Finish();
+  }
+  else if (dsNum==4) {
+    LoadDS4MuonList(muRuns,muRunTStarts,muTimes,muTypes,muUncert);
+    muBadScaler.assign(muRuns.size(), false);
   }
-  else if (dsNum==4) LoadDS4MuonList(muRuns,muRunTStarts,muTimes,muTypes,muUncert);
   size_t nMu = muTimes.size();
   if(nMu == 0) {
     cout << "couldn't load mu data" << endl;
@@ -109,17 +143,60 @@ double vetoReduction(GATDataSet &ds, int dsNum)
   }
   cout << "Muon list has " << muRuns.size() << " entries.\n";
 
-  double deadTimeTotal = 0;
+  // Run boundaries.  DS-4 uses the cached run info from skim-veto (see RunTimeline.hh),
+  // since its muon list is converted from DS-3 and the digitizer clock isn't reset each run.
+  LivetimeEngine live;
+  RunTimeline timeline;
+  if (dsNum==4) {
+    if (!timeline.Load("./runs/ds4-runInfo.txt"))
+      cout << "Warning: no ./runs/ds4-runInfo.txt, can't get DS-4 run boundaries.\n";
+    for (auto &rb : timeline.GetRuns()) live.AddRun(rb.run, rb.unixStart, rb.unixStop);
+  }
+  else
+    for (auto &r : runBounds) {
+      live.AddRun(r.first, r.second.first, r.second.second);
+      timeline.AddRun(r.first, 0, r.second.first, r.second.second);
+    }
+
+  // Muon windows, in global time.
   for (int i = 0; i < (int)muRuns.size(); i++)
   {
-    // this matches what's in skim_mjd_data
-    double deadTime = 1. + 2 * fabs(muUncert[i]); // 1 second window, uncertainties on both ends.
-    if (dsNum==4) deadTime = 4. + 4. * fabs(muUncert[i]);  // larger ~10s window for ds-4
-    deadTimeTotal += deadTime;
-    // printf("%i  %i  %i  %.0f  %.3f +/- %.3f  dead %.3f\n",i,muRuns[i],muTypes[i],muRunTStarts[i],muTimes[i],muUncert[i],deadTimeTotal);
-    // FIXME: ds-5 muon uncertainties are being reported as negative
+    double t_global = 0, lo = 0, hi = 0;
+    if (!timeline.ToGlobal(muRuns[i], muTimes[i], t_global))
+      t_global = muRunTStarts[i] + muTimes[i];
+    MuonVetoWindow(dsNum, t_global, muUncert[i], lo, hi);
+    live.AddDeadWindow(lo, hi, muBadScaler[i] ? LivetimeEngine::kBadScaler : LivetimeEngine::kMuon);
+    // printf("%i  %i  %i  %.0f  %.3f +/- %.3f\n",i,muRuns[i],muTypes[i],muRunTStarts[i],muTimes[i],muUncert[i]);
+  }
+
+  // LN fill windows only apply to the detectors in the module being filled.
+  vector<double> lnFillTimes1, lnFillTimes2;
+  LoadLNFillTimes1(lnFillTimes1, dsNum);
+  LoadLNFillTimes2(lnFillTimes2, dsNum);
+  double lo = 0, hi = 0;
+  for (auto t : lnFillTimes1) { LNFillWindow(t, lo, hi); live.AddDeadWindow(lo, hi, LivetimeEngine::kLNFill, 1); }
+  for (auto t : lnFillTimes2) { LNFillWindow(t, lo, hi); live.AddDeadWindow(lo, hi, LivetimeEngine::kLNFill, 2); }
+
+  double runTime = live.GetRunTime();
+  double deadTimeTotal = live.GetDeadTime();
+  cout << "Runs: " << live.GetNRuns() << "  Run time: " << runTime << " seconds.\n"
+       << "Total dead time: " << deadTimeTotal << " seconds from " << muRuns.size() << " muon candidate events.\n"
+       << "  muon windows: " << live.GetDeadTimeFrom(LivetimeEngine::kMuon)
+       << "  bad scaler muon windows: " << live.GetDeadTimeFrom(LivetimeEngine::kBadScaler)
+       << "  LN fills: " << live.GetDeadTimeFrom(LivetimeEngine::kLNFill) << "\n";
+  for (int mod = 1; mod <= 2; mod++)
+    cout << Form("Module %i: dead %.2f sec  live %.2f sec (%.4f%%)\n", mod, live.GetDeadTime(mod),
+      live.GetLiveTime(mod), runTime > 0 ? 100*live.GetLiveTime(mod)/runTime : 0);
+
+  // Each detector gets the global windows and its own module's LN fills.
+  if (!detMass.empty()) {
+    map<int,double> expoByDet;
+    double expo = live.GetExposure(detMass, detModule, &expoByDet);
+    cout << "Exposure (kg-days), per detector:\n";
+    for (auto &e : expoByDet)
+      cout << Form("  det %-6i  module %i  %7.1f g  %.4f\n", e.first, detModule.at(e.first), detMass.at(e.first), e.second);
+    cout << Form("DS-%i  Exposure: %.4f kg-days (%lu detectors)\n", dsNum, expo, expoByDet.size());
   }
-  cout << "Total dead time: " << deadTimeTotal << " seconds from " << muRuns.size() << " muon candidate events.\n";
 
   return deadTimeTotal;
-}
\ No newline at end of file
+}
@@ -14,6 +14,8 @@
 
 #include "MJTChannelMap.hh"
 #include "MJTChannelSettings.hh"
+#include "RunHarvest.hh"
+#include "SkimIndex.hh"
 
 using namespace std;
 
@@ -59,42 +61,25 @@ void durationCheckBLT()
   while(runList >> rundummy) runs.push_back(rundummy);
   runList.close();
   long prevStopUnix=0;
+  RunMetadataStore &store = RunMetadataStore::Default();
   for (auto run : runs)
   {
-    GATDataSet ds;
-  	string runPath = ds.GetPathToRun(run,GATDataSet::kBuilt);
-    // cout << runPath << endl;
-    if (runPath == "") {
-      cout << "File doesn't exist.  Continuing ..." << endl;
-      continue;
-    }
-  	TChain *blt = new TChain("MGTree");
-    if (!blt->Add(runPath.c_str())){
-  		cout << "File exists, but chain is messed up.  Continuing ...\n";
-  		continue;
-  	}
-    if (blt->GetEntries() == 0){
+    // cached: only opens the built file if the run is new or its file changed
+    const RunRecord *rec = GetRunRecord(run, store, false);
+    if (rec == NULL) continue;
+    if (rec->nGe == 0){
       cout << "No entries for run " << run << ".  Continuing ...\n";
       continue;
     }
-    TTreeReader reader(blt);
-    // TTreeReaderValue<MJTRun> bRun(reader,"run");
-    TTreeReaderValue<double> bTime(reader,"fTime");
-    TTreeReaderValue<long> bTimeStart(reader,"fStartTime");
-    TTreeReaderValue<long> bTimeStop(reader,"fStopTime");
-    reader.SetEntry(0);
-
-    // does the method above of getting these always work?
-    long startUnix = (*bTimeStart);
-    long stopUnix = (*bTimeStop);
+    long startUnix = rec->unixStart;
+    long stopUnix = rec->unixStop;
 
     // ian says these are worthless until the data is reprocessed
     // double startTS = (double)(bRun->GetStartTimeStamp())*1.e-8;
     // double stopTS = (double)(bRun->GetStopTimeStamp())*1.e-8;
 
-    double firstTime = (*bTime)*1.e-9;
-    reader.SetEntry(blt->GetEntries()-1);
-    double lastTime = (*bTime)*1.e-9;
+    double firstTime = rec->firstGeTS;
+    double lastTime = rec->lastGeTS;
 
     double diff = (lastTime-firstTime) - (double)(stopUnix - startUnix);
     long diffPackets = startUnix-prevStopUnix;
@@ -105,9 +90,9 @@ void durationCheckBLT()
     dtPackets->Fill(diffPackets);
 
     printf("%i  %li  %li  %-5li  %-10.2f  %-10.2f  %-10.2f  %-8.1f  %s  %-8li  %.0f\n", run,startUnix,stopUnix,stopUnix-startUnix,firstTime,lastTime,lastTime-firstTime,diff,whichIsAhead.c_str(),diffPackets,diff-(double)diffPackets);
-    delete blt;
     prevStopUnix = stopUnix;
   }
+  if (store.IsDirty()) store.Save();
   TCanvas *c1 = new TCanvas("c1","Bob Ross's Canvas",800,600);
   c1->SetLogy();
   dt->GetXaxis()->SetTitle("gretina duration - unix duration");
@@ -125,40 +110,19 @@ void durationCheckVETO()
   ifstream runList("./runs/p3jdy-complete.txt");
   while(runList >> rundummy) runs.push_back(rundummy);
   runList.close();
+  RunMetadataStore &store = RunMetadataStore::Default();
   for (auto run : runs)
   {
-    GATDataSet ds;
-  	string runPath = ds.GetPathToRun(run,GATDataSet::kBuilt);
-    // cout << runPath << endl;
-    if (runPath == "") {
-      cout << "File doesn't exist.  Continuing ..." << endl;
-      continue;
-    }
-  	TChain *vetoChain = new TChain("VetoTree");
-    if (!vetoChain->Add(runPath.c_str())){
-  		cout << "File exists, but chain is messed up.  Continuing ...\n";
-  		continue;
-  	}
-    if (vetoChain->GetEntries() == 0){
+    const RunRecord *rec = GetRunRecord(run, store, false);
+    if (rec == NULL) continue;
+    if (rec->nVeto == 0){
       cout << "No entries for run " << run << ".  Continuing ...\n";
       continue;
     }
-    TTreeReader reader(vetoChain);
-    // TTreeReaderValue<MJTRun> bRun(reader,"run");
-    TTreeReaderValue<double> bTime(reader,"fTime");
-    TTreeReaderValue<long> bTimeStart(reader,"fStartTime");
-    TTreeReaderValue<long> bTimeStop(reader,"fStopTime");
-    reader.SetEntry(0);
-
-    // does the method above of getting these always work?
-    long startUnix = (*bTimeStart);
-    long stopUnix = (*bTimeStop);
-    // works for p3lqk!
-    // works for p3kjr!
-    // works for p3jdy!
-
-    printf("%i  %li  %li  %li\n",run,startUnix,stopUnix,stopUnix-startUnix);
+    // fStartTime/fStopTime work for p3lqk, p3kjr, and p3jdy
+    printf("%i  %li  %li  %li\n",run,rec->unixStart,rec->unixStop,rec->GetDuration());
   }
+  if (store.IsDirty()) store.Save();
 }
 
 void ds3skimCheck()
@@ -166,13 +130,41 @@ void ds3skimCheck()
   TChain *skim = new TChain("skimTree");
   skim->Add("/project/projectdirs/majorana/data/mjd/surfmjd/analysis/skim/DS3/gatrev_153453544/*.root");
   vector<int> runList;
-  int cts = skim->Draw("run:trapENFDBSGCal:channel","trapENFDBSGCal > 6000 && channel%2==1","GOFF");
-  for (int i = 0; i < cts; i++){
-    int run = skim->GetV1()[i];
-    double ene = skim->GetV2()[i];
-    int chn = skim->GetV3()[i];
-    printf("%i  %-7.1f  %i\n",run,ene,chn);
-    runList.push_back(run);
+
+  // If the skims are indexed (./skim-index [files] -c lgOver6000 "trapENFDBSGCal > 6000 && channel%2==1"),
+  // only read the selected events.  This also isn't capped by the size of the Draw buffer.
+  TEntryList *el = SkimIndex::GetEntryList(skim, "lgOver6000");
+  if (el != NULL) {
+    skim->SetEntryList(el);
+    int run;
+    vector<int> *channel = 0;
+    vector<double> *trapENFDBSGCal = 0;
+    skim->SetBranchStatus("*",0);
+    skim->SetBranchStatus("run",1);
+    skim->SetBranchStatus("channel",1);
+    skim->SetBranchStatus("trapENFDBSGCal",1);
+    skim->SetBranchAddress("run",&run);
+    skim->SetBranchAddress("channel",&channel);
+    skim->SetBranchAddress("trapENFDBSGCal",&trapENFDBSGCal);
+    for (Long64_t i = 0; i < el->GetN(); i++) {
+      skim->GetEntry(skim->GetEntryNumber(i));
+      for (size_t j = 0; j < channel->size(); j++) {
+        if ((*trapENFDBSGCal)[j] > 6000 && (*channel)[j]%2==1) {
+          printf("%i  %-7.1f  %i\n",run,(*trapENFDBSGCal)[j],(*channel)[j]);
+          runList.push_back(run);
+        }
+      }
+    }
+  }
+  else {
+    int cts = skim->Draw("run:trapENFDBSGCal:channel","trapENFDBSGCal > 6000 && channel%2==1","GOFF");
+    for (int i = 0; i < cts; i++){
+      int run = skim->GetV1()[i];
+      double ene = skim->GetV2()[i];
+      int chn = skim->GetV3()[i];
+      printf("%i  %-7.1f  %i\n",run,ene,chn);
+      runList.push_back(run);
+    }
   }
   for (auto i : runList) cout << i << endl;
   // 17417
@@ -0,0 +1,85 @@
+// run-metadata.cc
+// Harvests (or refreshes) the run metadata cache, runs/runMetadata.txt.
+// Runs already in the cache are skipped unless their built file has changed,
+// so this can be re-run on a growing run list.
+// Usage: ./run-metadata [run list] (-ds [dsNumber]) (-f [cache file]) (-p: print)
+// C. Wiseman, USC/Majorana
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "GATDataSet.hh"
+#include "RunHarvest.hh"
+#include "DataSetInfo.hh"
+
+using namespace std;
+
+int main(int argc, char** argv)
+{
+  if (argc < 2) {
+    cout << "Usage: ./run-metadata [run list]\n"
+         << "                      [-ds [dsNumber] (use every run sequence in a data set)]\n"
+         << "                      [-f [file] (cache file, default " << RunMetadataStore::DefaultFile() << ")]\n"
+         << "                      [-p (print the records)]\n";
+    return 1;
+  }
+  string listFile = "", cacheFile = RunMetadataStore::DefaultFile();
+  int dsNumber = -1;
+  bool print = false;
+  for (int i = 1; i < argc; i++) {
+    string opt = argv[i];
+    if (opt == "-ds" && i+1 < argc) dsNumber = stoi(argv[++i]);
+    else if (opt == "-f" && i+1 < argc) cacheFile = argv[++i];
+    else if (opt == "-p") print = true;
+    else listFile = opt;
+  }
+
+  vector<int> runs;
+  if (dsNumber >= 0) {
+    for (int i = 0; i < GetNRunSeqs(dsNumber); i++) {
+      GATDataSet ds;
+      LoadDataSet(ds, dsNumber, i);
+      for (size_t j = 0; j < ds.GetNRuns(); j++) runs.push_back(ds.GetRunNumber(j));
+    }
+  }
+  if (listFile != "") {
+    ifstream runList(listFile.c_str());
+    if (!runList.good()) { cout << "Couldn't open " << listFile << endl; return 1; }
+    int run;
+    while (runList >> run) runs.push_back(run);
+  }
+
+  RunMetadataStore store;
+  store.Load(cacheFile);
+  size_t nCached = store.GetNRuns();
+  long nHarvested = 0;
+  for (auto run : runs)
+  {
+    GATDataSet ds;
+    string path = ds.GetPathToRun(run,GATDataSet::kBuilt);
+    if (store.IsCurrent(run, path)) continue;
+    RunRecord rec;
+    if (!HarvestRunRecord(run, path, rec)) {
+      cout << "No built data for run " << run << ".  Continuing ...\n";
+      continue;
+    }
+    store.Put(rec);
+    nHarvested++;
+    if (nHarvested % 100 == 0) store.Save(cacheFile);  // don't lose a long harvest
+  }
+  if (store.IsDirty()) store.Save(cacheFile);
+  printf("%lu runs requested, %lu were cached, %li harvested.  %lu runs in %s\n",
+    runs.size(), nCached, nHarvested, store.GetNRuns(), cacheFile.c_str());
+
+  if (print) {
+    for (auto run : runs) {
+      const RunRecord *r = store.Get(run);
+      if (r == NULL) continue;
+      printf("%i  %li  %li  %-5li  %-8.1f  %-10.2f  %-10.2f  Ge %-8li  veto %-8li  %.2f %.2f\n",
+        r->run, r->unixStart, r->unixStop, r->GetDuration(), r->GetRunTime(), r->firstGeTS, r->lastGeTS,
+        r->nGe, r->nVeto, r->firstScaler, r->lastScaler);
+    }
+  }
+  return 0;
+}
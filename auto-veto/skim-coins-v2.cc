@@ -30,6 +30,10 @@
 #include "MJVetoEvent.hh"
 
 #include "DataSetInfo.hh"
+#include "Livetime.hh"
+#include "Provenance.hh"
+#include "SkimPrefilter.hh"
+#include "ReaderSetup.hh"
 
 using namespace std;
 using namespace CLHEP;
@@ -40,8 +44,8 @@ void LoadActiveMasses(map<int,double>& activeMassForDetID_g, int dsNumber);
 
 int main(int argc, const char** argv)
 {
-  if(argc < 3 || argc > 9) {
-    cout << "Usage for data sets: " << argv[0] << " [dataset number] [runseq] (output path)" << endl;
+  if(argc < 3 || argc > 11) {
+    cout << "Usage for data sets: " << argv[0] << " [dataset number] [runseq] (output path) (--only-stale) (--prefilter | --no-prefilter) (--io-stats) (--prefetch)" << endl;
     return 1;
   }
 
@@ -55,8 +59,35 @@ int main(int argc, const char** argv)
   double energyThresh = 2.0;
   bool smallOutput = true;
   bool simulatedInput = false;
+  bool onlyStale = false;
   vector<string> args;
   for(int iArg=0; iArg<argc; ++iArg) args.push_back(argv[iArg]);
+  int prefilterArg = -1;  // -1: decide from the thresholds
+  auto prefilterOnArg = find(args.begin(), args.end(), "--prefilter");
+  if(prefilterOnArg!=args.end()){
+    prefilterArg = 1;
+    args.erase(prefilterOnArg);
+  }
+  auto prefilterOffArg = find(args.begin(), args.end(), "--no-prefilter");
+  if(prefilterOffArg!=args.end()){
+    prefilterArg = 0;
+    args.erase(prefilterOffArg);
+  }
+  auto ioStatsArg = find(args.begin(), args.end(), "--io-stats");
+  if(ioStatsArg!=args.end()){
+    ReaderSetup::IOStats() = true;
+    args.erase(ioStatsArg);
+  }
+  auto prefetchArg = find(args.begin(), args.end(), "--prefetch");
+  if(prefetchArg!=args.end()){
+    ReaderSetup::SetPrefetch(true);
+    args.erase(prefetchArg);
+  }
+  auto onlyStaleArg = find(args.begin(), args.end(), "--only-stale");
+  if(onlyStaleArg!=args.end()){
+    onlyStale = true;
+    args.erase(onlyStaleArg);
+  }
 
   // This version only runs over datasets
   dsNumber = stoi(args[1]);
@@ -64,11 +95,40 @@ int main(int argc, const char** argv)
   args.erase(args.begin()+1, args.begin()+3);
   cout << "loading dataset " << dsNumber << " run sequence " << runSeq << endl;
   LoadDataSet(ds, dsNumber, runSeq);
+  if(args.size() > 1) outputPath += args[1];
+
+  // output file name
+  string filename = TString::Format("skimDS%d_", dsNumber).Data();
+  char runStr[10];
+  sprintf(runStr, "%d", runSeq);
+  filename += runStr;
+  filename += ".root";
+  if(outputPath != "") filename = outputPath + "/" + filename;
 
   // set up dataset
   cout << " getting chain\n";
   if(gatChain==NULL) gatChain = ds.GetGatifiedChain(false);
+  if(vetoChain==NULL) vetoChain = ds.GetVetoChain();
   cout << "got chain\n";
+
+  // Provenance: every input file, and the settings that change the skim file.
+  Manifest manifest("skim-coins-v2", string(MJDVETO_VERSION) + "-gat" + GATUtils::GetGATRevision()), prevManifest;
+  manifest.AddInputs(gatChain);
+  if(dsNumber == 4) {
+    manifest.AddInput("./runs/ds4-muonList.txt");
+    manifest.AddInput(RunCatalog::DefaultFile());
+  }
+  else manifest.AddInputs(vetoChain);
+  manifest.AddParam("smallOutput", smallOutput);
+  bool havePrev = prevManifest.Load(Manifest::FileName(filename));
+  if(onlyStale) {
+    string why;
+    if(manifest.IsUpToDate(filename, why)) {
+      cout << filename << " is up to date.  Skipping ..." << endl;
+      return 0;
+    }
+    cout << filename << " is stale: " << why << endl;
+  }
   TTreeReader gatReader(gatChain);
 
   // set up input chain value readers
@@ -200,12 +260,6 @@ int main(int argc, const char** argv)
 
 
   // set up output file and tree
-  string filename = TString::Format("skimDS%d_", dsNumber).Data();
-  char runStr[10];
-  sprintf(runStr, "%d", runSeq);
-  filename += runStr;
-  filename += ".root";
-  if(outputPath != "") filename = outputPath + "/" + filename;
   TFile *fOut = TFile::Open(filename.c_str(), "recreate");
   TTree* skimTree = new TTree("skimTree", "skimTree");
 
@@ -517,6 +571,13 @@ int main(int argc, const char** argv)
     detIDIsVetoOnly[1427120] = true;
   }
 
+  // Two-phase reads: only events with a hit over the cut are read in full (SkimPrefilter.hh)
+  SkimPrefilter prefilter(smallOutput ? 200. : 2000., smallOutput ? 200. : 2000.);
+  bool usePrefilter = !simulatedInput && (prefilterArg == -1 ? prefilter.IsRecommended() : prefilterArg == 1);
+  ReaderSetup gatIO(gatChain, "gatChain");
+  if(usePrefilter) gatIO.SetBranches(SkimPrefilter::Phase1Branches());
+  gatIO.Apply();
+
   // start loop over all events
   while(gatReader.Next()) {
 
@@ -531,6 +592,9 @@ int main(int argc, const char** argv)
 
     // Skip this event if it is a pulser event as identified by Pinghan
     if(*eventDC1BitsIn & kPinghanPulserMask) continue;
+
+    // Phase 1: skip the event unless some hit can pass the energy cut
+    if(usePrefilter && !prefilter.Pass(*channelIn, *trapENFCalIn, *trapECalIn)) continue;
     iEvent = gatChain->GetTree()->GetReadEntry();
 
     // copy the event-level info to the output fields
@@ -603,15 +667,15 @@ int main(int argc, const char** argv)
       // skip all hits with E_H < 2 keV, E_L < 10 keV in -both- trapE and trapENF
       // For small skim files, skip all hits with E_H and E_L < 200 keV in trapE and trapENF
       double hitENFCal = (*trapENFCalIn)[i];
-      double hitENMCal = (*trapENMCalIn)[i];
-      // double hitENF = (*trapENFIn)[i];
       double hitEMax = (*trapECalIn)[i];
-      // double hitTrapMax = hitENMCal;
       int hitCh = (*channelIn)[i];
       if(!smallOutput && hitCh%2 == 0 && hitENFCal < 2000 && hitEMax < 2000) continue;  // set for veto
       if(!smallOutput && hitCh%2 == 1 && hitENFCal < 2000 && hitEMax < 2000) continue;
       if(smallOutput && hitCh%2 == 0 && hitENFCal <  200. && hitEMax < 200.) continue;
       if(smallOutput && hitCh%2 == 1 && hitENFCal < 200. && hitEMax < 200.) continue;
+      // double hitENF = (*trapENFIn)[i];
+      double hitENMCal = (*trapENMCalIn)[i];  // (read after the cut, so dropped hits don't load it)
+      // double hitTrapMax = hitENMCal;
       // skip hits from totally "bad" detectors (not biased, etc), or from
       // use-for-veto-only detectors if E < 10 keV
       int hitDetID = (*detIDIn)[i];
@@ -698,11 +762,8 @@ int main(int argc, const char** argv)
         else
           dtmu = (hitT_s - muTimes[iMu]);
 
-        bool vetoThisHit = (dtmu > -1.*(muUncert[iMu]) && dtmu < (1. + muUncert[iMu]));
-
-        // DS-4 requires a larger window due to synchronization issues.
-        if (dsNumber==4)
-          vetoThisHit = (dtmu > -3.*(muUncert[iMu]) && dtmu < (4. + muUncert[iMu]));
+        // Same window that ds_livetime uses (see Livetime.hh)
+        bool vetoThisHit = InMuonVetoWindow(dsNumber, dtmu, muUncert[iMu]);
 
         // if (vetoThisHit) printf("Coin: iMu %-4lu  det %i  gRun %-4i  mRun %-5i  tGe %-7.3f  tMu %-7.3f  ene %-6.0f  veto? %i  dtmu %.2f +/- %.2f\n", iMu,hitCh,run,muRuns[iMu],hitT_s,muTimes[iMu],hitENFCal,vetoThisHit,dtmu,muUncert[iMu]);
 
@@ -726,10 +787,14 @@ int main(int argc, const char** argv)
     skimTree->Fill();
   }
 
+  if(usePrefilter) prefilter.Print();
+  gatIO.Finish();
+
   // write output tree to output file
   cout << "Closing out skim file..." << endl;
   skimTree->Write("", TObject::kOverwrite);
   fOut->Close();
+  manifest.Save(Manifest::FileName(filename), havePrev ? &prevManifest : NULL);
   return 0;
 }
 
@@ -35,8 +35,6 @@ using namespace CLHEP;
 
 void LoadDataSet(GATDataSet& ds, int dsNumber, size_t iRunSeq);
 void LoadRun(GATDataSet& ds, size_t iRunSeq);
-void LoadDS4MuonList(vector<int> &muRuns, vector<double> &muRunTStarts, vector<double> &muTimes,
-  vector<int> &muTypes, vector<double> &muUncert);
 
 int main(int argc, const char** argv)
 {
@@ -0,0 +1,147 @@
+// skim-index.cc
+// Builds the entry-list indexes for skim files (see SkimIndex.hh), in one pass per file.
+// Usage: ./skim-index [skim files ...] (-b [energy branch]) (-e [keV]) (-c [name] "[selection]") (--only-stale)
+// C. Wiseman, USC/Majorana
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include "TFile.h"
+#include "TTree.h"
+#include "TEntryList.h"
+#include "TTreeReader.h"
+#include "TTreeReaderValue.h"
+#include "SkimIndex.hh"
+#include "Provenance.hh"
+
+using namespace std;
+
+bool BuildIndex(string skimFile, string eBranch, double eThresh, const vector<pair<string,string> > &custom, bool onlyStale);
+
+int main(int argc, char** argv)
+{
+  if (argc < 2) {
+    cout << "Usage: ./skim-index [skim files ...]\n"
+         << "                    [-b [branch] (hit energy, default trapENFCal)]\n"
+         << "                    [-e [keV] (high-energy threshold, default 2630)]\n"
+         << "                    [-c [name] \"[selection]\" (extra index from a TTree::Draw selection, can repeat)]\n"
+         << "                    [--only-stale (skip indexes whose skim file and settings haven't changed)]\n";
+    return 1;
+  }
+  vector<string> skimFiles;
+  vector<pair<string,string> > custom;
+  string eBranch = "trapENFCal";
+  double eThresh = 2630;
+  bool onlyStale = false;
+  for (int i = 1; i < argc; i++) {
+    string opt = argv[i];
+    if (opt == "-b" && i+1 < argc) eBranch = argv[++i];
+    else if (opt == "-e" && i+1 < argc) eThresh = stod(argv[++i]);
+    else if (opt == "-c" && i+2 < argc) { custom.push_back(make_pair(string(argv[i+1]), string(argv[i+2]))); i += 2; }
+    else if (opt == "--only-stale") onlyStale = true;
+    else skimFiles.push_back(opt);
+  }
+  int nFailed = 0;
+  for (auto &f : skimFiles)
+    if (!BuildIndex(f, eBranch, eThresh, custom, onlyStale)) nFailed++;
+  return (nFailed > 0) ? 1 : 0;
+}
+
+bool BuildIndex(string skimFile, string eBranch, double eThresh, const vector<pair<string,string> > &custom, bool onlyStale)
+{
+  string indexFile = SkimIndex::IndexFileName(skimFile);
+  Manifest manifest("skim-index"), prevManifest;
+  manifest.AddInput(skimFile);
+  manifest.AddParam("eBranch", eBranch);
+  manifest.AddParam("eThresh", eThresh);
+  for (auto &c : custom) manifest.AddParam("custom_" + c.first, c.second);
+  bool havePrev = prevManifest.Load(Manifest::FileName(indexFile));
+  string why;
+  if (onlyStale && manifest.IsUpToDate(indexFile, why)) {
+    cout << indexFile << " is up to date, skipping.\n";
+    return true;
+  }
+
+  TFile *f = TFile::Open(skimFile.c_str());
+  if (f == NULL || f->IsZombie()) { cout << "Couldn't open " << skimFile << endl; return false; }
+  TTree *skim = (TTree*)f->Get("skimTree");
+  if (skim == NULL) { cout << "No skimTree in " << skimFile << endl; f->Close(); return false; }
+  long nEntries = skim->GetEntries();
+
+  // Branches that aren't in every skim (e.g. simulated input) are skipped.
+  TTreeReader reader(skim);
+  TTreeReaderValue< vector<int> > channelIn(reader, "channel");
+  TTreeReaderValue< vector<int> > detIDIn(reader, "detID");
+  TTreeReaderValue< vector<double> > energyIn(reader, eBranch.c_str());
+  TTreeReaderValue< vector<bool> > *muVetoIn = NULL, *lnFill1In = NULL, *lnFill2In = NULL;
+  if (skim->GetBranch("muVeto")) muVetoIn = new TTreeReaderValue< vector<bool> >(reader, "muVeto");
+  if (skim->GetBranch("isLNFill1")) {
+    lnFill1In = new TTreeReaderValue< vector<bool> >(reader, "isLNFill1");
+    lnFill2In = new TTreeReaderValue< vector<bool> >(reader, "isLNFill2");
+  }
+
+  TFile *fOut = new TFile(indexFile.c_str(), "RECREATE");
+  char title[200];
+  sprintf(title, "low-gain %s > %.0f", eBranch.c_str(), eThresh);
+  TEntryList *highELG = new TEntryList("highE_LG", title, "skimTree", skimFile.c_str());
+  sprintf(title, "high-gain %s > %.0f", eBranch.c_str(), eThresh);
+  TEntryList *highEHG = new TEntryList("highE_HG", title, "skimTree", skimFile.c_str());
+  TEntryList *muVeto = new TEntryList("muVeto", "muVeto", "skimTree", skimFile.c_str());
+  TEntryList *lnFill = new TEntryList("isLNFill", "isLNFill1 || isLNFill2", "skimTree", skimFile.c_str());
+  map<int, TEntryList*> byDet;
+
+  while (reader.Next())
+  {
+    long entry = reader.GetCurrentEntry();
+    const vector<int> &chan = *channelIn;
+    const vector<double> &ene = *energyIn;
+    bool hitLG = false, hitHG = false, hitMu = false, hitLN = false;
+    for (size_t i = 0; i < chan.size() && i < ene.size(); i++) {
+      if (ene[i] > eThresh) {
+        if (chan[i] % 2 == 1) hitLG = true;
+        else hitHG = true;
+      }
+      if (muVetoIn && (**muVetoIn)[i]) hitMu = true;
+      if (lnFill1In && ((**lnFill1In)[i] || (**lnFill2In)[i])) hitLN = true;
+      int det = (*detIDIn)[i];
+      auto search = byDet.find(det);
+      if (search == byDet.end()) {
+        string name = "det_" + to_string(det);
+        search = byDet.insert(make_pair(det, new TEntryList(name.c_str(), name.c_str(), "skimTree", skimFile.c_str()))).first;
+      }
+      search->second->Enter(entry);  // (repeat entries are ignored)
+    }
+    if (hitLG) highELG->Enter(entry);
+    if (hitHG) highEHG->Enter(entry);
+    if (hitMu) muVeto->Enter(entry);
+    if (hitLN) lnFill->Enter(entry);
+  }
+  fOut->cd();
+  highELG->Write();
+  highEHG->Write();
+  if (muVetoIn) muVeto->Write();
+  if (lnFill1In) lnFill->Write();
+  for (auto &d : byDet) d.second->Write();
+
+  // Custom selections go through TTree::Draw, which makes the entry list itself.
+  for (auto &c : custom) {
+    f->cd();
+    skim->Draw((">>" + c.first).c_str(), c.second.c_str(), "entrylist");
+    TEntryList *el = (TEntryList*)gDirectory->Get(c.first.c_str());
+    if (el == NULL) { cout << "Selection \"" << c.second << "\" failed for " << skimFile << endl; continue; }
+    el->SetTitle(c.second.c_str());
+    fOut->cd();
+    el->Write(c.first.c_str());
+  }
+
+  printf("%s: %li entries.  highE_LG %lli  highE_HG %lli  muVeto %lli  isLNFill %lli  detectors %lu\n",
+    indexFile.c_str(), nEntries, highELG->GetN(), highEHG->GetN(), muVeto->GetN(), lnFill->GetN(), byDet.size());
+  fOut->Close();
+  f->Close();
+  delete muVetoIn;
+  delete lnFill1In;
+  delete lnFill2In;
+  manifest.Save(Manifest::FileName(indexFile), havePrev ? &prevManifest : NULL);
+  return true;
+}
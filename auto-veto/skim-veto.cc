@@ -23,6 +23,9 @@
 #include "MGTEvent.hh"
 #include "GATDataSet.hh"
 #include "DataSetInfo.hh"
+#include "RunTimeline.hh"
+#include "Livetime.hh"
+#include "PanelMonitor.hh"
 
 using namespace std;
 
@@ -31,17 +34,18 @@ void GenerateDisplayList(TChain *vetoTree);
 void CalculateDeadTime(string MuonList, int dsNumber);
 int PanelMap(int i, int runNum);
 void ListRunOffsets(TChain *vetoTree);
-void GetRunInfo();
+void GetRunInfo(RunTimeline &timeline, string runListFile, string infoFile);
 void GenerateDS4MuonList();
-void LoadDS4MuonList(vector<int> &muRuns, vector<double> &muRunTStarts, vector<double> &muTimes,
-  vector<int> &muTypes, vector<double> &muUncert);
-double PanelInfo(int run, int panel, string option);
 void CheckHitRate(TChain *vetoTree);
 void LEDPlots();
 void MuonTimeUncertainty();
 
 int main(int argc, char** argv)
 {
+  if (argc > 1 && string(argv[1]) == "-ds4list") {
+    GenerateDS4MuonList();
+    return 0;
+  }
 	// if (argc < 2) {
 	// 	cout << "Usage: ./skim-veto [run list file]\n"
   //        << "                   -r [run number]\n"
@@ -53,7 +57,6 @@ int main(int argc, char** argv)
   // string opt1 = argv[1];
   // TChain *vetoTree = new TChain("vetoTree");
   // if (opt1 == "-ds4list"){
-  //   GetRunInfo();  // input to GenerateDS4MuonList
   //   GenerateDS4MuonList();
   // }
   // else if (opt1 == "-r"){
@@ -193,8 +196,9 @@ void GenerateDisplayList(TChain *vetoTree)
 
 void CalculateDeadTime(string MuonList, int dsNumber)
 {
-  // OBSOLETE:  Need to use the auto-veto files.
-  // TO DO: Use the method employed by skim-coins.
+  // Old muon list format: run, run start (unix), hit time, type, bad scaler.
+  // Uses the skim / ds_livetime veto window (Livetime.hh), with 8 sec uncertainty for
+  // bad scalers, and merges overlapping windows.  No run boundaries in this format.
 
   ifstream InputList(MuonList.c_str());
   if(!InputList.good()) {
@@ -204,39 +208,19 @@ void CalculateDeadTime(string MuonList, int dsNumber)
 	long utc;
 	bool badScaler;
 	int run, type, numBadScalers=0;
-	double timeBefore=0, timeAfter=0, badScalerWindow=0, deadTime=0, deadBadScalerTime=0, hitTime=0;
-	if (dsNumber != 4){
-		timeBefore = .0002;		// 0.2 ms before
-		timeAfter = 1;			// 1 sec after
-		badScalerWindow = 8;  	// +/- 8 sec
-	}
-	else if (dsNumber == 4){
-		// for now, use a larger window for M2 because we are less sure of clock sync
-		timeBefore = 2;
-		timeAfter = 2;
-		badScalerWindow = 8;
-	}
-	while(true)
+	double hitTime=0, lo=0, hi=0;
+  IntervalSet dead, deadBadScaler;
+	while(InputList >> run >> utc >> hitTime >> type >> badScaler)
 	{
-		InputList >> run >> utc >> hitTime >> type >> badScaler;
-		if (InputList.eof()) break;
-		if (type==1 || type==2)
-		{
-			if (badScaler) {
-				deadTime += 2*badScalerWindow;
-				deadBadScalerTime += 2*badScalerWindow;
-			}
-			else deadTime += timeBefore + timeAfter;
-		}
-		if (type == 3) {
-			if (badScaler) {
-				deadTime += badScalerWindow;
-				deadBadScalerTime += badScalerWindow;
-			}
-			else deadTime += timeAfter;
-		}
-		if (badScaler) numBadScalers++;
+    if (type < 1 || type > 3) continue;
+    MuonVetoWindow(dsNumber, utc + hitTime, badScaler ? 8. : 0., lo, hi);
+    dead.Add(lo, hi);
+		if (badScaler) {
+      deadBadScaler.Add(lo, hi);
+      numBadScalers++;
+    }
 	}
+  double deadTime = dead.Length(), deadBadScalerTime = deadBadScaler.Length();
 	printf("Dead time due to veto: %.2f seconds.\n",deadTime);
 	if (numBadScalers > 0) printf("Bad scalers: %i, %.2f of %.2f sec (%.2f%%)\n", numBadScalers,deadBadScalerTime,deadTime,((double)deadBadScalerTime/deadTime)*100);
 }
@@ -337,22 +321,22 @@ void ListRunOffsets(TChain *vetoTree)
   c1->Print("./output/scalerUnc.pdf");
 }
 
-void GetRunInfo()
+void GetRunInfo(RunTimeline &timeline, string runListFile, string infoFile)
 {
+  // Harvest run boundaries from the gatified data, for any runs in the list
+  // that aren't already in the cached info file.
   // TODO: When GetStartTimeStamp becomes available,
   // need to regenerate these lists to use it.
+  timeline.Load(infoFile);
   int run = 0;
-  ifstream runFile("./runs/ds3-complete.txt");
-  ofstream infoFile("./runs/ds3-runInfo.txt");
-  // ifstream runFile("./runs/ds4-complete.txt");
-  // ofstream infoFile("./runs/ds4-runInfo.txt");
+  ifstream runFile(runListFile.c_str());
   vector<int> runList;
-  vector<double> digStarts;
-  vector<double> unixStarts;
-  vector<double> unixStops;
   while (runFile >> run) runList.push_back(run);
+  runFile.close();
+  int nNew = 0;
   for (auto i : runList)
   {
+    if (timeline.HasRun(i)) continue;
     GATDataSet *ds = new GATDataSet(i);
     TChain *gatChain = ds->GetGatifiedChain(false);
     TTreeReader gatReader(gatChain);
@@ -361,48 +345,26 @@ void GetRunInfo()
     TTreeReaderValue< vector<double> > timestampIn(gatReader, "timestamp");
     gatReader.SetEntry(0);
     double firstGretinaTS = (*timestampIn)[0]*1.e-8;
-    digStarts.push_back(firstGretinaTS);
-    unixStarts.push_back(*startTimeIn);
-    unixStops.push_back(*stopTimeIn);
+    timeline.AddRun(i, firstGretinaTS, *startTimeIn, *stopTimeIn);
     printf("%i  %-8.3f  %li  %li\n",i,firstGretinaTS,(long)(*startTimeIn),(long)(*stopTimeIn));
-    infoFile << i << "  " << setprecision(15) << firstGretinaTS << "  "
-                << (long)(*startTimeIn) << "  " << (long)(*stopTimeIn) << endl;
+    nNew++;
     delete ds;
   }
-  runFile.close();
-  infoFile.close();
+  if (nNew > 0) timeline.Save(infoFile);
+  printf("Run info: %lu runs (%i new) in %s\n",timeline.GetNRuns(),nNew,infoFile.c_str());
 }
 
 void GenerateDS4MuonList()
 {
-  int run;
-  double digStart, unixStart, unixStop;
-
-  // load run info
-  ifstream ds3infoFile("./runs/ds3-runInfo.txt");
+  // load run info (cached in the runInfo files, only new runs are read from the data)
+  RunTimeline ds3Timeline, ds4Timeline;
+  GetRunInfo(ds3Timeline, "./runs/ds3-complete.txt", "./runs/ds3-runInfo.txt");
+  GetRunInfo(ds4Timeline, "./runs/ds4-complete.txt", "./runs/ds4-runInfo.txt");
   vector<int> ds3runList;
-  vector<double> ds3digStarts;
-  vector<double> ds3unixStarts;
-  vector<double> ds3unixStops;
-  while (ds3infoFile >> run >> digStart >> unixStart >> unixStop){
-    ds3runList.push_back(run);
-    ds3digStarts.push_back(digStart);
-    ds3unixStarts.push_back(unixStart);
-    ds3unixStops.push_back(unixStop);
-  }
-  ds3infoFile.close();
-  ifstream ds4infoFile("./runs/ds4-runInfo.txt");
-  vector<int> ds4runList;
-  vector<double> ds4digStarts;
-  vector<double> ds4unixStarts;
-  vector<double> ds4unixStops;
-  while (ds4infoFile >> run >> digStart >> unixStart >> unixStop){
-    ds4runList.push_back(run);
-    ds4digStarts.push_back(digStart);
-    ds4unixStarts.push_back(unixStart);
-    ds4unixStops.push_back(unixStop);
-  }
-  ds4infoFile.close();
+  int run = 0;
+  ifstream ds3runFile("./runs/ds3-complete.txt");
+  while (ds3runFile >> run) ds3runList.push_back(run);
+  ds3runFile.close();
 
   // load veto data
   TChain *vetoTree = new TChain("vetoTree");
@@ -452,126 +414,96 @@ void GenerateDS4MuonList()
 	}
 
   // Convert the ds-3 muon list into ds-4 muon list.
-  vector<int> ds4muRuns;
-  vector<double> ds4muRunTStarts;
-  vector<double> ds4muTimes;
-  vector<int> ds4muTypes;
-  vector<double> ds4muUncert;
+  // Each muon goes DS-3 local time --> global unix time --> DS-4 run and local time.
+  ofstream muFile("./runs/ds4-muonList.txt");
+  int nDS4 = 0;
   for (int i = 0; i < (int)muRuns.size(); i++)
   {
-    auto it = find(ds3runList.begin(), ds3runList.end(), muRuns[i]);
-    if (it != ds3runList.end())
-    {
-      auto idx = distance(ds3runList.begin(), it);
-      double t_global_mu1 = (muTimes[i] - ds3digStarts[idx]) + ds3unixStarts[idx];
-
-      for (int idx2 = 0; idx2 < (int)ds4runList.size(); idx2++)
-      {
-        if (t_global_mu1 > ds4unixStarts[idx2] && t_global_mu1 < ds4unixStops[idx2])
-        {
-          double t_mu2 = (t_global_mu1 - ds4unixStarts[idx2]) + ds4digStarts[idx2];  // relative time + digitizer start time
-          double t_mu2_uncert = sqrt(pow(1.e-8,2) + pow(1.e-8,2) + 2*pow(1.,2) + pow(muUncert[i],2));
-          ds4muRuns.push_back(ds4runList[idx2]);
-          ds4muRunTStarts.push_back(ds4unixStarts[idx2]);
-          ds4muTimes.push_back(t_mu2);
-          ds4muUncert.push_back(t_mu2_uncert);
-          ds4muTypes.push_back(muTypes[i]);
-          printf("%lu  glob %li  %i (%-8.2fs)  %i (%-8.2fs)  ds4loc %-6.2f +/- %-4.2f\n", ds4muRuns.size(), (long)t_global_mu1, ds4runList[idx2], t_global_mu1-ds4unixStarts[idx2], ds3runList[idx], muTimes[i]-ds3digStarts[idx], t_mu2, t_mu2_uncert);
-          break;
-        }
-      }
+    double t_global_mu1 = 0, t_mu2 = 0;
+    int ds4run = 0;
+    if (!ds3Timeline.ToGlobal(muRuns[i], muTimes[i], t_global_mu1)) {
+      cout << "Couldn't find this run in the muon list.\n";
+      continue;
     }
-    else cout << "Couldn't find this run in the muon list.\n";
+    if (!ds4Timeline.ToLocal(t_global_mu1, ds4run, t_mu2)) continue;
+
+    double t_mu2_uncert = sqrt(pow(1.e-8,2) + pow(1.e-8,2) + 2*pow(1.,2) + pow(muUncert[i],2));
+    const RunBounds *ds4rb = ds4Timeline.GetRun(ds4run);
+    muFile << ds4run << "  " << (long)ds4rb->unixStart << "  " << setprecision(9) << t_mu2
+           << "  " << muTypes[i] << "  " << setprecision(9) << t_mu2_uncert << endl;
+    nDS4++;
+    printf("%i  glob %li  %i (%-8.2fs)  %i  ds4loc %-6.2f +/- %-4.2f\n", nDS4, (long)t_global_mu1, ds4run, t_global_mu1-ds4rb->unixStart, muRuns[i], t_mu2, t_mu2_uncert);
   }
+  muFile.close();
   // check muon list
-  cout << ds4muRuns.size() << " of " << muRuns.size() << " DS-3 muon candidates persisted in DS-4.\n";
-  // for (int i = 0; i < (int)ds4muRuns.size(); i++)
-    // printf("%i  %i  %.0f  %.3f  %.3f\n",ds4muRuns[i],ds4muTypes[i],ds4muRunTStarts[i],ds4muTimes[i],ds4muUncert[i]);
-
-
-  // Create the dictionaries for use in $GATDIR/Apps/DataSetInfo.hh
-
-  // cout << "vector<int> ds4muRuns = {";
-  // for (int i = 0; i < (int)ds4muRuns.size()-1; i++) cout << ds4muRuns[i] << ", ";
-  // cout << ds4muRuns[(int)ds4muRuns.size()-1] << "};\n\n";
-  //
-  // cout << "vector<int> ds4muTypes = {";
-  // for (int i = 0; i < (int)ds4muTypes.size()-1; i++) cout << ds4muTypes[i] << ", ";
-  // cout << ds4muTypes[(int)ds4muTypes.size()-1] << "};\n\n";
-  //
-  // cout << "vector<int> ds4muRunTStarts = {";
-  // for (int i = 0; i < (int)ds4muRunTStarts.size()-1; i++) cout << (long)ds4muRunTStarts[i] << ", ";
-  // cout << (long)ds4muRunTStarts[(int)ds4muRunTStarts.size()-1] << "};\n\n";
-  //
-  // cout << "vector<int> ds4muTimes = {";
-  // for (int i = 0; i < (int)ds4muTimes.size()-1; i++) cout << setprecision(9) << ds4muTimes[i] << ", ";
-  // cout << setprecision(9) << ds4muTimes[(int)ds4muTimes.size()-1] << "};\n\n";
-  //
-  // cout << "vector<int> ds4muUncert = {";
-  // for (int i = 0; i < (int)ds4muUncert.size()-1; i++) cout << setprecision(9) << ds4muUncert[i] << ", ";
-  // cout << setprecision(9) << ds4muUncert[(int)ds4muUncert.size()-1] << "};\n\n";
-}
-
-double PanelInfo(int run, int panel, string option)
-{
-  // Implemented for DS3 and onward.
-
-  // Each panel's mean hit rate:
-
-  vector<double> hitRateMean =  {0.007338, 0.007482, 0.007730, 0.009183, 0.005995, 0.005272, 0.005786, 0.013200, 0.007360, 0.008041, 0.006708, 0.004830, 0.006750, 0.010310, 0.011600, 0.020450, 0.006718, 0.028900, 0.008145, 0.025110, 0.002854, 0.003381, 0.006357, 0.002808, 0.0006327, 0.0010950, 0.0003902, 0.003375, 0.0022120, 0.005735, 0.0007639, 0.005983};
-
-  vector<double> hitRateSig = {0.001709, 0.001793, 0.001888, 0.002020, 0.001848, 0.00145 , 0.001414, 0.002276, 0.001566, 0.001775, 0.001587, 0.001344, 0.001948, 0.001995, 0.002273, 0.002962, 0.001635, 0.003787, 0.002711, 0.003167, 0.001129, 0.001145, 0.001727, 0.001200, 0.0004681, 0.0006459, 0.0003892, 0.001133, 0.0009158, 0.001850, 0.0005355, 0.001726};
-
-  // Each panel's mean qdc value:
-
-  vector<double> qdcMean = {925, 629.8, 1268, 993.4, 2151, 849.8, 720.2, 2997, 1585, 1185, 1495, 1207, 709.9, 1007, 1702, 2592, 643.2, 1040, 1115, 1307, 1917, 2027, 1214, 1069, 3783, 638.7, 1595, 1138, 1079, 1699, 2476, 3843};
-
-  vector<double> qdcSig = {220, 108.9, 175.6, 136.8, 309.9, 131.9, 115.1, 396.4, 228.5, 182.1, 230.5, 170.5, 93.33, 119.2, 207.9, 319.6, 155.6, 142,  217.2, 173.4, 272.5, 264.5, 145,  215.5, 269.2, 164.6, 263.8, 186.3, 204.9, 253.8, 282.3, 209.7};
-
-  // For runs > 19091:
-
-  vector<double> qdcMean2 = {3772, 520.1, 1491, 1110, 2306, 970.3, 2380, 3445, 1676, 1433, 1617, 1292, 857.2, 1124, 2104, 2576, 701.3, 1160, 1312, 1409, 2131, 2279, 1383, 1199, 1048, 743.7, 1688, 1220, 1343, 1760, 2212, 1828};
-
-  vector<double> qdcSig2 =  {297, 92.38, 199.9, 150.1, 321.5, 149.5, 299.3, 387.1, 239.2, 212.6, 244.3, 178.9, 113,  129.6, 245.3, 312.3, 162.3, 154.5, 255.4, 184.5, 292.5, 288.8, 161, 228.7, 210, 176,  270.8, 194.4, 230.4, 261.8, 316, 230.8};
-
-  if (option=="hitRateMean") return hitRateMean[panel];
-  if (option=="hitRateSig") return hitRateSig[panel];
-  if (option=="qdcMean" && run > 19091 && run < 4500000) return qdcMean2[panel];
-  if (option=="qdcMean" && run < 19091 && run < 4500000) return qdcMean[panel];
-  if (option=="qdcSig" && run > 19091 && run > 16797) return qdcSig2[panel];
-  if (option=="qdcSig" && run > 19091 && run > 16797) return qdcSig[panel];
-  return 0;
+  cout << nDS4 << " of " << muRuns.size() << " DS-3 muon candidates persisted in DS-4.\n"
+       << "Wrote ./runs/ds4-muonList.txt (read by LoadDS4MuonList in DataSetInfo.hh)\n";
 }
 
+// Panel health for a run range: the non-LED hit rate and LED QDC of each panel, per run.
+// (Runs processed by the current auto-veto also have this in their panelTree.)
 void CheckHitRate(TChain *vetoTree)
 {
   TTreeReader reader(vetoTree);
-  TTreeReaderValue<MJVetoEvent> events(reader,"events");
+  TTreeReaderValue<MJVetoEvent> vetoEventIn(reader,"vetoEvent");
+  TTreeReaderValue<int> runIn(reader,"run");
   TTreeReaderValue<double> durationIn(reader,"unixDuration");
   TTreeReaderValue<double> xTime(reader,"xTime");
+  TTreeReaderValue<int> ledThreshIn(reader,"LEDSimpleThreshold");
+
+  TGraphErrors *rateGraph[32], *qdcGraph[32];
+  for (int j = 0; j < 32; j++) {
+    rateGraph[j] = new TGraphErrors();
+    rateGraph[j]->SetName(TString::Format("rate_p%i",j));
+    qdcGraph[j] = new TGraphErrors();
+    qdcGraph[j]->SetName(TString::Format("ledQDC_p%i",j));
+  }
+  PanelMonitor *mon = NULL;
+  int prevRun = -1;
+  double duration = 0;
+  auto finishRun = [&]() {
+    if (mon == NULL) return;
+    mon->SetDuration(duration);
+    vector<int> badRate = mon->FlagRate(3.0), badQDC = mon->FlagLEDQDC(3.0);
+    for (int j = 0; j < 32; j++) {
+      int n = rateGraph[j]->GetN();
+      rateGraph[j]->SetPoint(n, prevRun, mon->GetRate(j));
+      rateGraph[j]->SetPointError(n, 0, (duration > 0) ? sqrt(mon->GetHits(j))/duration : 0);
+      n = qdcGraph[j]->GetN();
+      qdcGraph[j]->SetPoint(n, prevRun, mon->GetLEDQDC(j).mean);
+      qdcGraph[j]->SetPointError(n, 0, mon->GetLEDQDC(j).Sigma());
+    }
+    if (!badRate.empty() || !badQDC.empty()) {
+      cout << "Run " << prevRun << " panels off by > 3 sigma.  Hit rate:";
+      for (auto j : badRate) cout << " " << j;
+      cout << "  LED QDC:";
+      for (auto j : badQDC) cout << " " << j;
+      cout << endl;
+    }
+    delete mon;
+    mon = NULL;
+  };
 
   while(reader.Next())
   {
-    // long i = reader.GetCurrentEntry();
-    MJVetoEvent veto = *events;
-
-    // Count number of non-LED panel hits
-    // for (int j = 0; j < 32; j++)
-      // if (veto.GetQDC(j) > veto.GetSWThresh(j) && veto.GetMultip() <= LEDSimpleThreshold)
-        // nonLEDHitCount[j]++;
+    if (*runIn != prevRun) {
+      finishRun();
+      prevRun = *runIn;
+      mon = new PanelMonitor(prevRun);
+    }
+    duration = *durationIn;
+    MJVetoEvent veto = *vetoEventIn;
+    mon->Fill(veto, *xTime, veto.GetMultip() > *ledThreshIn);
   }
+  finishRun();
 
-  // the goal is to evaluate this line::
-  // PanelInfo(runNum,j,"hitRateMean") - nonLEDHitCount[j]/unixDuration)
-
-  // Open up an already existing file and add points to its graph.
-  // If the file doesn't exist, create it.
-
-  // TFile *rateFile = new TFile("./output/rateData.root","UPDATE");
-  // TGraph *g = (TGraph*)rateFile->Get("rateGraph");
-  // g->AddPoint(your_point)
-  // g->Write("",TObject::kOverwrite);
-
+  TFile *rateFile = new TFile("./output/rateData.root","RECREATE");
+  for (int j = 0; j < 32; j++) {
+    rateGraph[j]->Write("",TObject::kOverwrite);
+    qdcGraph[j]->Write("",TObject::kOverwrite);
+  }
+  rateFile->Close();
+  cout << "Wrote ./output/rateData.root\n";
 }
 
 void LEDPlots()
@@ -582,8 +514,7 @@ void LEDPlots()
   int dsNum = 5; // user only has to change this number
 
   GATDataSet ds;
-  map<int,int> dsMap = {{0,76},{1,51},{3,24},{5,46}}; // from DataSetInfo.hh
-  for (int i = 0; i <= dsMap.at(dsNum); i++) LoadDataSet(ds,dsNum,i);
+  for (int i = 0; i < GetNRunSeqs(dsNum); i++) LoadDataSet(ds,dsNum,i);
   TChain *v = ds.GetVetoChain();
   TTreeReader reader(v);
   TTreeReaderValue<MJVetoEvent> vetoEventIn(reader,"vetoEvent");
@@ -702,7 +633,6 @@ void MuonTimeUncertainty()
   gROOT->ProcessLine(".x ~/env/MJDClintPlotStyle.C");
 
   int dsNum = 3; // user only has to change this number
-  map<int,int> dsMap = {{0,76},{1,51},{3,24},{5,46}}; // from DataSetInfo.hh
 
   vector<int> muRuns;
   vector<int> muTypes;
@@ -712,7 +642,7 @@ void MuonTimeUncertainty()
   if (dsNum != 4)
   {
     GATDataSet ds;
-    for (int i = 0; i <= dsMap.at(dsNum); i++) LoadDataSet(ds,dsNum,i);
+    for (int i = 0; i < GetNRunSeqs(dsNum); i++) LoadDataSet(ds,dsNum,i);
     TChain *v = ds.GetVetoChain();
     TTreeReader vetoReader(v);
     TTreeReaderValue<MJVetoEvent> vetoEventIn(vetoReader,"vetoEvent");
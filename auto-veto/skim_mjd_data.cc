@@ -26,6 +26,11 @@
 #include "MJVetoEvent.hh"
 
 #include "DataSetInfo.hh"
+#include "LNFillTimes.hh"
+#include "Livetime.hh"
+#include "Provenance.hh"
+#include "SkimPrefilter.hh"
+#include "ReaderSetup.hh"
 
 using namespace std;
 using namespace CLHEP;
@@ -34,8 +39,6 @@ void LoadDataSet(GATDataSet& ds, int dsNumber, size_t iRunSeq);
 void LoadRun(GATDataSet& ds, size_t iRunSeq);
 void LoadActiveMasses(map<int,double>& activeMassForDetID_g, int dsNumber);
 double GetAvsE(int channel, double TSCurrent50nsMax, double TSCurrent100nsMax, double TSCurrent200nsMax, double trapENF, double trapENFCal, int dsNumber);
-void LoadLNFillTimes1(vector<double>& lnFillTimes1, int dsNumber);
-void LoadLNFillTimes2(vector<double>& lnFillTimes2, int dsNumber);
 double GetDCRraw(int channel, double nlcblrwfSlope, double trapMax, int dsNumber);
 double GetDCR85(int channel, double nlcblrwfSlope, double trapMax, int dsNumber);
 double GetDCR90(int channel, double nlcblrwfSlope, double trapMax, int dsNumber);
@@ -46,11 +49,14 @@ double GetDCRCTC(int channel, double nlcblrwfSlope, double trapE, double trapMax
 
 int main(int argc, const char** argv)
 {
-  if(argc < 3 || argc > 9) {
+  if(argc < 3 || argc > 13) {
     cout << "To include tail slope add flag -s. For raw DCR add flag -r " << endl;
     cout << "For minimal skim file add flag -m " << endl;
     cout << "For extensive skim file (multiple DCR and aenorm) add flag -e " << endl;
     cout << "For custom energy threshold: -t [number (default is 2 keV)]" << endl;
+    cout << "To skip outputs whose inputs and settings haven't changed: --only-stale" << endl;
+    cout << "To force two-phase reads on or off: --prefilter, --no-prefilter (default: on for the -m skim)" << endl;
+    cout << "To print read calls & cache efficiency: --io-stats.  For async prefetching: --prefetch" << endl;
     cout << "Usage for single run: " << argv[0] << " -f [runNum] (output path)" << endl;
     cout << "Usage for custom file: " << argv[0] << " --filename [filename] [runNum] (output path)" << endl;
     cout << "Usage for data sets: " << argv[0] << " [dataset number] [runseq] (output path)" << endl;
@@ -71,6 +77,7 @@ int main(int argc, const char** argv)
   bool smallOutput = false;
   bool extendedOutput = false;
   bool simulatedInput = false;
+  bool onlyStale = false;
   vector<string> args;
   for(int iArg=0; iArg<argc; ++iArg) args.push_back(argv[iArg]);
 
@@ -98,6 +105,32 @@ int main(int argc, const char** argv)
     cout<<"Extended skim file option selected."<<endl;
     args.erase(extendedOutputArg);
   }
+  int prefilterArg = -1;  // -1: decide from the thresholds
+  auto prefilterOnArg = find(args.begin(), args.end(), "--prefilter");
+  if(prefilterOnArg!=args.end()){
+    prefilterArg = 1;
+    args.erase(prefilterOnArg);
+  }
+  auto prefilterOffArg = find(args.begin(), args.end(), "--no-prefilter");
+  if(prefilterOffArg!=args.end()){
+    prefilterArg = 0;
+    args.erase(prefilterOffArg);
+  }
+  auto ioStatsArg = find(args.begin(), args.end(), "--io-stats");
+  if(ioStatsArg!=args.end()){
+    ReaderSetup::IOStats() = true;
+    args.erase(ioStatsArg);
+  }
+  auto prefetchArg = find(args.begin(), args.end(), "--prefetch");
+  if(prefetchArg!=args.end()){
+    ReaderSetup::SetPrefetch(true);
+    args.erase(prefetchArg);
+  }
+  auto onlyStaleArg = find(args.begin(), args.end(), "--only-stale");
+  if(onlyStaleArg!=args.end()){
+    onlyStale = true;
+    args.erase(onlyStaleArg);
+  }
   auto energyThreshArg = find(args.begin(), args.end(), "-t");
   if(energyThreshArg!=args.end()){
     int pos = find(args.begin(), args.end(), "-t") - args.begin();
@@ -186,8 +219,45 @@ int main(int argc, const char** argv)
 
   if(args.size() > 1) outputPath += args[1];
 
+  // output file name
+  string filename = TString::Format("skimDS%d_", dsNumber).Data();
+  char runStr[10];
+  sprintf(runStr, "%d", runSeq);
+  if(singleFile) filename += "run";
+  filename += runStr;
+  if(writeSlope) filename += "_slope";
+  if(writeRawDCR) filename += "_rawDCR";
+  if(smallOutput) filename += "_small";
+  if(extendedOutput) filename += "_ext";
+  filename += ".root";
+  if(outputPath != "") filename = outputPath + "/" + filename;
+
   // set up dataset
   if(gatChain==NULL) gatChain = ds.GetGatifiedChain(false);
+  if(vetoChain==NULL) vetoChain = ds.GetVetoChain();
+
+  // Provenance: every input file, and the settings that change the skim file.
+  Manifest manifest("skim_mjd_data", string(MJDVETO_VERSION) + "-gat" + GATUtils::GetGATRevision()), prevManifest;
+  manifest.AddInputs(gatChain);
+  if(dsNumber == 4) {
+    manifest.AddInput("./runs/ds4-muonList.txt");
+    manifest.AddInput(RunCatalog::DefaultFile());
+  }
+  else manifest.AddInputs(vetoChain);
+  manifest.AddParam("energyThresh", energyThresh);
+  manifest.AddParam("writeSlope", writeSlope);
+  manifest.AddParam("writeRawDCR", writeRawDCR);
+  manifest.AddParam("smallOutput", smallOutput);
+  manifest.AddParam("extendedOutput", extendedOutput);
+  bool havePrev = prevManifest.Load(Manifest::FileName(filename));
+  if(onlyStale) {
+    string why;
+    if(manifest.IsUpToDate(filename, why)) {
+      cout << filename << " is up to date.  Skipping ..." << endl;
+      return 0;
+    }
+    cout << filename << " is stale: " << why << endl;
+  }
   TTreeReader gatReader(gatChain);
 
   // set up input chain value readers
@@ -316,17 +386,6 @@ int main(int argc, const char** argv)
 
 
   // set up output file and tree
-  string filename = TString::Format("skimDS%d_", dsNumber).Data();
-  char runStr[10];
-  sprintf(runStr, "%d", runSeq);
-  if(singleFile) filename += "run";
-  filename += runStr;
-  if(writeSlope) filename += "_slope";
-  if(writeRawDCR) filename += "_rawDCR";
-  if(smallOutput) filename += "_small";
-  if(extendedOutput) filename += "_ext";
-  filename += ".root";
-  if(outputPath != "") filename = outputPath + "/" + filename;
   TFile *fOut = TFile::Open(filename.c_str(), "recreate");
   TTree* skimTree = new TTree("skimTree", "skimTree");
 
@@ -654,6 +713,13 @@ int main(int argc, const char** argv)
     detIDIsVetoOnly[1427120] = true;
   }
 
+  // Two-phase reads: only events with a hit over the cut are read in full (SkimPrefilter.hh)
+  SkimPrefilter prefilter(smallOutput ? 200. : energyThresh, smallOutput ? 200. : 10.);
+  bool usePrefilter = !simulatedInput && (prefilterArg == -1 ? prefilter.IsRecommended() : prefilterArg == 1);
+  ReaderSetup gatIO(gatChain, "gatChain");
+  if(usePrefilter) gatIO.SetBranches(SkimPrefilter::Phase1Branches());
+  gatIO.Apply();
+
   // start loop over all events
   while(gatReader.Next()) {
 
@@ -668,6 +734,9 @@ int main(int argc, const char** argv)
 
     // Skip this event if it is a pulser event as identified by Pinghan
     if(*eventDC1BitsIn & kPinghanPulserMask) continue;
+
+    // Phase 1: skip the event unless some hit can pass the energy cut
+    if(usePrefilter && !prefilter.Pass(*channelIn, *trapENFCalIn, *trapECalIn)) continue;
     iEvent = gatChain->GetTree()->GetReadEntry();
 
     // copy the event-level info to the output fields
@@ -752,15 +821,15 @@ int main(int argc, const char** argv)
       // skip all hits with E_H < 2 keV, E_L < 10 keV in -both- trapE and trapENF
       // For small skim files, skip all hits with E_H and E_L < 200 keV in trapE and trapENF
       double hitENFCal = (*trapENFCalIn)[i];
-      double hitENMCal = (*trapENMCalIn)[i];
-      double hitENF = (*trapENFIn)[i];
       double hitEMax = (*trapECalIn)[i];
-      double hitTrapMax = hitENMCal;
       int hitCh = (*channelIn)[i];
       if(!smallOutput && hitCh%2 == 0 && hitENFCal < energyThresh && hitEMax < energyThresh) continue;
       if(!smallOutput && hitCh%2 == 1 && hitENFCal < 10. && hitEMax < 10.) continue;
       if(smallOutput && hitCh%2 == 0 && hitENFCal <  200. && hitEMax < 200.) continue;
       if(smallOutput && hitCh%2 == 1 && hitENFCal < 200. && hitEMax < 200.) continue;
+      double hitENMCal = (*trapENMCalIn)[i];  // (read after the cut, so dropped hits don't load them)
+      double hitENF = (*trapENFIn)[i];
+      double hitTrapMax = hitENMCal;
       // skip hits from totally "bad" detectors (not biased, etc), or from
       // use-for-veto-only detectors if E < 10 keV
       int hitDetID = (*detIDIn)[i];
@@ -863,11 +932,8 @@ int main(int argc, const char** argv)
         else
           dtmu = (hitT_s - muTimes[iMu]);
 
-        bool vetoThisHit = (dtmu > -1.*(muUncert[iMu]) && dtmu < (1. + muUncert[iMu]));
-
-        // DS-4 requires a larger window due to synchronization issues.
-        if (dsNumber==4)
-          vetoThisHit = (dtmu > -3.*(muUncert[iMu]) && dtmu < (4. + muUncert[iMu]));
+        // Same window that ds_livetime uses (see Livetime.hh)
+        bool vetoThisHit = InMuonVetoWindow(dsNumber, dtmu, muUncert[iMu]);
 
         // if (vetoThisHit) printf("Coin: iMu %-4lu  det %i  gRun %-4i  mRun %-5i  tGe %-7.3f  tMu %-7.3f  ene %-6.0f  veto? %i  dtmu %.2f +/- %.2f\n", iMu,hitCh,run,muRuns[iMu],hitT_s,muTimes[iMu],hitENFCal,vetoThisHit,dtmu,muUncert[iMu]);
 
@@ -878,20 +944,8 @@ int main(int argc, const char** argv)
 
         // tag LN fills
         double utctime = startTime + hitT_s;
-        isLNFill1.push_back(false);
-        isLNFill2.push_back(false);
-        for(size_t i=0; i<lnFillTimes1.size(); i++) {
-          if(lnFillTimes1[i]+300 < utctime) continue;
-          if(lnFillTimes1[i]-900 > utctime) break;
-          isLNFill1[isLNFill1.size()-1] = true;
-          break;
-        for(size_t i=0; i<lnFillTimes2.size(); i++) {
-          if(lnFillTimes2[i]+300 < utctime) continue;
-          if(lnFillTimes2[i]-900 > utctime) break;
-          isLNFill2[isLNFill2.size()-1] = true;
-          break;
-        }
-        }
+        isLNFill1.push_back(InLNFillWindow(lnFillTimes1, utctime));
+        isLNFill2.push_back(InLNFillWindow(lnFillTimes2, utctime));
       }
     }
 
@@ -906,10 +960,14 @@ int main(int argc, const char** argv)
     skimTree->Fill();
   }
 
+  if(usePrefilter) prefilter.Print();
+  gatIO.Finish();
+
   // write output tree to output file
   cout << "Closing out skim file..." << endl;
   skimTree->Write("", TObject::kOverwrite);
   fOut->Close();
+  manifest.Save(Manifest::FileName(filename), havePrev ? &prevManifest : NULL);
   return 0;
 }
 
@@ -1164,224 +1222,6 @@ double GetAvsE(int channel, double TSCurrent50nsMax, double TSCurrent100nsMax, d
   return 0.0;
 }
 
-void LoadLNFillTimes1(vector<double>& lnFillTimes1, int dsNumber)
-{
-  // we don't really need to make DS-specific lists, but look-up
-  // time is shorter if the lists are shorter.
-
-  if(dsNumber == 0) {
-    lnFillTimes1.push_back(1435870160);
-    lnFillTimes1.push_back(1436020533);
-    lnFillTimes1.push_back(1436168622);
-    lnFillTimes1.push_back(1436316362);
-    lnFillTimes1.push_back(1436463827);
-    lnFillTimes1.push_back(1436614832);
-    lnFillTimes1.push_back(1436759402);
-    lnFillTimes1.push_back(1436908966);
-    lnFillTimes1.push_back(1437058884);
-    lnFillTimes1.push_back(1437060687);
-    lnFillTimes1.push_back(1437204895);
-    lnFillTimes1.push_back(1437350621);
-    lnFillTimes1.push_back(1437638022);
-    lnFillTimes1.push_back(1437781652);
-    lnFillTimes1.push_back(1437926383);
-    lnFillTimes1.push_back(1438070819);
-    lnFillTimes1.push_back(1438121812);
-    lnFillTimes1.push_back(1438212611);
-    lnFillTimes1.push_back(1438352837);
-    lnFillTimes1.push_back(1438496004);
-    lnFillTimes1.push_back(1438639835);
-    lnFillTimes1.push_back(1438782282);
-    lnFillTimes1.push_back(1438932169);
-    lnFillTimes1.push_back(1439080850);
-    lnFillTimes1.push_back(1439226624);
-    lnFillTimes1.push_back(1439371591);
-    lnFillTimes1.push_back(1439514291);
-    lnFillTimes1.push_back(1439657247);
-    lnFillTimes1.push_back(1439801649);
-    lnFillTimes1.push_back(1439944622);
-    lnFillTimes1.push_back(1440080091);
-    lnFillTimes1.push_back(1440192295);
-    lnFillTimes1.push_back(1440335863);
-    lnFillTimes1.push_back(1440477294);
-    lnFillTimes1.push_back(1440618411);
-    lnFillTimes1.push_back(1440759782);
-    lnFillTimes1.push_back(1440902658);
-    lnFillTimes1.push_back(1441046730);
-    lnFillTimes1.push_back(1441187019);
-    lnFillTimes1.push_back(1441325878);
-    lnFillTimes1.push_back(1441462000);
-    lnFillTimes1.push_back(1441600116);
-    lnFillTimes1.push_back(1441741779);
-    lnFillTimes1.push_back(1441883940);
-    lnFillTimes1.push_back(1442027368);
-    lnFillTimes1.push_back(1442169713);
-    lnFillTimes1.push_back(1442312599);
-    lnFillTimes1.push_back(1442453920);
-    lnFillTimes1.push_back(1442595578);
-    lnFillTimes1.push_back(1442737259);
-    lnFillTimes1.push_back(1442879000);
-    lnFillTimes1.push_back(1443021647);
-  }
-
-  if(dsNumber == 1) {
-    lnFillTimes1.push_back(1452519860);
-    lnFillTimes1.push_back(1452655867);
-    lnFillTimes1.push_back(1452791415);
-    lnFillTimes1.push_back(1453541032);
-    lnFillTimes1.push_back(1453670314);
-    lnFillTimes1.push_back(1453800137);
-    lnFillTimes1.push_back(1453929779);
-    lnFillTimes1.push_back(1453937178);
-    lnFillTimes1.push_back(1453998125);
-    lnFillTimes1.push_back(1454000591);
-    lnFillTimes1.push_back(1454002456);
-    lnFillTimes1.push_back(1454014971);
-    lnFillTimes1.push_back(1454107981);
-    lnFillTimes1.push_back(1454219392);
-    lnFillTimes1.push_back(1454332307);
-    lnFillTimes1.push_back(1454447212);
-    lnFillTimes1.push_back(1454559953);
-    lnFillTimes1.push_back(1454679496);
-    lnFillTimes1.push_back(1454769079);
-    lnFillTimes1.push_back(1454882301);
-    lnFillTimes1.push_back(1454946492);
-    lnFillTimes1.push_back(1454951907);
-    lnFillTimes1.push_back(1454954012);
-    lnFillTimes1.push_back(1454955958);
-    lnFillTimes1.push_back(1455225161);
-    lnFillTimes1.push_back(1455228289);
-    lnFillTimes1.push_back(1455440690);
-    lnFillTimes1.push_back(1455568585);
-    lnFillTimes1.push_back(1455696789);
-    lnFillTimes1.push_back(1455822149);
-    lnFillTimes1.push_back(1455952573);
-    lnFillTimes1.push_back(1456082166);
-    lnFillTimes1.push_back(1456206057);
-    lnFillTimes1.push_back(1456333236);
-    lnFillTimes1.push_back(1456460237);
-    lnFillTimes1.push_back(1456588495);
-    lnFillTimes1.push_back(1456717776);
-    lnFillTimes1.push_back(1456846882);
-    lnFillTimes1.push_back(1456943983);
-    lnFillTimes1.push_back(1456981934);
-    lnFillTimes1.push_back(1457110918);
-    lnFillTimes1.push_back(1457238098);
-    lnFillTimes1.push_back(1457365179);
-    lnFillTimes1.push_back(1457491997);
-    lnFillTimes1.push_back(1457619662);
-    lnFillTimes1.push_back(1457747884);
-    lnFillTimes1.push_back(1457874684);
-    lnFillTimes1.push_back(1458001143);
-    lnFillTimes1.push_back(1458130495);
-    lnFillTimes1.push_back(1458259402);
-    lnFillTimes1.push_back(1458387930);
-    lnFillTimes1.push_back(1458515657);
-    lnFillTimes1.push_back(1458639685);
-    lnFillTimes1.push_back(1458767518);
-    lnFillTimes1.push_back(1458896260);
-    lnFillTimes1.push_back(1459023862);
-    lnFillTimes1.push_back(1459150863);
-    lnFillTimes1.push_back(1459275989);
-    lnFillTimes1.push_back(1459402548);
-    lnFillTimes1.push_back(1459529663);
-    lnFillTimes1.push_back(1459654930);
-    lnFillTimes1.push_back(1459785212);
-    lnFillTimes1.push_back(1459912507);
-    lnFillTimes1.push_back(1460042708);
-    lnFillTimes1.push_back(1460169429);
-    lnFillTimes1.push_back(1460297779);
-    lnFillTimes1.push_back(1460426527);
-    lnFillTimes1.push_back(1460552742);
-    lnFillTimes1.push_back(1460678641);
-    lnFillTimes1.push_back(1460808916);
-    lnFillTimes1.push_back(1460939150);
-    lnFillTimes1.push_back(1461064619);
-    lnFillTimes1.push_back(1461189868);
-    lnFillTimes1.push_back(1461318559);
-    lnFillTimes1.push_back(1461443967);
-    lnFillTimes1.push_back(1461569658);
-    lnFillTimes1.push_back(1461695992);
-    lnFillTimes1.push_back(1461824752);
-    lnFillTimes1.push_back(1461952713);
-    lnFillTimes1.push_back(1462258909);
-    lnFillTimes1.push_back(1462314666);
-    lnFillTimes1.push_back(1462371538);
-    lnFillTimes1.push_back(1462426019);
-    lnFillTimes1.push_back(1462462316);
-    lnFillTimes1.push_back(1462588708);
-    lnFillTimes1.push_back(1462715136);
-    lnFillTimes1.push_back(1462840823);
-    lnFillTimes1.push_back(1462966744);
-    lnFillTimes1.push_back(1463093301);
-    lnFillTimes1.push_back(1463220332);
-    lnFillTimes1.push_back(1463346237);
-    lnFillTimes1.push_back(1463472892);
-    lnFillTimes1.push_back(1463599111);
-    lnFillTimes1.push_back(1463694217);
-  }
-
-   if(dsNumber == 3) {
-   //M1
-    lnFillTimes1.push_back(1472129474);
-    lnFillTimes1.push_back(1472268007);
-    lnFillTimes1.push_back(1472404916);
-    lnFillTimes1.push_back(1472545253);
-    lnFillTimes1.push_back(1472683456);
-    lnFillTimes1.push_back(1472822134);
-    lnFillTimes1.push_back(1472961379);
-    lnFillTimes1.push_back(1473096880);
-    lnFillTimes1.push_back(1473236517);
-    lnFillTimes1.push_back(1473369324);
-    lnFillTimes1.push_back(1473510316);
-    lnFillTimes1.push_back(1473635684);
-    lnFillTimes1.push_back(1473771858);
-    lnFillTimes1.push_back(1473909355);
-    lnFillTimes1.push_back(1474045268);
-    lnFillTimes1.push_back(1474182801);
-    lnFillTimes1.push_back(1474319605);
-    lnFillTimes1.push_back(1474457662);
-    lnFillTimes1.push_back(1474569273);
-    lnFillTimes1.push_back(1474705001);
-    lnFillTimes1.push_back(1474842466);
-    lnFillTimes1.push_back(1474977413);
-   }
-}
-   void LoadLNFillTimes2(vector<double>& lnFillTimes2, int dsNumber)
-   {
-    if(dsNumber == 4) {
-    //M2
-    lnFillTimes2.push_back(1472057495);
-    lnFillTimes2.push_back(1472169344);
-    lnFillTimes2.push_back(1472283139);
-    lnFillTimes2.push_back(1472392397);
-    lnFillTimes2.push_back(1472508671);
-    lnFillTimes2.push_back(1472626749);
-    lnFillTimes2.push_back(1472749055);
-    lnFillTimes2.push_back(1472848201);
-    lnFillTimes2.push_back(1472959270);
-    lnFillTimes2.push_back(1473069251);
-    lnFillTimes2.push_back(1473180721);
-    lnFillTimes2.push_back(1473291137);
-    lnFillTimes2.push_back(1473369625);
-    lnFillTimes2.push_back(1473485389);
-    lnFillTimes2.push_back(1473594355);
-    lnFillTimes2.push_back(1473702993);
-    lnFillTimes2.push_back(1473815615);
-    lnFillTimes2.push_back(1473926807);
-    lnFillTimes2.push_back(1474040572);
-    lnFillTimes2.push_back(1474150140);
-    lnFillTimes2.push_back(1474260642);
-    lnFillTimes2.push_back(1474370902);
-    lnFillTimes2.push_back(1474482449);
-    lnFillTimes2.push_back(1474569695);
-    lnFillTimes2.push_back(1474679736);
-    lnFillTimes2.push_back(1474789636);
-    lnFillTimes2.push_back(1474901605);
-    lnFillTimes2.push_back(1475011276);
-  }
-}
-
 double GetDCRraw(int channel, double nlcblrwfSlope, double trapMax, int dsNumber)
 {
   if(dsNumber == 0) {
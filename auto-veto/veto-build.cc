@@ -0,0 +1,160 @@
+// veto-build.cc
+// Runs the veto event builder (VetoEventBuilder.hh) over a run and counts the events it
+// recovers from buffer flushes, or benchmarks it on a synthetic stream.
+// C. Wiseman, USC/Majorana
+//
+// The synthetic stream has one VetoTree entry per event.  A fraction of the events (-p)
+// are split: their second QDC card arrives 1 to d entries later (-d), as in a buffer
+// flush.  Card 2's EventCount can be off from card 1's (-x, error 12), and the cards'
+// counters can reset separately (-r: card 1 halfway through, card 2 a tenth later).
+// Every built event is checked against the QDC values that were put in.
+//
+// Only the synthetic stream has been checked so far: compare veto-build on a real run
+// with error 25 entries against CheckErrors before relying on the recovered events.
+//
+// Usage: ./veto-build [run] (-f [file]) (-n [depth])
+//        ./veto-build -b [events] (-p [split fraction]) (-d [max delay]) (-n [depth]) (-x [offset]) (-r)
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include "TChain.h"
+#include "TRandom3.h"
+#include "TStopwatch.h"
+#include "MGTBasicEvent.hh"
+#include "GATDataSet.hh"
+#include "VetoEventBuilder.hh"
+#include "VetoFiles.hh"
+
+using namespace std;
+
+void BuildRun(int run, string path, size_t depth);
+void Benchmark(long nEvents, double splitFrac, int maxDelay, size_t depth, long offset, bool reset);
+
+int main(int argc, char** argv)
+{
+  if (argc < 2) {
+    cout << "Usage: ./veto-build [run]\n"
+         << "                    [-f [file] (default: veto-extract file, or the built file)]\n"
+         << "                    [-n [depth] (reorder buffer, in events.  default 16)]\n"
+         << "       ./veto-build -b [events] (synthetic stream benchmark)\n"
+         << "                    [-p [fraction] (events split by a flush, default 0.01)]\n"
+         << "                    [-d [entries] (max delay of a split card, default 8)]\n"
+         << "                    [-x [offset] (card 2's EventCount - card 1's, default 0)]\n"
+         << "                    [-r (reset card 1's EventCount halfway through, and card 2's a bit later)]\n";
+    return 1;
+  }
+  string opt1 = argv[1];
+  bool bench = (opt1 == "-b");
+  long nEvents = 1000000;
+  int run = 0;
+  if (bench && argc > 2) nEvents = stol(argv[2]);
+  if (!bench) run = stoi(argv[1]);
+  string path = "";
+  size_t depth = 16;
+  double splitFrac = 0.01;
+  int maxDelay = 8;
+  long offset = 0;
+  bool reset = false;
+  for (int i = 2; i < argc; i++) {
+    string opt = argv[i];
+    if (opt == "-f" && i+1 < argc) path = argv[++i];
+    else if (opt == "-n" && i+1 < argc) depth = stoul(argv[++i]);
+    else if (opt == "-p" && i+1 < argc) splitFrac = stod(argv[++i]);
+    else if (opt == "-d" && i+1 < argc) maxDelay = stoi(argv[++i]);
+    else if (opt == "-x" && i+1 < argc) offset = stol(argv[++i]);
+    else if (opt == "-r") reset = true;
+  }
+  if (bench) Benchmark(nEvents, splitFrac, maxDelay, depth, offset, reset);
+  else BuildRun(run, path, depth);
+  return 0;
+}
+
+void BuildRun(int run, string path, size_t depth)
+{
+  GATDataSet ds;
+  if (path == "") path = GetExtractedVetoPath(run);
+  if (path == "") path = ds.GetPathToRun(run,GATDataSet::kBuilt);
+  TChain *vetoChain = new TChain("VetoTree");
+  if (!vetoChain->Add(path.c_str()) || vetoChain->GetEntries() < 1) { cout << "No veto data in " << path << endl; return; }
+  long vEntries = vetoChain->GetEntries();
+  vetoChain->SetBranchStatus("*",0);
+  vetoChain->SetBranchStatus("vetoEvent*",1);
+  MGTBasicEvent *evt = NULL;
+  vetoChain->SetBranchAddress("vetoEvent",&evt);
+  printf("Run %i: building %li entries of %s\n", run, vEntries, path.c_str());
+
+  VetoEventBuilder builder(run, depth);
+  BuiltVetoEvent e;
+  long nOut = 0;
+  TStopwatch timer;
+  timer.Start();
+  for (long i = 0; i < vEntries; i++)
+  {
+    vetoChain->GetEntry(i);
+    builder.AddEvent(i, evt);
+    while (builder.Next(e)) {
+      nOut++;
+      if (e.status != kBuilt)
+        printf("  EventCount %-8u %-8u entries %li-%li  %s (%i channels)\n", e.eventCount[0], e.eventCount[1], e.firstEntry, e.lastEntry,
+          BuildStatusName(e.status), e.nChannels);
+    }
+  }
+  builder.Finish();
+  while (builder.Next(e)) nOut++;
+  timer.Stop();
+  builder.Print();
+  printf("Recovered %li events that CheckErrors skips (errors 1 & 25).  %.0f events/s (incl. reading)\n",
+    builder.GetNBuilt(kRecovered), (timer.RealTime() > 0) ? nOut/timer.RealTime() : 0);
+}
+
+// Recognizable QDC values for event k, to check the built events.
+int SynthQDC(long k, int panel) { return (k*37 + panel*101) % 4096; }
+
+void Benchmark(long nEvents, double splitFrac, int maxDelay, size_t depth, long offset, bool reset)
+{
+  const int card[2] = {13, 18};
+  const long resetAt[2] = {nEvents/2, nEvents/2 + nEvents/10};
+  TRandom3 rand(0);
+  vector<vector<VetoFragment> > entries(nEvents + maxDelay + 1);
+  long nSplit = 0;
+  for (long k = 0; k < nEvents; k++)
+  {
+    unsigned int ecs[2];
+    for (int c = 0; c < 2; c++)
+      ecs[c] = (reset && k >= resetAt[c]) ? k - resetAt[c] : k + ((c == 1) ? offset : 0);
+    bool split = (rand.Rndm() < splitFrac);
+    if (split) nSplit++;
+    for (int c = 0; c < 2; c++) {
+      long entry = (c == 1 && split) ? k + 1 + (long)rand.Integer(maxDelay > 0 ? maxDelay : 1) : k;
+      for (int ch = 0; ch < 16; ch++) {
+        VetoFragment f = {entry, card[c], ch, SynthQDC(k, 16*c+ch), false, false, 3*k+1+c, ecs[c], 3*k, k, (unsigned long long)(k*1E6), false};
+        entries[entry].push_back(f);
+      }
+    }
+  }
+  printf("Synthetic stream: %li events, %li split (delay 1-%i entries), card 2 EventCount offset %li, buffer depth %zu%s.\n",
+    nEvents, nSplit, maxDelay, offset, depth, reset ? ", separate EventCount resets" : "");
+
+  VetoEventBuilder builder(1, depth);
+  BuiltVetoEvent e;
+  long nOut = 0, nBadQDC = 0;
+  TStopwatch timer;
+  timer.Start();
+  for (auto &entry : entries) {
+    builder.AddEntry(entry);
+    while (builder.Next(e)) {
+      nOut++;
+      if (e.nChannels < 32) continue;
+      for (int j = 0; j < 32; j++) if (e.qdc[j] != SynthQDC(e.sec, j)) { nBadQDC++; break; }
+    }
+  }
+  builder.Finish();
+  while (builder.Next(e)) nOut++;
+  timer.Stop();
+  builder.Print();
+  printf("Recovered %li of %li split events.  %li events with wrong QDCs.\n", builder.GetNBuilt(kRecovered), nSplit, nBadQDC);
+  printf("%.2f s: %.3g events/s, %.3g records/s\n", timer.RealTime(),
+    (timer.RealTime() > 0) ? nOut/timer.RealTime() : 0, (timer.RealTime() > 0) ? builder.GetNFragments()/timer.RealTime() : 0);
+}
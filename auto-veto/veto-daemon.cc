@@ -0,0 +1,216 @@
+// veto-daemon.cc
+// Keeps auto-veto running over new data, instead of submitting run lists by hand
+// (auto-runlist.sh / auto-job.sh).
+// C. Wiseman, USC/Majorana
+//
+// Watches one or more directories of built files (OR_run*.root), and/or the runs
+// in a list, for files that are new or have changed.  A file is only taken once its
+// size and mtime are the same on two scans in a row, so runs still being written (or
+// copied in) aren't processed half-finished.  Each one goes into a
+// persistent work queue (WorkQueue.hh), and N worker threads run ./auto-veto on
+// them.  Each auto-veto is a separate process, since ROOT isn't thread-safe,
+// and its output goes to a per-run log file.  Runs whose veto_run file is newer
+// than their built file are skipped.  Failed runs are retried a few times.  Runs with
+// no veto data (auto-veto exits with WorkQueue::kExitNothingToDo) are marked skipped.
+//
+// Usage: ./veto-daemon -w [dir] (-w [dir2] ...) (-l [run list]) (-o [output dir])
+//          (-j [workers]) (-p [poll sec]) (-once) (-status) (-requeue)
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <cstdio>
+#include <cstdlib>
+#include <csignal>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include "GATDataSet.hh"
+#include "WorkQueue.hh"
+
+using namespace std;
+
+static atomic<bool> gStop(false);
+void HandleSignal(int) { gStop = true; }
+
+bool StatFile(string path, long long &size, long &mtime);
+string ShellQuote(string s);
+void ScanDirectory(string dir, vector<pair<int,string> > &runFiles);
+void ScanRunList(string listFile, vector<pair<int,string> > &runFiles);
+bool IsUpToDate(int run, long inputMTime, string outputDir);
+void Worker(int id, WorkQueue *queue, string outputDir, string logDir);
+
+int main(int argc, char** argv)
+{
+  if (argc < 2) {
+    cout << "Usage: ./veto-daemon -w [directory of built files] (can be given more than once)\n"
+         << "                     [-l [run list] (also watch these runs, wherever GATDataSet finds them)]\n"
+         << "                     [-o [directory] (auto-veto output, default ./avout)]\n"
+         << "                     [-q [file] (queue file, default [output dir]/vetoQueue.txt)]\n"
+         << "                     [-j [n] (worker threads, default 4)]\n"
+         << "                     [-p [sec] (time between directory scans, default 60)]\n"
+         << "                     [-once (process what's there now, then exit.  Scans twice, a poll apart)]\n"
+         << "                     [-status (print the queue and exit)]\n"
+         << "                     [-requeue (re-process everything in the queue)]\n";
+    return 1;
+  }
+  vector<string> watchDirs, runLists;
+  string outputDir = "./avout", queueFile = "";
+  int nWorkers = 4;
+  double pollSec = 60;
+  bool once = false, status = false, requeue = false;
+  for (int i = 1; i < argc; i++) {
+    string opt = argv[i];
+    if (opt == "-w" && i+1 < argc) watchDirs.push_back(argv[++i]);
+    else if (opt == "-l" && i+1 < argc) runLists.push_back(argv[++i]);
+    else if (opt == "-o" && i+1 < argc) outputDir = argv[++i];
+    else if (opt == "-q" && i+1 < argc) queueFile = argv[++i];
+    else if (opt == "-j" && i+1 < argc) nWorkers = stoi(argv[++i]);
+    else if (opt == "-p" && i+1 < argc) pollSec = stod(argv[++i]);
+    else if (opt == "-once") once = true;
+    else if (opt == "-status") status = true;
+    else if (opt == "-requeue") requeue = true;
+    else { cout << "Unknown option: " << opt << endl; return 1; }
+  }
+  if (queueFile == "") queueFile = outputDir + "/vetoQueue.txt";
+  string logDir = outputDir + "/logs";
+  mkdir(outputDir.c_str(), 0755);
+  mkdir(logDir.c_str(), 0755);
+
+  WorkQueue queue(queueFile);
+  queue.Load();
+  if (status) { queue.Print(); return 0; }
+  if (requeue) queue.RequeueAll();
+
+  signal(SIGINT, HandleSignal);
+  signal(SIGTERM, HandleSignal);
+
+  printf("veto-daemon: %i workers, output in %s, queue in %s\n", nWorkers, outputDir.c_str(), queueFile.c_str());
+  vector<thread> workers;
+  for (int i = 0; i < nWorkers; i++)
+    workers.push_back(thread(Worker, i, &queue, outputDir, logDir));
+
+  map<string, pair<long long,long> > lastScan;   // size & mtime of each file on the previous scan
+  int nScans = 0;
+  while (!gStop)
+  {
+    vector<pair<int,string> > runFiles;
+    for (auto &dir : watchDirs) ScanDirectory(dir, runFiles);
+    for (auto &list : runLists) ScanRunList(list, runFiles);
+
+    int nNew = 0, nChanging = 0;
+    map<string, pair<long long,long> > thisScan;
+    for (auto &rf : runFiles) {
+      long long size;
+      long mtime;
+      if (!StatFile(rf.second, size, mtime)) continue;
+      thisScan[rf.second] = make_pair(size, mtime);
+      if (IsUpToDate(rf.first, mtime, outputDir)) continue;
+      auto prev = lastScan.find(rf.second);
+      if (prev == lastScan.end() || prev->second != thisScan[rf.second]) { nChanging++; continue; }
+      if (queue.Enqueue(rf.first, rf.second, size, mtime)) nNew++;
+    }
+    lastScan.swap(thisScan);
+    nScans++;
+    if (nNew > 0) printf("Queued %i runs.  %lu waiting, %lu running, %lu done, %lu skipped, %lu failed.\n", nNew,
+      queue.Count(WorkQueue::kQueued), queue.Count(WorkQueue::kRunning), queue.Count(WorkQueue::kDone),
+      queue.Count(WorkQueue::kSkipped), queue.Count(WorkQueue::kFailed));
+
+    if (once && nScans >= 2) {
+      if (nChanging > 0) printf("Skipped %i runs that are still being written.\n", nChanging);
+      while (!gStop && !queue.IsIdle()) this_thread::sleep_for(chrono::seconds(1));
+      break;
+    }
+    // sleep in short steps, so a signal doesn't have to wait out the whole poll
+    for (double t = 0; t < pollSec && !gStop; t += 0.5)
+      this_thread::sleep_for(chrono::milliseconds(500));
+  }
+  gStop = true;
+  for (auto &w : workers) w.join();
+  printf("veto-daemon: done.  %lu done, %lu skipped, %lu failed, %lu still queued.\n",
+    queue.Count(WorkQueue::kDone), queue.Count(WorkQueue::kSkipped), queue.Count(WorkQueue::kFailed), queue.Count(WorkQueue::kQueued));
+  return 0;
+}
+
+bool StatFile(string path, long long &size, long &mtime)
+{
+  struct stat st;
+  if (path == "" || stat(path.c_str(), &st) != 0) return false;
+  size = (long long)st.st_size;
+  mtime = (long)st.st_mtime;
+  return true;
+}
+
+// Single quotes, so paths with spaces or shell characters are passed as they are.
+string ShellQuote(string s)
+{
+  string q = "'";
+  for (char c : s) q += (c == '\'') ? string("'\\''") : string(1, c);
+  return q + "'";
+}
+
+void ScanDirectory(string dir, vector<pair<int,string> > &runFiles)
+{
+  // Built files are named OR_run[run].root
+  DIR *d = opendir(dir.c_str());
+  if (d == NULL) { cout << "Couldn't open directory " << dir << endl; return; }
+  struct dirent *ent;
+  while ((ent = readdir(d)) != NULL) {
+    int run = 0;
+    char tail[10] = "";
+    if (sscanf(ent->d_name, "OR_run%d.%5s", &run, tail) == 2 && string(tail) == "root")
+      runFiles.push_back(make_pair(run, dir + "/" + ent->d_name));
+  }
+  closedir(d);
+}
+
+void ScanRunList(string listFile, vector<pair<int,string> > &runFiles)
+{
+  ifstream runList(listFile.c_str());
+  if (!runList.good()) { cout << "Couldn't open " << listFile << endl; return; }
+  GATDataSet ds;
+  int run;
+  while (runList >> run) {
+    string path = ds.GetPathToRun(run,GATDataSet::kBuilt);
+    if (path != "") runFiles.push_back(make_pair(run, path));
+  }
+}
+
+bool IsUpToDate(int run, long inputMTime, string outputDir)
+{
+  char outFile[500];
+  sprintf(outFile,"%s/veto_run%i.root",outputDir.c_str(),run);
+  long long size;
+  long mtime;
+  return (StatFile(outFile, size, mtime) && size > 0 && mtime >= inputMTime);
+}
+
+void Worker(int id, WorkQueue *queue, string outputDir, string logDir)
+{
+  while (!gStop)
+  {
+    WorkQueue::Job job;
+    if (!queue->Next(job)) {
+      this_thread::sleep_for(chrono::seconds(1));
+      continue;
+    }
+    string log = logDir + "/auto-veto_run" + to_string(job.run) + ".log";
+    string cmd = "./auto-veto " + to_string(job.run) + " -f " + ShellQuote(job.path) + " -o " + ShellQuote(outputDir)
+      + " > " + ShellQuote(log) + " 2>&1";
+    printf("[worker %i] run %i (attempt %i)\n", id, job.run, job.attempts);
+    int ret = system(cmd.c_str());
+    bool success = (ret == 0);
+    if (ret != -1 && WIFEXITED(ret)) ret = WEXITSTATUS(ret);
+    bool skipped = (!success && ret == WorkQueue::kExitNothingToDo);
+    queue->Finish(job.run, success, skipped);
+    if (skipped)
+      printf("[worker %i] run %i has no veto data.  Skipped.\n", id, job.run);
+    else if (!success)
+      printf("[worker %i] run %i failed (exit %i).  See %s/auto-veto_run%i.log\n", id, job.run, ret, logDir.c_str(), job.run);
+  }
+}
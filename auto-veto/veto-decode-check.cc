@@ -0,0 +1,135 @@
+// veto-decode-check.cc
+// Checks VetoDecoder (VetoDecoder.hh) against MJVetoEvent::WriteEvent, field by field
+// and bit for bit, and times both.  Run it on a few runs of each data set before
+// switching a reader to the decoder.
+// Usage: ./veto-decode-check [run] (-f [file]) (-n [entries]) (-v)
+// C. Wiseman, USC/Majorana
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include "TChain.h"
+#include "TTreeReader.h"
+#include "TTreeReaderValue.h"
+#include "TStopwatch.h"
+#include "MJVetoEvent.hh"
+#include "MGTEvent.hh"
+#include "GATDataSet.hh"
+#include "VetoDecoder.hh"
+#include "VetoFiles.hh"
+
+using namespace std;
+
+int main(int argc, char** argv)
+{
+  if (argc < 2) {
+    cout << "Usage: ./veto-decode-check [run]\n"
+         << "                           [-f [file] (built or veto-only file.  default: veto-extract file, or the built file)]\n"
+         << "                           [-n [entries] (only check this many)]\n"
+         << "                           [-v (print each mismatch)]\n";
+    return 1;
+  }
+  int run = stoi(argv[1]);
+  string path = "";
+  long maxEntries = -1;
+  bool verbose = false;
+  for (int i = 2; i < argc; i++) {
+    string opt = argv[i];
+    if (opt == "-f" && i+1 < argc) path = argv[++i];
+    else if (opt == "-n" && i+1 < argc) maxEntries = stol(argv[++i]);
+    else if (opt == "-v") verbose = true;
+  }
+  GATDataSet ds;
+  if (path == "") path = GetExtractedVetoPath(run);
+  if (path == "") path = ds.GetPathToRun(run,GATDataSet::kBuilt);
+
+  // 1. MJVetoEvent, the way auto-veto reads it.
+  TChain *vChain = new TChain("VetoTree");
+  if (!vChain->Add(path.c_str()) || vChain->GetEntries() < 1) { cout << "No veto data in " << path << endl; return 1; }
+  long nEntries = vChain->GetEntries();
+  if (maxEntries > 0 && maxEntries < nEntries) nEntries = maxEntries;
+  printf("Run %i: checking %li entries of %s\n", run, nEntries, path.c_str());
+
+  int card1 = 0, card2 = 0;
+  VetoDecoder::Cards(run, card1, card2);
+  vector<VetoRecord> ref(nEntries);
+  TStopwatch timer;
+  timer.Start();
+  {
+    TTreeReader reader(vChain);
+    TTreeReaderValue<uint32_t> vBits(reader, "vetoBits");
+    TTreeReaderValue<unsigned int> vMult(reader, "mVeto");
+    TTreeReaderValue<MGTBasicEvent> vEvt(reader,"vetoEvent");
+    TTreeReaderValue<MJTRun> vRun(reader,"run");
+    MJVetoEvent veto(card1,card2);
+    while (reader.Next() && reader.GetCurrentEntry() < nEntries)
+    {
+      long i = reader.GetCurrentEntry();
+      veto.Clear();
+      veto.WriteEvent(i,&*vRun,&*vEvt,*vBits,run,true);
+      VetoRecord &r = ref[i];
+      r.entry = i;
+      r.mVeto = *vMult;
+      r.vetoBits = *vBits;
+      for (int j = 0; j < 32; j++) r.qdc[j] = veto.GetQDC(j);
+      r.qdcIndex[0] = veto.GetQDC1Index();
+      r.qdcIndex[1] = veto.GetQDC2Index();
+      r.qec[0] = veto.GetQEC();
+      r.qec[1] = veto.GetQEC2();
+      r.scalerIndex = veto.GetScalerIndex();
+      r.sec = veto.GetSEC();
+      r.timeSec = veto.GetTimeSec();
+      r.badTS = veto.GetBadScaler();
+    }
+  }
+  timer.Stop();
+  double tRef = timer.CpuTime();
+
+  // 2. VetoDecoder, on its own chain.
+  TChain *dChain = new TChain("VetoTree");
+  dChain->Add(path.c_str());
+  VetoDecoder dec(dChain, run);
+  enum { fQDC, fQDCIndex, fQEC, fScalerIndex, fSEC, fTime, fBadTS, fBits, nFields };
+  const char *fieldNames[nFields] = {"QDC", "QDC index", "QEC", "Scaler index", "SEC", "Scaler time", "Bad scaler", "mVeto/vetoBits"};
+  long mismatch[nFields] = {0};
+  long nRead = 0;
+  timer.Start();
+  vector<VetoRecord> dec_out(nEntries);
+  for (long i = 0; i < nEntries; i++)
+    if (dec.GetEntry(i, dec_out[i])) nRead++;
+  timer.Stop();
+  double tDec = timer.CpuTime();
+
+  for (long i = 0; i < nEntries; i++)
+  {
+    const VetoRecord &a = ref[i];
+    const VetoRecord &b = dec_out[i];
+    bool bad[nFields] = {false};
+    for (int j = 0; j < 32; j++) if (a.qdc[j] != b.qdc[j]) bad[fQDC] = true;
+    bad[fQDCIndex] = (a.qdcIndex[0] != b.qdcIndex[0] || a.qdcIndex[1] != b.qdcIndex[1]);
+    bad[fQEC] = (a.qec[0] != b.qec[0] || a.qec[1] != b.qec[1]);
+    bad[fScalerIndex] = (a.scalerIndex != b.scalerIndex);
+    bad[fSEC] = (a.sec != b.sec);
+    bad[fTime] = (a.timeSec != b.timeSec);   // exact: same bits
+    bad[fBadTS] = (a.badTS != b.badTS);
+    bad[fBits] = (a.mVeto != b.mVeto || a.vetoBits != b.vetoBits);
+    for (int f = 0; f < nFields; f++) {
+      if (!bad[f]) continue;
+      mismatch[f]++;
+      if (verbose)
+        printf("  %-8li %-14s  MJVetoEvent: idx %li  t %.8f  |  decoder: idx %li  t %.8f\n", i, fieldNames[f],
+          a.scalerIndex, a.timeSec, b.scalerIndex, b.timeSec);
+    }
+  }
+  long nBad = 0;
+  printf("Decoder mode: %s.  %li of %li entries decoded.\n", dec.IsSplit() ? "split leaves" : "MGTBasicEvent", nRead, nEntries);
+  for (int f = 0; f < nFields; f++) {
+    printf("  %-15s %li mismatched entries\n", fieldNames[f], mismatch[f]);
+    nBad += mismatch[f];
+  }
+  printf("CPU: MJVetoEvent %.2f s (%.2f us/entry), decoder %.2f s (%.2f us/entry), x%.1f\n",
+    tRef, 1e6*tRef/nEntries, tDec, 1e6*tDec/nEntries, (tDec > 0) ? tRef/tDec : 0);
+  printf("%s\n", (nBad == 0 && nRead == nEntries) ? "IDENTICAL" : "DIFFERENT");
+  return (nBad == 0 && nRead == nEntries) ? 0 : 1;
+}
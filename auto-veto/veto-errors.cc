@@ -0,0 +1,100 @@
+// veto-errors.cc
+// Prints the veto error records that auto-veto writes to errorTree (VetoErrorLog.hh),
+// optionally only some error codes, only serious errors, or a range of entries.
+// Usage: ./veto-errors [veto_run files ...] (-c [code,code,...]) (-s) (-e [first] [last]) (-n [max lines]) (--summary)
+// C. Wiseman, USC/Majorana
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <set>
+#include <climits>
+#include "TFile.h"
+#include "TTree.h"
+#include "VetoErrorLog.hh"
+
+using namespace std;
+
+int main(int argc, char** argv)
+{
+  if (argc < 2) {
+    cout << "Usage: ./veto-errors [veto_run files ...]\n"
+         << "                     [-c [code,code,...] (only these error codes)]\n"
+         << "                     [-s (only serious errors)]\n"
+         << "                     [-e [first] [last] (only these entries)]\n"
+         << "                     [-n [lines] (print at most this many records per file)]\n"
+         << "                     [--summary (only the totals for each code)]\n";
+    return 1;
+  }
+  vector<string> files;
+  set<int> codes;
+  long first = 0, last = LONG_MAX, maxLines = LONG_MAX;
+  bool summary = false;
+  for (int i = 1; i < argc; i++) {
+    string opt = argv[i];
+    if (opt == "-c" && i+1 < argc) {
+      stringstream ss(argv[++i]);
+      string c;
+      while (getline(ss, c, ',')) codes.insert(stoi(c));
+    }
+    else if (opt == "-s") for (auto c : VetoErrorLog::SeriousCodes()) codes.insert(c);
+    else if (opt == "-e" && i+2 < argc) { first = stol(argv[i+1]); last = stol(argv[i+2]); i += 2; }
+    else if (opt == "-n" && i+1 < argc) maxLines = stol(argv[++i]);
+    else if (opt == "--summary") summary = true;
+    else files.push_back(opt);
+  }
+
+  for (auto &file : files)
+  {
+    TFile *f = TFile::Open(file.c_str());
+    if (f == NULL || f->IsZombie()) { cout << "Couldn't open " << file << endl; continue; }
+    TTree *counts = (TTree*)f->Get("errorCounts");
+    TTree *errs = (TTree*)f->Get("errorTree");
+    if (counts == NULL || errs == NULL) {
+      cout << file << " has no error records.  (Re-run auto-veto on it.)\n";
+      f->Close();
+      continue;
+    }
+    int run = 0;
+    vector<long> *count = 0;
+    long dropped = 0;
+    counts->SetBranchAddress("run", &run);
+    counts->SetBranchAddress("counts", &count);
+    counts->SetBranchAddress("dropped", &dropped);
+    counts->GetEntry(0);
+
+    printf("Run %i (%s): %lli error records", run, file.c_str(), errs->GetEntries());
+    if (dropped > 0) printf(", %li older records dropped", dropped);
+    printf("\n");
+    for (size_t c = 1; c < count->size(); c++) {
+      if ((*count)[c] == 0 || (!codes.empty() && codes.count(c) == 0)) continue;
+      printf("  Error[%zu] %-26s %li\n", c, VetoErrorLog::CodeName(c), (*count)[c]);
+    }
+    if (summary) { f->Close(); continue; }
+
+    VetoErrorRecord r;
+    errs->SetBranchAddress("entry", &r.entry);
+    errs->SetBranchAddress("code", &r.code);
+    errs->SetBranchAddress("scalerIndex", &r.scalerIndex);
+    errs->SetBranchAddress("scalerTime", &r.scalerTime);
+    errs->SetBranchAddress("sbcTime", &r.sbcTime);
+    errs->SetBranchAddress("dScaler", &r.dScaler);
+    errs->SetBranchAddress("dSBC", &r.dSBC);
+    long nLines = 0;
+    for (long i = 0; i < errs->GetEntries() && nLines < maxLines; i++)
+    {
+      errs->GetEntry(i);
+      if (!codes.empty() && codes.count(r.code) == 0) continue;
+      if (r.entry >= 0 && (r.entry < first || r.entry > last)) continue;
+      if (r.entry < 0)
+        printf("  run-level :[%i] %s\n", r.code, VetoErrorLog::CodeName(r.code));
+      else
+        printf("  %-9li :[%i] %-26s Index %-8li Scaler %-9.2f SBC %-12.0f d(sca) %-8.3f d(sbc) %-8.3f\n",
+          r.entry, r.code, VetoErrorLog::CodeName(r.code), r.scalerIndex, r.scalerTime, r.sbcTime, r.dScaler, r.dSBC);
+      nLines++;
+    }
+    f->Close();
+  }
+  return 0;
+}
@@ -0,0 +1,151 @@
+// veto-extract.cc
+// Copies each run's VetoTree out of the built data into a small veto-only file, and
+// adds it to the veto file catalog (VetoFiles.hh).  Then auto-veto, vetoCheck and
+// vetoScan read only the veto bytes of a run, not the whole built file with its MGTree.
+// C. Wiseman, USC/Majorana
+//
+// VetoTree already carries the run header (its "run" branch, an MJTRun).  Any other
+// objects at the top of the built file (not trees) are copied too.
+// By default the tree is fast-cloned: the compressed baskets are copied as they are,
+// without being unzipped.  With -z the tree is rewritten at the given ROOT compression
+// setting (100*algorithm + level, e.g. 207 for LZMA level 7), which is slower but smaller.
+//
+// Usage: ./veto-extract [run, or run list file] (-o [directory]) (-z [compression]) (--only-stale)
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <climits>
+#include <cstdlib>
+#include <sys/stat.h>
+#include "TFile.h"
+#include "TTree.h"
+#include "TKey.h"
+#include "TList.h"
+#include "TROOT.h"
+#include "GATDataSet.hh"
+#include "VetoFiles.hh"
+#include "Provenance.hh"
+
+using namespace std;
+
+bool ExtractVetoTree(int run, string outputDir, int compression, bool onlyStale, VetoFileCatalog &cat);
+
+int main(int argc, char** argv)
+{
+  if (argc < 2) {
+    cout << "Usage: ./veto-extract [run, or run list file]\n"
+         << "                      [-o [directory] (where to put the veto files, default ./vetoFiles)]\n"
+         << "                      [-z [setting] (re-compress, e.g. 207 for LZMA 7.  default: fast clone)]\n"
+         << "                      [--only-stale (skip runs whose veto file is up to date)]\n"
+         << "  Catalog: " << VetoFileCatalog::DefaultFile() << " (set $MJD_VETOFILES)\n";
+    return 1;
+  }
+  string outputDir = "./vetoFiles";
+  int compression = -1;
+  bool onlyStale = false;
+  for (int i = 2; i < argc; i++) {
+    string opt = argv[i];
+    if (opt == "-o" && i+1 < argc) outputDir = argv[++i];
+    else if (opt == "-z" && i+1 < argc) compression = stoi(argv[++i]);
+    else if (opt == "--only-stale") onlyStale = true;
+  }
+
+  vector<int> runs;
+  string input = argv[1];
+  ifstream runList(input.c_str());
+  if (runList.good()) {
+    int run;
+    while (runList >> run) runs.push_back(run);
+  }
+  else runs.push_back(stoi(input));
+
+  gROOT->ProcessLine("gErrorIgnoreLevel = 3001;");
+  VetoFileCatalog cat;
+  cat.Load();
+  int nFailed = 0;
+  for (auto run : runs) {
+    if (!ExtractVetoTree(run, outputDir, compression, onlyStale, cat)) nFailed++;
+  }
+  if (!cat.Save()) return 1;
+  printf("Extracted %lu runs (%i failed).  Catalog: %s, %lu runs.\n",
+    runs.size()-nFailed, nFailed, VetoFileCatalog::DefaultFile().c_str(), cat.GetNRuns());
+  return (nFailed > 0) ? 1 : 0;
+}
+
+bool ExtractVetoTree(int run, string outputDir, int compression, bool onlyStale, VetoFileCatalog &cat)
+{
+  if (run > 60000000 && run < 70000000) {
+    cout << "Veto data not present in Module 2 runs.  Skipping run " << run << endl;
+    return false;
+  }
+  GATDataSet ds;
+  string builtFile = ds.GetPathToRun(run,GATDataSet::kBuilt);
+  char vetoFile[300];
+  sprintf(vetoFile,"%s/vetoOnly_run%i.root",outputDir.c_str(),run);
+
+  Manifest manifest("veto-extract"), prevManifest;
+  manifest.AddInput(builtFile);
+  manifest.AddParam("compression", compression);
+  bool havePrev = prevManifest.Load(Manifest::FileName(vetoFile));
+  string why;
+  if (onlyStale && manifest.IsUpToDate(vetoFile, why) && cat.Find(run) != NULL) {
+    cout << "Run " << run << " is up to date.  Skipping ...\n";
+    return true;
+  }
+
+  TFile *fIn = TFile::Open(builtFile.c_str());
+  if (fIn == NULL || fIn->IsZombie()) { cout << "Couldn't open " << builtFile << endl; return false; }
+  TTree *vetoTree = (TTree*)fIn->Get("VetoTree");
+  if (vetoTree == NULL || vetoTree->GetEntries() < 1) {
+    cout << "No veto data in " << builtFile << endl;
+    fIn->Close();
+    return false;
+  }
+
+  mkdir(outputDir.c_str(), 0775);
+  TFile *fOut = new TFile(vetoFile, "RECREATE");
+  if (fOut->IsZombie()) { cout << "Couldn't create " << vetoFile << endl; fIn->Close(); return false; }
+  if (compression >= 0) fOut->SetCompressionSettings(compression);
+  fOut->cd();
+  TTree *vetoOut = (compression < 0) ? vetoTree->CloneTree(-1,"fast") : vetoTree->CloneTree(-1);
+  if (vetoOut == NULL) {
+    cout << "Couldn't copy VetoTree from " << builtFile << endl;
+    fOut->Close();
+    fIn->Close();
+    return false;
+  }
+  vetoOut->Write("",TObject::kOverwrite);
+
+  // everything else at the top of the built file that isn't a tree (channel map, settings, ...)
+  TIter next(fIn->GetListOfKeys());
+  while (TKey *key = (TKey*)next()) {
+    TClass *cl = TClass::GetClass(key->GetClassName());
+    if (cl == NULL || cl->InheritsFrom("TTree")) continue;
+    TObject *obj = key->ReadObj();
+    fOut->cd();
+    obj->Write(key->GetName());
+    delete obj;
+  }
+  long entries = vetoOut->GetEntries();
+  fOut->Close();
+  fIn->Close();
+
+  VetoFileCatalog::Entry e;
+  struct stat st;
+  char fullPath[PATH_MAX];
+  e.vetoFile = (realpath(vetoFile, fullPath) != NULL) ? fullPath : vetoFile;  // so the catalog works from anywhere
+  e.builtFile = builtFile;
+  e.entries = entries;
+  e.builtBytes = (stat(builtFile.c_str(), &st) == 0) ? st.st_size : 0;
+  e.builtMtime = (e.builtBytes > 0) ? (long)st.st_mtime : -1;
+  e.vetoBytes = (stat(vetoFile, &st) == 0) ? st.st_size : 0;
+  e.compression = compression;
+  cat.Set(run, e);
+  manifest.Save(Manifest::FileName(vetoFile), havePrev ? &prevManifest : NULL);
+
+  printf("Run %i: %li entries.  %.1f MB -> %.2f MB  (%s)\n", run, entries,
+    e.builtBytes/1e6, e.vetoBytes/1e6, vetoFile);
+  return true;
+}
@@ -0,0 +1,184 @@
+// veto-render.cc
+// Draws the diagnostic plots saved as plotData (PlotRecorder.hh) by auto-veto -d and
+// vetoScan, in batch mode, after the processing is done.  One output file per canvas.
+// C. Wiseman, USC/Majorana
+//
+// With several input files and -j N, N worker threads each run ./veto-render on one
+// file at a time, as a separate process (ROOT isn't thread-safe).
+//
+// Usage: ./veto-render [files with plotData ...] (-o [directory]) (-f [pdf, png, ...]) (-j [workers])
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <thread>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <sys/wait.h>
+#include "TFile.h"
+#include "TTree.h"
+#include "TROOT.h"
+#include "TStyle.h"
+#include "TCanvas.h"
+#include "TH1.h"
+#include "TGraph.h"
+#include "TLine.h"
+#include "PlotRecorder.hh"
+
+using namespace std;
+
+int RenderFile(string file, string outputDir, string format);
+void Worker(int id, string self, const vector<string> *files, atomic<size_t> *next, string outputDir, string format, atomic<int> *nFailed);
+string ShellQuote(string s);
+
+int main(int argc, char** argv)
+{
+  if (argc < 2) {
+    cout << "Usage: ./veto-render [files with plotData ...]\n"
+         << "                     [-o [directory] (default: the same directory as each file)]\n"
+         << "                     [-f [format] (pdf, png, ... default pdf)]\n"
+         << "                     [-j [n] (render n files at once, default 1)]\n";
+    return 1;
+  }
+  vector<string> files;
+  string outputDir = "", format = "pdf";
+  int nWorkers = 1;
+  for (int i = 1; i < argc; i++) {
+    string opt = argv[i];
+    if (opt == "-o" && i+1 < argc) outputDir = argv[++i];
+    else if (opt == "-f" && i+1 < argc) format = argv[++i];
+    else if (opt == "-j" && i+1 < argc) nWorkers = stoi(argv[++i]);
+    else files.push_back(opt);
+  }
+
+  if (nWorkers <= 1 || files.size() < 2) {
+    int nPlots = 0, nFailed = 0;
+    for (auto &file : files) {
+      int n = RenderFile(file, outputDir, format);
+      if (n < 0) nFailed++;
+      else nPlots += n;
+    }
+    printf("Rendered %i canvases from %zu files (%i failed).\n", nPlots, files.size()-nFailed, nFailed);
+    return (nFailed > 0) ? 1 : 0;
+  }
+  atomic<size_t> next(0);
+  atomic<int> nFailed(0);
+  vector<thread> workers;
+  for (int i = 0; i < nWorkers; i++)
+    workers.push_back(thread(Worker, i, string(argv[0]), &files, &next, outputDir, format, &nFailed));
+  for (auto &w : workers) w.join();
+  printf("Rendered %zu files (%i failed) with %i workers.\n", files.size()-nFailed, (int)nFailed, nWorkers);
+  return (nFailed > 0) ? 1 : 0;
+}
+
+// Single quotes, so file names with spaces or shell characters are passed as they are.
+string ShellQuote(string s)
+{
+  string q = "'";
+  for (char c : s) q += (c == '\'') ? string("'\\''") : string(1, c);
+  return q + "'";
+}
+
+void Worker(int id, string self, const vector<string> *files, atomic<size_t> *next, string outputDir, string format, atomic<int> *nFailed)
+{
+  size_t i;
+  while ((i = (*next)++) < files->size())
+  {
+    string cmd = ShellQuote(self) + " " + ShellQuote((*files)[i]) + " -f " + ShellQuote(format);
+    if (outputDir != "") cmd += " -o " + ShellQuote(outputDir);
+    cmd += " > /dev/null";
+    int ret = system(cmd.c_str());
+    if (ret != 0) {
+      if (ret != -1 && WIFEXITED(ret)) ret = WEXITSTATUS(ret);
+      printf("[worker %i] %s failed (exit %i)\n", id, (*files)[i].c_str(), ret);
+      (*nFailed)++;
+    }
+  }
+}
+
+// Returns the number of canvases drawn, or -1 if the file can't be opened or has no plotData.
+int RenderFile(string file, string outputDir, string format)
+{
+  gROOT->SetBatch(true);
+  gROOT->ProcessLine("gErrorIgnoreLevel = 2001;");
+  gStyle->SetOptStat(0);
+
+  TFile *f = TFile::Open(file.c_str());
+  if (f == NULL || f->IsZombie()) { cout << "Couldn't open " << file << endl; return -1; }
+  TTree *t = (TTree*)f->Get("plotData");
+  if (t == NULL) { cout << file << " has no plotData.\n"; f->Close(); delete f; return -1; }
+  if (outputDir == "") {
+    outputDir = file;
+    size_t slash = outputDir.find_last_of("/");
+    outputDir = (slash == string::npos) ? "." : outputDir.substr(0, slash);
+  }
+
+  PlotRecord r;
+  int nx = 1, ny = 1, width = 800, height = 600;
+  string *canvas = &r.canvas, *name = &r.name, *title = &r.title, *xTitle = &r.xTitle, *yTitle = &r.yTitle;
+  vector<double> *x = &r.x, *y = &r.y;
+  t->SetBranchAddress("canvas", &canvas);
+  t->SetBranchAddress("name", &name);
+  t->SetBranchAddress("title", &title);
+  t->SetBranchAddress("xTitle", &xTitle);
+  t->SetBranchAddress("yTitle", &yTitle);
+  t->SetBranchAddress("pad", &r.pad);
+  t->SetBranchAddress("kind", &r.kind);
+  t->SetBranchAddress("nBins", &r.nBins);
+  t->SetBranchAddress("x", &x);
+  t->SetBranchAddress("y", &y);
+  t->SetBranchAddress("vline", &r.vline);
+  t->SetBranchAddress("logy", &r.logy);
+  t->SetBranchAddress("marker", &r.marker);
+  t->SetBranchAddress("color", &r.color);
+  t->SetBranchAddress("nx", &nx);
+  t->SetBranchAddress("ny", &ny);
+  t->SetBranchAddress("width", &width);
+  t->SetBranchAddress("height", &height);
+
+  // Canvases are made as their first plot is read, and printed at the end.
+  map<string, TCanvas*> canvases;
+  for (long i = 0; i < t->GetEntries(); i++)
+  {
+    t->GetEntry(i);
+    TCanvas *c = canvases[*canvas];
+    if (c == NULL) {
+      c = new TCanvas(canvas->c_str(), canvas->c_str(), width, height);
+      if (nx*ny > 1) c->Divide(nx, ny, 0, 0);
+      canvases[*canvas] = c;
+    }
+    TVirtualPad *pad = c->cd(r.pad);
+    if (r.logy) pad->SetLogy();
+    if (r.kind == 0) {
+      TH1D *h = new TH1D(TString::Format("%s_%li", name->c_str(), i), title->c_str(), r.nBins, (*x)[0], (*x)[1]);
+      for (int b = 0; b < r.nBins && b < (int)y->size(); b++) h->SetBinContent(b+1, (*y)[b]);
+      h->SetEntries(h->Integral());
+      h->Draw();
+      if (r.vline >= 0) {
+        TLine *line = new TLine(r.vline, 0, r.vline, h->GetMaximum()+10);
+        line->SetLineColor(kRed);
+        line->SetLineWidth(2.0);
+        line->Draw();
+      }
+    }
+    else if (!x->empty()) {
+      TGraph *g = new TGraph(x->size(), &(*x)[0], &(*y)[0]);
+      g->SetTitle(title->c_str());
+      g->GetXaxis()->SetTitle(xTitle->c_str());
+      g->GetYaxis()->SetTitle(yTitle->c_str());
+      g->SetMarkerStyle(r.marker);
+      g->SetMarkerColor(r.color);
+      g->SetMarkerSize(0.5);
+      g->Draw("AP");
+    }
+  }
+  for (auto &c : canvases) {
+    c.second->Print(TString::Format("%s/%s.%s", outputDir.c_str(), c.first.c_str(), format.c_str()));
+    delete c.second;
+  }
+  f->Close();
+  delete f;
+  return canvases.size();
+}
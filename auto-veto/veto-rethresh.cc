@@ -0,0 +1,95 @@
+// veto-rethresh.cc
+// Recomputes the QDC software thresholds from the low-QDC spectra that auto-veto saves
+// in each veto_run file (qdcSpectra, see QDCSpectra.hh), with any of the threshold rules.
+// This reads a few kB per run instead of the built data.
+// Usage: ./veto-rethresh [veto_run files ...] (-r [rule]) (-p [parameter]) (-c) (-s [threshold store file])
+// C. Wiseman, USC/Majorana
+//
+// Prints one line per run: the run number and its 32 thresholds (the vetoSWThresholds.txt format).
+// With -c, only the panels that differ from auto-veto's rule (pedestal + 35) are printed.
+// With -s, the thresholds are also put in a ThresholdStore file, which auto-veto can use.
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include "TFile.h"
+#include "TTree.h"
+#include "TStopwatch.h"
+#include "QDCSpectra.hh"
+#include "ThresholdStore.hh"
+
+using namespace std;
+
+int main(int argc, char** argv)
+{
+  if (argc < 2) {
+    cout << "Usage: ./veto-rethresh [veto_run files ...]\n"
+         << "                       [-r [rule] (";
+    for (auto &r : QDCSpectra::Rules()) cout << r.first << " ";
+    cout << ", default: pedestal)]\n"
+         << "                       [-p [parameter] (offset above the pedestal, or fraction for 'frac'.  default 35)]\n"
+         << "                       [-c (only print the panels that change from auto-veto's thresholds)]\n"
+         << "                       [-s [file] (put the thresholds in this threshold store)]\n";
+    return 1;
+  }
+  vector<string> files;
+  string ruleName = "pedestal", storeFile = "";
+  double par = 35;
+  bool compare = false;
+  for (int i = 1; i < argc; i++) {
+    string opt = argv[i];
+    if (opt == "-r" && i+1 < argc) ruleName = argv[++i];
+    else if (opt == "-p" && i+1 < argc) par = stod(argv[++i]);
+    else if (opt == "-c") compare = true;
+    else if (opt == "-s" && i+1 < argc) storeFile = argv[++i];
+    else files.push_back(opt);
+  }
+  QDCSpectra::Rule rule = QDCSpectra::GetRule(ruleName);
+  if (rule == NULL) { cout << "Unknown rule: " << ruleName << endl; return 1; }
+
+  vector<pair<int, vector<int> > > newThresh;   // added to the store at the end
+  TStopwatch timer;
+  timer.Start();
+  int nRuns = 0, nMissing = 0;
+  QDCSpectra spec;
+  for (auto &file : files)
+  {
+    TFile *f = TFile::Open(file.c_str());
+    if (f == NULL || f->IsZombie()) { cout << "Couldn't open " << file << endl; nMissing++; continue; }
+    if (!spec.Read((TTree*)f->Get("qdcSpectra"))) {
+      cout << file << " has no QDC spectra.  (Re-run auto-veto on it.)\n";
+      f->Close();
+      nMissing++;
+      continue;
+    }
+    f->Close();
+    int run = spec.GetRun();
+    vector<int> thresholds;
+    if (!compare) printf("%i ", run);
+    for (int j = 0; j < 32; j++) {
+      int t = rule(spec.Counts(j), j, run, par);
+      thresholds.push_back(j);
+      thresholds.push_back(t);
+      if (!compare) printf(" %i", t);
+      else {
+        int old = QDCSpectra::PedestalRule(spec.Counts(j), j, run, 35);
+        if (t != old) printf("Run %i  panel %-2i  %i -> %i\n", run, j, old, t);
+      }
+    }
+    if (!compare) printf("\n");
+    if (storeFile != "") newThresh.push_back(make_pair(run, thresholds));
+    nRuns++;
+  }
+  timer.Stop();
+  if (storeFile != "") {
+    ThresholdStore store;
+    FileLock lock(storeFile);   // auto-veto jobs may be updating it too
+    store.Load(storeFile);
+    for (auto &t : newThresh) store.Add(t.first, t.second);
+    if (store.Save(storeFile))
+      printf("Wrote %s: %zu threshold ranges.\n", storeFile.c_str(), store.GetNRanges());
+  }
+  printf("%i runs (%i without spectra), rule '%s' (%g), %.1f s.\n", nRuns, nMissing, ruleName.c_str(), par, timer.RealTime());
+  return 0;
+}
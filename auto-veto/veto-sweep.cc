@@ -0,0 +1,353 @@
+// veto-sweep.cc
+// Evaluates a grid of muon & LED cut configurations in one pass over the veto_run
+// files, and prints one table: muon counts by type, LED tags & leakage, and dead
+// time for each configuration.  Replaces editing the constants and re-running
+// auto-veto (or muFinder / muSimple) once per configuration.
+// C. Wiseman, USC/Majorana
+//
+// Each run is read once, into flat arrays.  Per-event quantities that depend on a
+// single cut (multiplicity & plane hits for a threshold offset, number of panels over
+// a muon QDC) are computed once per distinct value of that cut, into contiguous arrays.
+// Then each configuration runs over them: the pass/fail and LED counting loop has no
+// branches or calls, so the compiler can vectorize it, and only the events that pass
+// go through the muon type, leakage and dead time bookkeeping.
+//
+// Grid file: a cut name followed by the values to try, one cut per line.
+// The grid is every combination.  Cuts not listed keep their VetoCuts defaults.
+//   LEDMultipThreshold 3 4 5 6 7
+//   muonQDC 400 500 600
+//   muonPanels 2 3
+//   bothPlanes 0 1
+//   threshOffset -10 0 10     (QDC, added to every panel's software threshold)
+//   LEDWindow 0.01 0.05       (sec, for counting LED leakage)
+//
+// LED leakage: muon candidates within LEDWindow of a whole number of LED periods
+// after the last unambiguous LED (multiplicity >= highest - 1, at the production thresholds).
+// Dead time: the union of the muon veto windows (Livetime.hh) in each run.
+//
+// Usage: ./veto-sweep [run list] [grid file] (-i [veto_run directory]) (-o [table file])
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstdio>
+#include "TFile.h"
+#include "TTree.h"
+#include "TTreeReader.h"
+#include "TTreeReaderValue.h"
+#include "MJVetoEvent.hh"
+#include "VetoCuts.hh"
+#include "VetoSeed.hh"
+#include "VetoGeometry.hh"
+#include "Livetime.hh"
+
+using namespace std;
+
+struct SweepConfig
+{
+  VetoCuts cuts;
+  int threshOffset;
+  double LEDWindow;
+};
+
+// Totals for one configuration, summed over runs.
+struct SweepResult
+{
+  long nMuons, nType[5], nLED, nLeak;
+  double deadTime;
+  SweepResult() : nMuons(0), nLED(0), nLeak(0), deadTime(0) { for (int i = 0; i < 5; i++) nType[i] = 0; }
+};
+
+// One run's decoded events, in flat arrays.
+struct RunEvents
+{
+  int run;
+  long n;
+  vector<short> qdc;          // n*32
+  vector<int> prodMultip;     // multiplicity at the production thresholds
+  vector<double> time, unc;
+  int thresh[32];
+  int highestMultip;
+  double duration, LEDperiod;
+  bool LEDoff;
+};
+
+bool LoadGrid(string file, vector<SweepConfig> &grid);
+bool LoadRun(int run, string inputDir, RunEvents &ev);
+void SweepRun(const RunEvents &ev, const vector<SweepConfig> &grid, vector<SweepResult> &results);
+int MuonType(int planeMask, bool bothPlanes);
+
+int main(int argc, char** argv)
+{
+  if (argc < 3) {
+    cout << "Usage: ./veto-sweep [run list] [grid file]\n"
+         << "                    [-i [directory] (where the veto_run files are, default ./)]\n"
+         << "                    [-o [file] (also write the table here)]\n";
+    return 1;
+  }
+  string listFile = argv[1], gridFile = argv[2], inputDir = "./", tableFile = "";
+  for (int i = 3; i < argc; i++) {
+    string opt = argv[i];
+    if (opt == "-i" && i+1 < argc) inputDir = argv[++i];
+    else if (opt == "-o" && i+1 < argc) tableFile = argv[++i];
+    else { cout << "Unknown option: " << opt << endl; return 1; }
+  }
+
+  vector<SweepConfig> grid;
+  if (!LoadGrid(gridFile, grid)) return 1;
+  printf("Sweeping %lu cut configurations.\n", grid.size());
+
+  ifstream runList(listFile.c_str());
+  if (!runList.good()) { cout << "Couldn't open " << listFile << endl; return 1; }
+  vector<SweepResult> results(grid.size());
+  double totalDuration = 0;
+  long nRuns = 0, nEvents = 0;
+  int run;
+  while (runList >> run)
+  {
+    RunEvents ev;
+    if (!LoadRun(run, inputDir, ev)) continue;
+    SweepRun(ev, grid, results);
+    totalDuration += ev.duration;
+    nEvents += ev.n;
+    nRuns++;
+  }
+  printf("%li runs, %li events, %.0f sec.\n", nRuns, nEvents, totalDuration);
+  if (nRuns == 0) return 1;
+
+  // The table
+  ostringstream table;
+  char line[500];
+  sprintf(line, "%-4s %-5s %-5s %-5s %-5s %-5s %-6s %-8s %-8s %-8s %-8s %-8s %-8s %-8s %-8s %-10s %-8s\n",
+    "cfg","LEDm","mQDC","mPan","both","tOff","LEDwin","muons","2+pan","vert","sd+bot","top+sd","cmpd","LEDtag","LEDleak","dead(s)","dead(%)");
+  table << line;
+  for (size_t c = 0; c < grid.size(); c++)
+  {
+    const VetoCuts &k = grid[c].cuts;
+    const SweepResult &r = results[c];
+    sprintf(line, "%-4lu %-5i %-5i %-5i %-5i %-5i %-6.3f %-8li %-8li %-8li %-8li %-8li %-8li %-8li %-8li %-10.1f %-8.4f\n",
+      c, k.LEDMultipThreshold, k.muonQDC, k.muonPanels, k.bothPlanes, grid[c].threshOffset, grid[c].LEDWindow,
+      r.nMuons, r.nType[0], r.nType[1], r.nType[2], r.nType[3], r.nType[4], r.nLED, r.nLeak,
+      r.deadTime, 100*r.deadTime/totalDuration);
+    table << line;
+  }
+  cout << table.str();
+  if (tableFile != "") {
+    ofstream out(tableFile.c_str());
+    out << table.str();
+    cout << "Wrote " << tableFile << endl;
+  }
+  return 0;
+}
+
+bool LoadGrid(string file, vector<SweepConfig> &grid)
+{
+  ifstream in(file.c_str());
+  if (!in.good()) { cout << "Couldn't open grid file " << file << endl; return false; }
+  SweepConfig def = {VetoCuts(), 0, 0.05};
+  grid.assign(1, def);
+  string line, key, value;
+  while (getline(in, line))
+  {
+    if (line.empty() || line[0] == '#') continue;
+    istringstream iss(line);
+    if (!(iss >> key)) continue;
+    vector<string> values;
+    while (iss >> value) values.push_back(value);
+    if (values.empty()) continue;
+
+    // every existing configuration, once per value
+    vector<SweepConfig> next;
+    for (auto &cfg : grid) {
+      for (auto &v : values) {
+        SweepConfig c = cfg;
+        bool ok = true;
+        if (key == "threshOffset") c.threshOffset = stoi(v);
+        else if (key == "LEDWindow") c.LEDWindow = stod(v);
+        else ok = c.cuts.Set(key, v);
+        if (!ok) { cout << "Bad line in grid file " << file << ": " << line << endl; return false; }
+        next.push_back(c);
+      }
+    }
+    grid.swap(next);
+  }
+  return true;
+}
+
+bool LoadRun(int run, string inputDir, RunEvents &ev)
+{
+  char inputFile[500];
+  sprintf(inputFile,"%s/veto_run%i.root",inputDir.c_str(),run);
+  TFile *f = TFile::Open(inputFile);
+  if (f == NULL || f->IsZombie()) { cout << "Couldn't open " << inputFile << ".  Continuing ...\n"; return false; }
+  TTree *vetoTree = (TTree*)f->Get("vetoTree");
+  if (vetoTree == NULL || vetoTree->GetEntries() < 1) { cout << "No vetoTree in " << inputFile << ".  Continuing ...\n"; f->Close(); delete f; return false; }
+
+  TTreeReader reader(vetoTree);
+  TTreeReaderValue<MJVetoEvent> vEvent(reader,"vetoEvent");
+  TTreeReaderValue<double> vTime(reader,"xTime");
+  TTreeReaderValue<double> vUnc(reader,"timeUncert");
+  TTreeReaderValue<int> vHighestMultip(reader,"highestMultip");
+  TTreeReaderValue<double> vLEDfreq(reader,"LEDfreq");
+  TTreeReaderValue<double> vDuration(reader,"unixDuration");
+
+  ev.run = run;
+  ev.n = vetoTree->GetEntries();
+  ev.qdc.resize(ev.n*32);
+  ev.prodMultip.resize(ev.n);
+  ev.time.resize(ev.n);
+  ev.unc.resize(ev.n);
+  long i = 0;
+  while (reader.Next() && i < ev.n)
+  {
+    MJVetoEvent veto = *vEvent;
+    if (i == 0) {
+      for (int j = 0; j < 32; j++) ev.thresh[j] = veto.GetSWThresh(j);
+      ev.highestMultip = *vHighestMultip;
+      ev.duration = *vDuration;
+      bool fromSeed;
+      ev.LEDoff = IsLEDOff(inputDir, run, *vLEDfreq, fromSeed);
+      VetoSeed seed;
+      ev.LEDperiod = seed.Load(inputDir, run) ? seed.LEDperiod : ((*vLEDfreq > 0) ? 1 / *vLEDfreq : -1);
+    }
+    for (int j = 0; j < 32; j++) ev.qdc[i*32+j] = veto.GetQDC(j);
+    ev.prodMultip[i] = veto.GetMultip();
+    ev.time[i] = *vTime;
+    ev.unc[i] = *vUnc;
+    i++;
+  }
+  ev.n = i;
+  f->Close();
+  delete f;
+  return (ev.n > 0);
+}
+
+// Muon type from the 12-bit mask of hit planes, same rules as TagMuon in auto-veto.cc
+int MuonType(int planeMask, bool bothPlanes)
+{
+  auto P = [&](int p) { return (planeMask >> p) & 1; };
+  auto Side = [&](int p1, int p2) { return bothPlanes ? (P(p1) && P(p2)) : (P(p1) || P(p2)); };
+  bool anySide = Side(4,5) || Side(6,7) || Side(8,9) || Side(10,11);
+  bool a = Side(0,1) && Side(2,3);
+  bool b = Side(0,1) && anySide;
+  bool c = Side(2,3) && anySide;
+  if ((a && b) || (a && c) || (b && c)) return 4;
+  if (c) return 3;
+  if (b) return 2;
+  if (a) return 1;
+  return 0;
+}
+
+void SweepRun(const RunEvents &ev, const vector<SweepConfig> &grid, vector<SweepResult> &results)
+{
+  size_t nCfg = grid.size();
+  long n = ev.n;
+  int planes[32];
+  FillPlaneMap(ev.run, planes);
+
+  // Muon type for every plane mask, with & without the both-planes rule.
+  vector<char> typeTable(2*4096);
+  for (int m = 0; m < 4096; m++) {
+    typeTable[m] = MuonType(m, false);
+    typeTable[4096+m] = MuonType(m, true);
+  }
+
+  // Distinct threshold offsets & muon QDCs, and each configuration's index into them.
+  vector<int> offsets, muonQDCs;
+  vector<int> cOff(nCfg), cQDC(nCfg);
+  for (size_t c = 0; c < nCfg; c++) {
+    auto Index = [](vector<int> &v, int val) {
+      for (size_t k = 0; k < v.size(); k++) if (v[k] == val) return (int)k;
+      v.push_back(val);
+      return (int)v.size()-1;
+    };
+    cOff[c] = Index(offsets, grid[c].threshOffset);
+    cQDC[c] = Index(muonQDCs, grid[c].cuts.muonQDC);
+  }
+
+  // Per offset: multiplicity & plane mask of every event, and the highest multiplicity.
+  // [offset*n + event], so each configuration reads one contiguous row.
+  vector<short> multip(offsets.size()*n), mask(offsets.size()*n);
+  vector<int> highest(offsets.size(), 0);
+  for (size_t o = 0; o < offsets.size(); o++) {
+    for (long e = 0; e < n; e++) {
+      const short *q = &ev.qdc[e*32];
+      int m = 0, pm = 0;
+      for (int j = 0; j < 32; j++) {
+        if (q[j] <= ev.thresh[j] + offsets[o]) continue;
+        m++;
+        if (planes[j] >= 0) pm |= (1 << planes[j]);
+      }
+      multip[o*n+e] = m;
+      mask[o*n+e] = pm;
+      if (m > highest[o]) highest[o] = m;
+    }
+  }
+  // Per muon QDC: number of panels over it.  [muonQDC*n + event]
+  vector<char> nOver(muonQDCs.size()*n);
+  for (size_t k = 0; k < muonQDCs.size(); k++)
+    for (long e = 0; e < n; e++) {
+      const short *q = &ev.qdc[e*32];
+      int cnt = 0;
+      for (int j = 0; j < 32; j++) cnt += (q[j] > muonQDCs[k]);
+      nOver[k*n+e] = cnt;
+    }
+
+  // LED phase: distance (sec) from a whole number of LED periods after the last unambiguous LED.
+  vector<double> LEDphase(n, 1e9);
+  bool checkLeak = (!ev.LEDoff && ev.LEDperiod > 0 && ev.LEDperiod < 20);
+  if (checkLeak) {
+    double tLED = -1;
+    for (long e = 0; e < n; e++) {
+      if (ev.prodMultip[e] >= ev.highestMultip - 1) { tLED = ev.time[e]; continue; }
+      if (tLED < 0) continue;
+      double ph = fmod(ev.time[e] - tLED, ev.LEDperiod);
+      LEDphase[e] = min(ph, ev.LEDperiod - ph);
+    }
+  }
+
+  // The muon veto window of every event doesn't depend on the cuts.
+  vector<double> winLo(n), winHi(n);
+  for (long e = 0; e < n; e++) MuonVetoWindow(0, ev.time[e], ev.unc[e], winLo[e], winHi[e]);
+
+  // One configuration at a time, over the contiguous per-event arrays.
+  const short ledOff = ev.LEDoff ? 1 : 0;
+  vector<char> pass(n);
+  for (size_t c = 0; c < nCfg; c++)
+  {
+    const short *m = &multip[cOff[c]*n];
+    const short *pm = &mask[cOff[c]*n];
+    const char *over = &nOver[cQDC[c]*n];
+    const short multThresh = max(0, highest[cOff[c]] - grid[c].cuts.LEDMultipThreshold);
+    const char panels = grid[c].cuts.muonPanels;
+    char *p = &pass[0];
+
+    // pass/fail and LED tags: no branches, so this vectorizes
+    long nMuons = 0, nLED = 0;
+    for (long e = 0; e < n; e++) {
+      short led = (m[e] >= multThresh);
+      short ok = (ledOff | !led) & (over[e] >= panels);
+      p[e] = ok;
+      nMuons += ok;
+      nLED += !ok & !ledOff & led;
+    }
+
+    // the events that pass: muon type, LED leakage, dead time
+    SweepResult &r = results[c];
+    r.nMuons += nMuons;
+    r.nLED += nLED;
+    const char *types = &typeTable[grid[c].cuts.bothPlanes ? 4096 : 0];
+    double window = grid[c].LEDWindow;
+    IntervalSet dead;
+    for (long e = 0; e < n; e++) {
+      if (!p[e]) continue;
+      r.nType[(int)types[pm[e]]]++;
+      if (LEDphase[e] < window) r.nLeak++;
+      dead.Add(winLo[e], winHi[e]);
+    }
+    r.deadTime += dead.Length();
+  }
+}
@@ -9,6 +9,8 @@
 #include "TLegend.h"
 #include "TStyle.h"
 #include "TGraph.h"
+#include "TEntryList.h"
+#include "../auto-veto/SkimIndex.hh"
 
 using namespace std;
 
@@ -42,14 +44,20 @@ int main()
   // DS-1
   TFile *f1 = new TFile("./data/skimDS1_HitsOver2630.root");
   TTree *t1 = (TTree*)f1->Get("skimTree");
+  // with a muVeto index (./skim-index), the muVeto queries only read the events that have one
+  TEntryList *mu1 = SkimIndex::Load("./data/skimDS1_HitsOver2630.root","muVeto");
+  t1->SetEntryList(mu1);
   t1->Draw("dtmu_s","muVeto");
   can->Print("DS1_MuonHits_dtmu.pdf");
+  t1->SetEntryList(0);
   TH1D *h1 = new TH1D("h1","h1",100,2500,13000);
   h1->GetXaxis()->SetTitle("trapENFCal (hit)");
   t1->Project("h1","trapENFCal","gain==1");
   h1->Draw();
   TH1D *h2 = new TH1D("h2","h2",100,2500,13000);
+  t1->SetEntryList(mu1);
   t1->Project("h2","trapENFCal","gain==1 && muVeto");
+  t1->SetEntryList(0);
   h2->SetLineColor(kRed);
   h2->Draw("same");
   can->Print("DS1_Over2630_hitSpec.pdf");
@@ -45,6 +45,7 @@
 #include "TLine.h"
 #include "MJVetoEvent.hh"
 #include "GATDataSet.hh"
+#include "../auto-veto/VetoFiles.hh"
 
 using namespace std;
 
@@ -81,7 +82,8 @@ void vetoCheck(int run, bool draw)
 	vector<int> SeriousErrors = {1, 13, 14, 18, 19, 20, 21, 22, 23, 24};
 
 	GATDataSet *ds = new GATDataSet(run);
-	TChain *v = ds->GetVetoChain();
+	TChain *v = GetExtractedVetoChain(run);	// veto-only file, if veto-extract made one
+	if (v == NULL) v = ds->GetVetoChain();
 	long vEntries = v->GetEntries();
 
 	cout << "===== Scanning veto data, run " << run << ", " << vEntries << " entries. ======\n";
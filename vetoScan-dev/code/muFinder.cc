@@ -3,10 +3,11 @@
 // 3/9/2016
 
 #include "vetoScan.hh"
+#include "VetoClock.hh"
 
 using namespace std;
 
-void muFinder(string Input, int *thresh, bool root, bool list)
+void muFinder(string Input, int *thresh, bool root, bool list, string clockDir)
 {
 	// LED Cut Parameters (C-f "Display Cut Parameters" below.)
 	double LEDWindow = 0.1;
@@ -114,7 +115,8 @@ void muFinder(string Input, int *thresh, bool root, bool list)
 		v->GetEntry(0);
 		start = (long)vRun->GetStartTime();
 		stop = (long)vRun->GetStopTime();
-		duration = ds->GetRunTime()/CLHEP::second;
+		duration = GetRunTimeSec(run);
+		if (duration < 0) duration = ds->GetRunTime()/CLHEP::second;  // not cached: ask GAT
 
 		printf("\n======= Scanning run %i, %li entries, %.0f sec. =======\n",run,vEntries,duration);
 		cout << "start: " << start << "  stop: " << stop << endl;
@@ -139,12 +141,14 @@ void muFinder(string Input, int *thresh, bool root, bool list)
 		int firstGoodEntry = 0;
 		MJVetoEvent first;
 		highestMultip=0;
+		VetoClock clock(run, vEntries);
 		for (long i = 0; i < vEntries; i++)
 		{
 			v->GetEntry(i);
 			MJVetoEvent veto;
 			veto.SetSWThresh(swThresh);
 	    	isGood = veto.WriteEvent(i,vRun,vEvent,vBits,run,true);
+			clock.AddEntry(i,veto.GetTimeSec(),veto.GetTimeSBC(),veto.GetBadScaler(),!veto.GetError(1),veto.GetScalerIndex());
     		if (CheckForBadErrors(veto,i,isGood,false)) {
     			skippedEvents++;
     			continue;
@@ -179,6 +183,16 @@ void muFinder(string Input, int *thresh, bool root, bool list)
 		printf("First good entry: %i  Scaler %.2f  SBC %.2f  SBCOffset %.2f\n"
 			,firstGoodEntry,first.GetTimeSec(),first.GetTimeSBC(),SBCOffset);
 
+		// Build the time model.  Use the Ge sync from auto-veto if it left one in clockDir.
+		// Otherwise, ignore scaler jumps until a few entries past the last buffer flush, as auto-veto does.
+		if (clockDir != "" && clock.Load(clockDir)) cout << "Using cached clock model for run " << run << endl;
+		else {
+			long entryAfterFlush = clock.FindFlushEntry();
+			if (entryAfterFlush > 0) printf("Found buffer flush.  Ignoring scaler jumps before entry %li\n",entryAfterFlush);
+			clock.SetFlushEntry(entryAfterFlush);
+		}
+		clock.Build();
+
 		// Find the LED frequency
 		if (skippedEvents > 0) printf("Skipped %li of %li entries.\n",skippedEvents,vEntries);
 		// if (corruptScaler > 0) printf("Corrupt scaler: %li of %li entries (%.2f%%) .\n"
@@ -228,7 +242,6 @@ void muFinder(string Input, int *thresh, bool root, bool list)
 		bool firstLED = false;
 		// bool IsLEDPrev = false;
 		int almostMissedLED = 0;
-		double TSdifference = 0;
 		for (long i = 0; i < vEntries; i++)
 		// for (long i = 250; i < 300; i++)
 		{
@@ -241,48 +254,14 @@ void muFinder(string Input, int *thresh, bool root, bool list)
 
     	//----------------------------------------------------------
 			// 0: Time of event and skipping if necessary.
-			// Employ alternate methods if the scaler is corrupted.
-			// Should implement an estimate of the error when alternate methods are used.
+			// The clock model falls back to the SBC or neighboring entries if the scaler is corrupted.
 			//
-			bool ApproxTime = false;
-
-			xTime = -1;
-
-			if (!veto.GetBadScaler())
-			{
-				xTime = veto.GetTimeSec();
-
-				// Find scaler jumps and adjust xTime by "TSdifference"
-				// TSdifference starts at 0 at the beginning of the run.
-				if (veto.GetTimeSec() != 0 && veto.GetTimeSBC() !=0 && SBCOffset != 0 && i>=firstGoodEntry)
-				{
-					double sbc = veto.GetTimeSBC() - SBCOffset;
-					double diff = veto.GetTimeSec() - sbc;
-
-					// if (fabs(fabs(diff) - TSdifference) > 1)	// andrew's original method (11472 - fails)
-					if (fabs(diff-TSdifference) > 1)	// clint's method (11472 bkwds - OK)
-					{
-						JumpCount++;
-						TSdifference = diff;
-						printf("i %li  Scaler Jump! Adjusting all following timestamps by: %.2f\n",i,diff);
-						printf("   diff (scaler-sbc) %.2f  TSdiff %.2f  diff-TSdiff %.2f\n",diff,TSdifference,diff-TSdifference);
-					}
-				}
-
-				// modify xTime by the running difference in timestamps
-				xTime -= TSdifference;
-
-	    		// printf("i %i  scaler %.2f  sbc %.2f  xTime %.2f\n"
-	    			// ,i,veto.GetTimeSec(),veto.GetTimeSBC()-SBCOffset,xTime);
-			}
-			else if (run > 8557 && veto.GetTimeSBC() < 2000000000) {
-				xTime = veto.GetTimeSBC() - SBCOffset;
-				ApproxTime = true;
+			bool ApproxTime = veto.GetBadScaler();
+			xTime = clock.GetTime(i);
+			if (clock.IsJump(i)) {
+				JumpCount++;
+				printf("i %li  Scaler Jump! Adjusting all following timestamps by: %.2f\n",i,clock.GetJumpCorrection(i));
 			}
-	    	else {
-	    		xTime = ((double)i / vEntries) * duration;
-	    		ApproxTime = true;
-	    	}
 
 	    	// Skip events after the event time is calculated.
 	    	if (CheckForBadErrors(veto,i,isGood,false))
@@ -535,6 +514,7 @@ void muFinder(string Input, int *thresh, bool root, bool list)
 		delete ds;
 		prevStopTime = stop;
 	}
+	SaveRunRecords();
 
 	printf("\n===================== End of Scan. =====================\n");
 
@@ -1,151 +1,176 @@
 // Find muon-Ge coincidences.
 // Clint Wiseman, USC/Majorana
+//
+// Input: a muon list made by muFinder / muListGen (run start xTime type badScaler).
+// Each run's muons are loaded once, and the run's gatified data is read once, in order,
+// through a CoincidenceEngine (../auto-veto/CoincidenceEngine.hh).  Each window keeps a
+// pointer to its first open muon, and a hit inside the windows of several muons is matched
+// once per window, to the closest one.  So the totals count every Ge hit at most once per window.
+//
+// Windows: "name lo hi" (sec, Ge time - muon time) per line in windowFile.
+// Default: +/-2 s, -10/+60 s, +/-100 s (as in GretinaCoincidencesHG.C).
+//
+// Output: ./output/MGC_[list name].root
+//   muGeCoins tree: one entry per (hit, window) match
+//   dt_[window] histograms
 
 #include "vetoScan.hh"
+#include "TTree.h"
+#include "TStopwatch.h"
+#include "CoincidenceEngine.hh"
+#include <map>
+#include <vector>
+#include <algorithm>
 
 using namespace std;
 
-void muGeCoins(string Input) 
+void muGeCoins(string Input, string windowFile)
 {
-	cout << "This is going to get complicated.\n";
-/*
-	// Input a list of run numbers
+	// Input a muon list, grouped by run
 	ifstream InputList(Input.c_str());
 	if(!InputList.good()) {
 		cout << "Couldn't open " << Input << endl;
 		return;
 	}
+	map<int, vector<double> > muTimes;
+	map<int, vector<int> > muTypes;
+	map<int, vector<bool> > muBadScaler;
+	int nMuons = 0, nRunGaps = 0;
+	string line;
+	while (getline(InputList, line))
+	{
+		int run = 0, type = 0, badScaler = 0;
+		long start = 0;
+		double xTime = 0;
+		if (sscanf(line.c_str(), "%i %li %lf %i %i", &run, &start, &xTime, &type, &badScaler) != 5) continue;
+		if (type == 3) { nRunGaps++; continue; }	// run gaps aren't muons
+		muTimes[run].push_back(xTime);
+		muTypes[run].push_back(type);
+		muBadScaler[run].push_back(badScaler);
+		nMuons++;
+	}
+	printf("Found %i muons in %lu runs (skipped %i run gaps).\n",nMuons,muTimes.size(),nRunGaps);
 
-	// Input a ROOT file with veto information
-	string Name = Input;
-	Name.erase(Name.find_last_of("."),string::npos);
-	Name.erase(0,Name.find_last_of("\\/")+1);
-	char vFileName[200];
-	cout << " Name is: " << Name << endl;
-	sprintf(vFileName,"./output/%s.root",Name.c_str());
-	TFile *f1 = new TFile(vFileName);       
-    TTree *vEvent = (TTree*)f1->Get("vetoEvent");
-    MJVetoEvent *veto;
-	Long64_t start;
-	Long64_t stop;
-	int CoinType[32];
-	int CutType[32];
-	int highestMultip = 0;
-	double LEDfreq = 0;
-	double LEDrms = 0;
-	double xTime = 0;
-	double x_deltaT = 0;
-    vEvent->SetBranchAddress("events",&veto);
-	vEvent->SetBranchAddress("CoinType[32]",&CoinType);
-	vEvent->SetBranchAddress("CutType[32]",&CutType);
-	vEvent->SetBranchAddress("LEDfreq",&LEDfreq);
-	vEvent->SetBranchAddress("LEDrms",&LEDrms);
-	vEvent->SetBranchAddress("highestMultip",&highestMultip);
-	vEvent->SetBranchAddress("start",&start);
-	vEvent->SetBranchAddress("stop",&stop);
-	vEvent->SetBranchAddress("xTime",&xTime);
-	vEvent->SetBranchAddress("x_deltaT",&x_deltaT);
-	Long64_t vEntries = vEvent->GetEntries();
-	Long64_t vEntry = 0;
-	cout << "Veto File has " << vEntries << " entries.\n";
-
-  	// Create TEntryList with a particular coincidence type, possibly from command line.
-  	vEvent->Draw(">>elist", "CoinType[0]==1", "entrylist");
-    TEntryList *elist = (TEntryList*)gDirectory->Get("elist");
-    elist->Print("");	// "": print the name of the tree and file, "all": print all the entry numbers
-	long listEntries = elist->GetN();  
-	printf("Created TEntryList from vEvent with %li entries.\n",listEntries);
+	// Time windows
+	vector<CoinWindow> windows;
+	if (windowFile != "") {
+		if (!LoadCoinWindows(windowFile, windows)) return;
+	}
+	else windows = {{"4",-2,2}, {"70",-10,60}, {"200",-100,100}};
+	size_t nWin = windows.size();
 
 	// Output a ROOT file.
-	Char_t OutputFile[200];
+	string Name = Input;
+	if (Name.find_last_of(".") != string::npos) Name.erase(Name.find_last_of("."),string::npos);
+	Name.erase(0,Name.find_last_of("\\/")+1);
+	char OutputFile[200];
 	sprintf(OutputFile,"./output/MGC_%s.root",Name.c_str());
-	TFile *RootFile = new TFile(OutputFile, "RECREATE"); 	
-	TH1::AddDirectory(kFALSE); // Global flag: "When a (root) file is closed, all histograms in memory associated with this file are automatically deleted."
-	bool isCoin = false;	// coin with veto
-	int gEntry = 0;
-	double gRun = 0;
-	double gTimeSec = 0;    
-	double deltaT = 0;
-	double gESum = 0;
-	GATMIJ *mij = new GATMIJ();
-	MJVetoEvent out;
-	MGTEvent* gEvent = new MGTEvent();    
-  	vector<double>* trapECal = 0;
-	vector<double>* timestamp = 0;
-	vector<double>* channel = 0;
-    vector<double>* blrwfFMR50 = 0;
-    vector<double>* rawWFMin = 0;
-    vector<double>* rawWFMax = 0;
-	TTree *geCoins = new TTree("geCoins","Ge Events");
-    geCoins->Branch("vetoEvent","MJVetoEvent",&out,32000,1);
-    geCoins->Branch("isCoin",&isCoin);	
-    geCoins->Branch("deltaT",&deltaT,"deltaT/D");
-	geCoins->Branch("geEvent","MGTEvent",&gEvent,32000,0);
-	geCoins->Branch("mij",&mij);
-    geCoins->Branch("gRun",&gRun);
-    geCoins->Branch("gEntry",&gEntry);	
-    geCoins->Branch("gTimeSec",&gTimeSec);  
-    geCoins->Branch("gESum",&gESum);		
-    geCoins->Branch("trapECal",&trapECal);
-    geCoins->Branch("timestamp",&timestamp);
-    geCoins->Branch("channel",&channel);
-	geCoins->Branch("blrwfFMR50",&blrwfFMR50);
-	geCoins->Branch("rawWFMin",&rawWFMin);
-	geCoins->Branch("rawWFMax",&rawWFMax);
-
-	cout << "9\n";
-
-    // Analysis Parameters
-	// double GClock = 100000000;	// gretina clock speed
-	// double loWindow = 0.1;  
-	// double hiWindow = 3602; 		
-	// double e_cut = 2650;	// =50 keV, eliminate low-energy noise. =2650 keV, skim high-E events.
-	// double e_floor = 4;     // lowest energy to include (not currently used)
+	TFile *RootFile = new TFile(OutputFile, "RECREATE");
+	int run = 0, window = 0, detector = 0, muType = 0, muIndex = 0;
+	long gEntry = 0;
+	double dt = 0, energy = 0, gTime = 0, muTime = 0;
+	bool muBadScaler_ = false;
+	TTree *coinTree = new TTree("muGeCoins","Muon-Ge coincidences, one entry per hit and window");
+	coinTree->Branch("run",&run,"run/I");
+	coinTree->Branch("window",&window,"window/I");
+	coinTree->Branch("dt",&dt,"dt/D");
+	coinTree->Branch("detector",&detector,"detector/I");
+	coinTree->Branch("energy",&energy,"energy/D");
+	coinTree->Branch("muType",&muType,"muType/I");
+	coinTree->Branch("muIndex",&muIndex,"muIndex/I");
+	coinTree->Branch("muTime",&muTime,"muTime/D");
+	coinTree->Branch("muBadScaler",&muBadScaler_,"muBadScaler/O");
+	coinTree->Branch("gEntry",&gEntry,"gEntry/L");
+	coinTree->Branch("gTime",&gTime,"gTime/D");
+	vector<TH1D*> hDT(nWin);
+	for (size_t w = 0; w < nWin; w++) {
+		hDT[w] = new TH1D(Form("dt_%s",windows[w].name.c_str()),Form("Ge - muon time (%gs to %gs)",windows[w].lo,windows[w].hi),
+			1000,windows[w].lo,windows[w].hi);
+		hDT[w]->GetXaxis()->SetTitle("dt (sec)");
+	}
 
-    // Time windows around an event on the TEventList 
-  	// Watch out for double counting!
-  	// The prototype was 4*sigma = 12 seconds
-  	// Default: change to 7 seconds b/c LED period is 7sec.
-  	// if adjustWindow is set, will adjust time window depending on scaler being good/bad.
-  	// bool adjustWindow = true;	
-  	// double hi = 7; // sec
-  	// double lo = 7; 
+	// Analysis Parameters
+	double eMin = 2.0;	// keV
 
-    // Loop over files, control it with the TEntryList
-  	// We scan ALL the vEvent entries with the same run number 
-  	// while we have the corresponding file loaded.
-  	int run = 0;
-  	cout << "4\n";
-	while(!InputList.eof())
+	// Loop over runs
+	CoincidenceEngine coin(windows);
+	vector<int> muIdx;
+	vector<double> muDT;
+	vector<long> total(nWin, 0);
+	long totalEntries = 0, totalHits = 0;
+	TStopwatch timer;
+	timer.Start();
+	for (auto &it : muTimes)
 	{
-		InputList >> run;
-		printf("\n ======= Scanning new file: run %i ======\n",run);
+		run = it.first;
+		vector<long> runCoins(nWin, 0);
+		coin.SetMuons(it.second);
 
-		// Grab all entries in the TEntryList with veto.run == run.
-		list<int> VEntThisRun;
-		for (int q = 0; q < listEntries; q++) {
-			vEntry = elist->GetEntry(q);
-			cout << "Got vEntry: " << vEntry << endl;
-			
-			if (vEntry < vEntries) vEvent->GetEntry(vEntry);
-			else cout << " you're a dumbass! \n";
-		// 	cout << "Got VEvent " << endl;	
-		// 	if(veto->run == run && vEntry != -1) {
-		// 		VEntThisRun.push_back((int)vEntry);
-		// 		printf("V-List: run:%-5i  vEntry:%lli  xTime:%-5.5f  Bad:%i  CT0:%i  CT1:%i  CT2:%i\n"
-		// 			,run,vEntry,xTime,veto->badScaler,CoinType[0],CoinType[1],CoinType[2]);
-		// 	}
-		// 	if (vEntry == -1) break; // done with elist
+		GATDataSet ds(run);
+		TChain *gat = ds.GetGatifiedChain(false);
+		vector<double> *timestamp = NULL, *channel = NULL, *trapENFCal = NULL;
+		gat->SetBranchStatus("*",0);
+		gat->SetBranchStatus("timestamp",1);
+		gat->SetBranchStatus("channel",1);
+		gat->SetBranchStatus("trapENFCal",1);
+		gat->SetBranchAddress("timestamp",&timestamp);
+		gat->SetBranchAddress("channel",&channel);
+		gat->SetBranchAddress("trapENFCal",&trapENFCal);
+		long gEntries = gat->GetEntries();
+		vector<size_t> order;
+
+		// One pass over the run, in time order.  The hits of an entry are in channel order,
+		// so sort them by timestamp first: a hit earlier than the last one makes the engine rewind.
+		for (gEntry = 0; gEntry < gEntries; gEntry++)
+		{
+			gat->GetEntry(gEntry);
+			order.resize(trapENFCal->size());
+			for (size_t k = 0; k < order.size(); k++) order[k] = k;
+			const vector<double> &ts = *timestamp;
+			sort(order.begin(), order.end(), [&ts](size_t a, size_t b) { return ts[a] < ts[b]; });
+			for (size_t i : order)
+			{
+				totalHits++;
+				energy = (*trapENFCal)[i];
+				if (energy < eMin) continue;
+				gTime = (*timestamp)[i]*1.e-8;
+				if (!coin.Match(gTime, muIdx, muDT)) continue;
+				detector = (int)(*channel)[i];
+				for (size_t w = 0; w < nWin; w++) {
+					if (muIdx[w] < 0) continue;
+					window = w;
+					dt = muDT[w];
+					muIndex = muIdx[w];
+					muTime = it.second[muIndex];
+					muType = muTypes[run][muIndex];
+					muBadScaler_ = muBadScaler[run][muIndex];
+					coinTree->Fill();
+					hDT[w]->Fill(dt);
+					runCoins[w]++;
+					total[w]++;
+				}
+			}
 		}
-		// if (VEntThisRun.size()==0) {
-		// 	printf("  Found 0 vEvent entries.  Continuing ...\n");
-		// 	// continue; 
-		// }
-		// else printf("Found %i entries in the vEvent.\n",(int)VEntThisRun.size());
-		// // int coins = 0;
+		totalEntries += gEntries;
+		delete gat;
+
+		printf("Run %i: %lu muons, %li entries.  Coincidences --",run,it.second.size(),gEntries);
+		for (size_t w = 0; w < nWin; w++) printf(" %s: %li",windows[w].name.c_str(),runCoins[w]);
+		printf("\n");
 	}
+	timer.Stop();
+
+	printf("Coincidences, all runs --");
+	for (size_t w = 0; w < nWin; w++) printf(" %s (%gs to %gs): %li",windows[w].name.c_str(),windows[w].lo,windows[w].hi,total[w]);
+	printf("\n");
+	double sec = timer.RealTime();
+	printf("Scanned %li entries, %li hits in %.1f s (%.0f entries/s, %.0f hits/s)\n",
+		totalEntries,totalHits,sec,(sec > 0) ? totalEntries/sec : 0,(sec > 0) ? totalHits/sec : 0);
 
 	// all done!
+	RootFile->cd();
+	coinTree->Write("",TObject::kOverwrite);
+	for (size_t w = 0; w < nWin; w++) hDT[w]->Write("",TObject::kOverwrite);
 	RootFile->Close();
-*/
-}
\ No newline at end of file
+	cout << "Wrote " << OutputFile << endl;
+}
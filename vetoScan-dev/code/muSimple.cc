@@ -106,7 +106,8 @@ void muSimple(string Input, int *thresh)
 		v->GetEntry(0);
 		start = (long)vRun->GetStartTime();
 		stop = (long)vRun->GetStopTime();
-		duration = ds->GetRunTime()/CLHEP::second;
+		duration = GetRunTimeSec(run);
+		if (duration < 0) duration = ds->GetRunTime()/CLHEP::second;  // not cached: ask GAT
 
 		printf("\n======= Scanning run %i, %li entries, %.0f sec. =======\n",run,vEntries,duration);
 		cout << "start: " << start << "  stop: " << stop << endl;
@@ -417,6 +418,7 @@ void muSimple(string Input, int *thresh)
 		delete ds;
 		prevStopTime = stop;
 	}
+	SaveRunRecords();
 
 	printf("\n===================== End of Scan. =====================\n");
 
@@ -23,16 +23,25 @@ void durationChecker(string file)
     	return;
     }
 	cout << "Scanning list ..." << endl;
+	RunMetadataStore &store = RunMetadataStore::Default();
+	int nMissing = 0;
 	while(!InputList.eof())
 	{
 		// InputList >> run >> utc >> hitTime >> type >> badScaler;
 		InputList >> run;
-		GATDataSet ds(run);
-		duration = (double)ds.GetRunTime()/1E9;
+		const RunRecord *rec = GetRunRecord(run, store, false);
+		if (rec == NULL || rec->GetRunTime() < 0) {
+			printf("%i  ERROR: no run time (no record in %s, and no built data)\n",run,RunMetadataStore::DefaultFile().c_str());
+			nMissing++;
+			continue;
+		}
+		duration = rec->GetRunTime();
 		durationTotal += duration;
 		printf("%i  %.3f \n",run,duration);
 	}
+	if (store.IsDirty()) store.Save();
 	cout << "List covers " << durationTotal << " seconds of Ge data.\n";
+	if (nMissing > 0) printf("WARNING: %i runs had no run time, and aren't in the total.\n",nMissing);
 }
 
 void muonDeadTime(string file)
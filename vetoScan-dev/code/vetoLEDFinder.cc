@@ -21,8 +21,8 @@ void vetoLEDFinder(string file)
 	{
 		InputList >> run;
 		GATDataSet ds(run);
-		start = GetStartUnixTime(ds);
-		stop = GetStopUnixTime(ds);
+		start = GetStartUnixTime(run);
+		stop = GetStopUnixTime(run);
 		duration = stop - start;
 			
 		// standard veto initialization block
@@ -51,5 +51,6 @@ void vetoLEDFinder(string file)
 		printf("Run: %i  Approx Freq: %.2f  Max multip: %i\n",run,(double)multipCounter/duration,highestmultip);
 		if (multipCounter == 0) printf("No LED's!  Run: %i  Highest multiplicity found: %i\n",run,highestmultip);
 	}
+	SaveRunRecords();
 
 }
@@ -16,22 +16,37 @@ void Test()
 	cout << s3.substr(s3.find_last_of("\\/")+1,string::npos) << endl;
 }
 
-long GetStartUnixTime(GATDataSet ds)
+// Run start/stop come from the run metadata cache (RunMetadata.hh),
+// so the veto chain is only opened the first time a run is seen.
+// New records aren't saved here: call SaveRunRecords() once after the loop over runs.
+long GetStartUnixTime(int run)
 {
-	TChain *c = ds.GetVetoChain();
-	MJTRun *runInfo = new MJTRun();
-	c->SetBranchAddress("run",&runInfo);
-	c->GetEntry(0);
-	return (long)runInfo->GetStartTime();
+	const RunRecord *rec = GetRunRecord(run, RunMetadataStore::Default(), false);
+	return (rec == NULL) ? 0 : rec->unixStart;
 }
 
-long GetStopUnixTime(GATDataSet ds)
+long GetStopUnixTime(int run)
 {
-	TChain *c = ds.GetVetoChain();
-	MJTRun *runInfo = new MJTRun();
-	c->SetBranchAddress("run",&runInfo);
-	c->GetEntry(0);
-	return (long)runInfo->GetStopTime();
+	const RunRecord *rec = GetRunRecord(run, RunMetadataStore::Default(), false);
+	return (rec == NULL) ? 0 : rec->unixStop;
+}
+
+// GATDataSet::GetRunTime in seconds, from the cache.  -1 (and a complaint) if there's no record.
+double GetRunTimeSec(int run)
+{
+	const RunRecord *rec = GetRunRecord(run, RunMetadataStore::Default(), false);
+	if (rec == NULL || rec->GetRunTime() < 0) {
+		cout << "ERROR: no run time for run " << run << " in " << RunMetadataStore::DefaultFile() << endl;
+		return -1;
+	}
+	return rec->GetRunTime();
+}
+
+// Writes the records harvested by the functions above, if there are any.
+void SaveRunRecords()
+{
+	RunMetadataStore &store = RunMetadataStore::Default();
+	if (store.IsDirty()) store.Save();
 }
 
 int GetNumFiles(string arg)
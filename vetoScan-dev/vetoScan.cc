@@ -25,6 +25,7 @@ static const char Usage[] =
 "     -m (--muFinder) : Scan runs for muons.\n"
 "                     : If -T is specified, user picks which SW thresholds to use.\n"
 "                     : Output options: `root`,`list`,`both`\n"
+"     -C (--clockDir) : Directory of auto-veto's cached clock models (vetoClock_run*.txt), for muFinder.\n"
 "     -p (--perfCheck) : Veto performance check (data quality).\n"
 "                      : Option: `runs`, `totals`\n"
 "                      : If -T is specified, user picks which SW thresholds to use.\n"
@@ -34,7 +35,8 @@ static const char Usage[] =
 "     -d (--dead) : Calculate Ge dead time from a muon list.\n"
 "     -o (--plot) : Run muPlotter\n"
 "     -r (--parse) : Run muParser\n"
-"     -G (--geCoins) : run muGeCoins\n"
+"     -G (--geCoins) : Find muon-Ge coincidences from a muon list (muFinder `list` output).\n"
+"                    : Option (-G[file] or --geCoins=[file]): time windows, one \"name lo hi\" per line.\n"
 "     -D (--dispList) : Create veto hit list for vetoDisplay code\n"
 "     -L (--vetoList) : Create veto hit list for DEMONSTRATOR Veto Cut\n"
 "     -s (--muSimple) : Run a simplified version of muFinder\n"
@@ -50,7 +52,7 @@ int main(int argc, char** argv)
 	// Parse command line arguments with getopt_long:
 	// http://www.gnu.org/software/libc/manual/html_node/Getopt-Long-Option-Example.html
 	//
-	string file = "", partNum = "", threshName = "";
+	string file = "", partNum = "", threshName = "", coinWindows = "", clockDir = "";
 	bool findMuons=0, perfCheck=0, fileCheck=0, findTime=0,findLED=0,findThresh=0,deadTime=0,durationCheck=0;
 	bool muPlot=0, muParse=0,checkBuilt=0,checkGAT=0,checkGDS=0,root=0,list=0;
 	bool runBreakdowns=0,geCoins=0,muList=0,vetoCutList=0;
@@ -68,6 +70,7 @@ int main(int argc, char** argv)
 			{"findThresh", no_argument, 0, 'H'},
 			{"swThresh", required_argument, 0, 'T'},
 			{"muFinder", required_argument, 0, 'm'},
+			{"clockDir", required_argument, 0, 'C'},
 			{"perfCheck", required_argument, 0, 'p'},
 			{"timeCheck", no_argument, 0, 't'},
 			{"duration", no_argument, 0, 'u'},
@@ -75,14 +78,14 @@ int main(int argc, char** argv)
 			{"dead", no_argument, 0, 'd'},
 			{"plot", no_argument, 0, 'o'},
 			{"parse", no_argument, 0, 'r'},
-			{"geCoins", required_argument, 0, 'G'},
+			{"geCoins", optional_argument, 0, 'G'},
 			{"dispList", no_argument,0,'D'},
 			{"vetoList", no_argument, 0, 'L'},
 			{"muSimple", no_argument, 0, 's'}
 		};
 
 		// don't forget to add a new option here too!
-		c = getopt_long (argc, argv, "hF:S:f:H:T:m:p:tldorGDLsu",long_options,&option_index);
+		c = getopt_long (argc, argv, "hF:S:f:H:T:m:C:p:tldorG::DLsu",long_options,&option_index);
 		if (c == -1) break;
 
 		switch (c)
@@ -122,6 +125,10 @@ int main(int argc, char** argv)
 			else if (string(optarg) == "list") list=1;
 			else if (string(optarg) == "both") { root=1; list=1; }
 			break;
+		case 'C':
+			clockDir = string(optarg);
+			cout << "Using cached clock models in " << clockDir << endl;
+			break;
 	    case 'p': 
 	    	perfCheck=1; 
 	    	if (string(optarg) == "runs") runBreakdowns=1;
@@ -133,7 +140,10 @@ int main(int argc, char** argv)
 		case 'u': durationCheck=1; break;
 		case 'o': muPlot=1; break;
 		case 'r': muParse=1; break;
-		case 'G': geCoins=1; break;
+		case 'G':
+			geCoins=1;
+			if (optarg) coinWindows = string(optarg);
+			break;
 		case 'D': muList=1; break;
 		case 'L': vetoCutList=1; break;
 		case 's': muSimp=1; break;
@@ -165,7 +175,7 @@ int main(int argc, char** argv)
 	{  	
 		if (threshName != "") GetQDCThreshold(file,thresh,threshName);
 		else GetQDCThreshold(file,thresh);
-		muFinder(file,thresh,root,list);
+		muFinder(file,thresh,root,list,clockDir);
 	}
 	if (muSimp) 
 	{  	
@@ -178,7 +188,7 @@ int main(int argc, char** argv)
 	if (durationCheck) durationChecker(file);
 	if (muPlot)		muPlotter(file);
 	if (muParse)	muParser(file);
-	if (geCoins)	muGeCoins(file);
+	if (geCoins)	muGeCoins(file,coinWindows);
 	if (muList)		muDisplayList(file);
 	if (vetoCutList) muListGen(file);
 
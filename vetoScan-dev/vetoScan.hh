@@ -32,14 +32,17 @@
 #include "MJVetoEvent.hh"
 #include "GATDataSet.hh"
 #include "GATMultiplicityProcessor.hh"
+#include "RunHarvest.hh"
 
 
 using namespace std;
 
 // Processing (defined in vetoTools.cc)
 void Test();
-long GetStartUnixTime(GATDataSet ds);
-long GetStopUnixTime(GATDataSet ds);
+long GetStartUnixTime(int run);
+long GetStopUnixTime(int run);
+double GetRunTimeSec(int run);
+void SaveRunRecords();
 int GetNumFiles(string arg);
 int color(int i);
 int PanelMap(int i);
@@ -52,11 +55,10 @@ double InterpTime(int entry, vector<double> times, vector<double> entries, vecto
 void vetoFileCheck(string file = "", string partNum = "", bool checkBuilt = true, bool checkGat = true, bool checkGDS = false);
 void vetoPerformance(string file, int *thresh = NULL, bool runBreakdowns = false);
 void vetoThreshFinder(string arg, bool runHistos = false);
-void muFinder(string file, int *thresh = NULL, bool root = false, bool list = false);
+void muFinder(string file, int *thresh = NULL, bool root = false, bool list = false, string clockDir = "");
 
 // In development
-void GrabVetoTree(string file);
-void muGeCoins(string Input);
+void muGeCoins(string Input, string windowFile = "");
 void muParser(string arg);
 void durationChecker(string file);
 void muonDeadTime(string file);
@@ -101,7 +101,8 @@ void muFinder(string Input, int *thresh, bool root, bool list)
 		// initialize
 		InputList >> run;
 		GATDataSet *ds = new GATDataSet(run);
-		TChain *v = ds->GetVetoChain();
+		TChain *v = GetExtractedVetoChain(run);	// veto-only file, if veto-extract made one
+		if (v == NULL) v = ds->GetVetoChain();
 		long vEntries = v->GetEntries();
 		MJTRun *vRun = new MJTRun();
 		MGTBasicEvent *vEvent = new MGTBasicEvent();
@@ -111,6 +112,10 @@ void muFinder(string Input, int *thresh, bool root, bool list)
 		v->SetBranchAddress("mVeto",&mVeto);
 		v->SetBranchAddress("vetoEvent",&vEvent);
 		v->SetBranchAddress("vetoBits",&vBits);
+		ReaderSetup io(v, "VetoTree");
+		io.SetBranches({"run","mVeto","vetoEvent","vetoBits"});
+		io.SetDisableOthers(true);
+		io.Apply();
 		v->GetEntry(0);
 		start = (long)vRun->GetStartTime();
 		stop = (long)vRun->GetStopTime();
@@ -532,6 +537,7 @@ void muFinder(string Input, int *thresh, bool root, bool list)
 		if (almostMissedLED > 0) cout << "\nWarning, almost missed " << almostMissedLED << " LED events.\n";
 
 	    // done with this run.
+		io.Finish();
 		delete ds;
 		prevStopTime = stop;
 	}
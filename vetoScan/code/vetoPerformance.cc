@@ -32,7 +32,7 @@ void vetoPerformance(string Input, int *thresh, bool runBreakdowns)
 	TFile *RootFile = new TFile(OutputFile, "RECREATE"); 	
   	TH1::AddDirectory(kFALSE); // Global flag: "When a (root) file is closed, all histograms in memory associated with this file are automatically deleted."
 	RootFile->mkdir("rawQDC");
-	if (runBreakdowns) RootFile->mkdir("runPlots");
+	PlotRecorder plots;	// run breakdowns, saved as plotData.  Draw them with ../auto-veto/veto-render
 
 	// global counters
 	const int nErrs = 18;
@@ -113,7 +113,8 @@ void vetoPerformance(string Input, int *thresh, bool runBreakdowns)
 
 		// initialize
 		GATDataSet *ds = new GATDataSet(run);
-		TChain *v = ds->GetVetoChain();
+		TChain *v = GetExtractedVetoChain(run);	// veto-only file, if veto-extract made one
+		if (v == NULL) v = ds->GetVetoChain();
 		long vEntries = v->GetEntries();
 		MJTRun *vRun = new MJTRun();
 		MGTBasicEvent *vEvent = new MGTBasicEvent(); 
@@ -123,6 +124,10 @@ void vetoPerformance(string Input, int *thresh, bool runBreakdowns)
 		v->SetBranchAddress("mVeto",&mVeto);
 		v->SetBranchAddress("vetoEvent",&vEvent);
 		v->SetBranchAddress("vetoBits",&vBits);
+		ReaderSetup io(v, "VetoTree");
+		io.SetBranches({"run","mVeto","vetoEvent","vetoBits"});
+		io.SetDisableOthers(true);
+		io.Apply();
 		
 		long start = (long)vRun->GetStartTime();
 		long stop = (long)vRun->GetStopTime();
@@ -140,41 +145,13 @@ void vetoPerformance(string Input, int *thresh, bool runBreakdowns)
 		// run-by-run histos and graphs
 		sprintf(hname,"%d_LEDDeltaT",run);
 		TH1D *LEDDeltaT = new TH1D(hname,hname,100000,0,100); // 0.001 sec/bin
+		// (points only -- no graphs are made here)
 		TH1D *deltaTRun = NULL;
-		TGraph *gMultipVsTimeRun = NULL;
-		TGraph *gSTimeVsfIndex = NULL;	
-		TGraph *gLEDTSVsLEDCount = NULL;	
-		TGraph *gEventCountScaler = NULL;
-		TGraph *gEventCountQDC1 = NULL;
-		TGraph *gEventCountQDC2 = NULL;
+		vector<double> multipTime, multip, sIndex, sTime, ledCount, ledTime, countTime, countSEC, countQEC, countQEC2;
 		if (runBreakdowns)
 		{
 			sprintf(hname,"%d_deltaT", run);
 			deltaTRun = new TH1D(hname,hname,700,0,70);
-
-			sprintf(hname,"%d_MultipVsTime", run);
-			gMultipVsTimeRun = new TGraph(vEntries);
-			gMultipVsTimeRun->SetName(hname);
-			
-			sprintf(hname,"%d_STimeVsfIndex", run);
-			gSTimeVsfIndex = new TGraph(vEntries);
-			gSTimeVsfIndex->SetName(hname);
-			
-			sprintf(hname,"%d_LEDTSVsfIndex", run);
-			gLEDTSVsLEDCount = new TGraph(vEntries);
-			gLEDTSVsLEDCount->SetName(hname);
-			
-			sprintf(hname,"%d_EventCountScaler", run);
-			gEventCountScaler = new TGraph(vEntries);
-			gEventCountScaler->SetName(hname);
-			
-			sprintf(hname,"%d_EventCountQDC1", run);
-			gEventCountQDC1 = new TGraph(vEntries);
-			gEventCountQDC1->SetName(hname);
-			
-			sprintf(hname,"%d_EventCountQDC2", run);
-			gEventCountQDC2 = new TGraph(vEntries);
-			gEventCountQDC2->SetName(hname);
 		}
 
 		printf("\n======= Scanning run %i, %li entries, %.0f sec. =======\n",run,vEntries,duration);
@@ -265,7 +242,8 @@ void vetoPerformance(string Input, int *thresh, bool runBreakdowns)
 				totLED++;
 				if (runBreakdowns) { 
 					if (!veto.GetBadScaler()) {
-						gLEDTSVsLEDCount->SetPoint(i,pureLEDcount,veto.GetTimeSec());
+						ledCount.push_back(pureLEDcount);
+						ledTime.push_back(veto.GetTimeSec());
 					}
 					else printf("bad scaler LED! run: %d  |  entry: %d  |  ledcount: %d\n",run,i,pureLEDcount);
 				}
@@ -409,13 +387,16 @@ void vetoPerformance(string Input, int *thresh, bool runBreakdowns)
 			if (dt > 8) largedt++;
 			if (runBreakdowns) { 
 				deltaTRun->Fill(dt);
-				gMultipVsTimeRun->SetPoint(i,LocalEntryTime[i],veto.GetMultip());
+				multipTime.push_back(LocalEntryTime[i]);
+				multip.push_back(veto.GetMultip());
 				if (!veto.GetBadScaler()) {
-					gSTimeVsfIndex->SetPoint(i,veto.GetScalerIndex(),veto.GetTimeSec());		
+					sIndex.push_back(veto.GetScalerIndex());
+					sTime.push_back(veto.GetTimeSec());
 				}
-				gEventCountScaler->SetPoint(i,xTime,veto.GetSEC());
-				gEventCountQDC1->SetPoint(i,xTime,veto.GetQEC());
-				gEventCountQDC2->SetPoint(i,xTime,veto.GetQEC2());
+				countTime.push_back(xTime);
+				countSEC.push_back(veto.GetSEC());
+				countQEC.push_back(veto.GetQEC());
+				countQEC2.push_back(veto.GetQEC2());
 			}
 			if (dt > LEDperiod + RMSTimeWindow && i > 0){
 				printf("High delta-T event: Entry %i, Prev %i.  dt = %.2f  xTime = %.2f (Method: %d) xTimePrev = %.2f  |  window: dt > %.2fs\n"
@@ -537,62 +518,18 @@ void vetoPerformance(string Input, int *thresh, bool runBreakdowns)
 		LocalEntryTime.clear();
 		LocalErrCountEntry.clear();
 		HighDTEvent.clear();
-		if (runBreakdowns) 
+		if (runBreakdowns)
 		{
-			RootFile->cd("runPlots");
-			sprintf(hname,"%d_deltaT", run);
-			deltaTRun->Write(hname,TObject::kOverwrite); 
-
-			sprintf(hname,"%d_MultipVsTime", run);
-			gMultipVsTimeRun->SetMarkerColor(4);
-			gMultipVsTimeRun->SetMarkerStyle(21);
-			gMultipVsTimeRun->SetMarkerSize(0.5);
-			gMultipVsTimeRun->SetLineColorAlpha(kWhite,0);
-			gMultipVsTimeRun->Write(hname,TObject::kOverwrite);
-			
-			sprintf(hname,"%d_STimeVsfIndex", run);
-			gSTimeVsfIndex->GetXaxis()->SetTitle("Scaler Index");
-			gSTimeVsfIndex->GetYaxis()->SetTitle("Scaler Time (sec)");
-			gSTimeVsfIndex->SetMarkerColor(4);
-			gSTimeVsfIndex->SetMarkerStyle(21);
-			gSTimeVsfIndex->SetMarkerSize(0.5);
-			gSTimeVsfIndex->SetLineColorAlpha(kWhite,0);
-			gSTimeVsfIndex->Write(hname,TObject::kOverwrite);
-			
-			sprintf(hname,"%d_LEDTSVsLEDcount", run);
-			gLEDTSVsLEDCount->GetXaxis()->SetTitle("LED count");
-			gLEDTSVsLEDCount->GetYaxis()->SetTitle("LED Event Scaler Time (sec)");
-			gLEDTSVsLEDCount->SetMarkerColor(4);
-			gLEDTSVsLEDCount->SetMarkerStyle(21);
-			gLEDTSVsLEDCount->SetMarkerSize(0.5);
-			gLEDTSVsLEDCount->SetLineColorAlpha(kWhite,0);
-			gLEDTSVsLEDCount->Write(hname,TObject::kOverwrite);
-			
-			sprintf(hname,"%d_EventCountScaler", run);
-			gEventCountScaler->SetMarkerStyle(20);
-			gEventCountScaler->SetMarkerColor(2);
-			gEventCountScaler->SetLineColorAlpha(kWhite,0);
-			gEventCountScaler->Write(hname,TObject::kOverwrite);
-			
-			sprintf(hname,"%d_EventCountQDC1", run);
-			gEventCountQDC1->SetMarkerStyle(21);
-			gEventCountQDC1->SetMarkerColor(4);
-			gEventCountQDC1->SetLineColorAlpha(kWhite,0);
-			gEventCountQDC1->Write(hname,TObject::kOverwrite);
-			
-			sprintf(hname,"%d_EventCountQDC2", run);
-			gEventCountQDC2->SetMarkerStyle(22);
-			gEventCountQDC2->SetMarkerColor(6);
-			gEventCountQDC2->SetLineColorAlpha(kWhite,0);
-			gEventCountQDC2->Write(hname,TObject::kOverwrite);	
-
+			sprintf(hname,"VP_%s_run%d", Name.c_str(), run);
+			plots.SetLayout(hname, 4, 2, 1600, 800);
+			plots.AddHist(hname, 1, deltaTRun);
+			plots.AddGraph(hname, 2, TString::Format("%d_MultipVsTime", run).Data(), multipTime, multip, "Time (sec)", "Multiplicity");
+			plots.AddGraph(hname, 3, TString::Format("%d_STimeVsfIndex", run).Data(), sIndex, sTime, "Scaler Index", "Scaler Time (sec)");
+			plots.AddGraph(hname, 4, TString::Format("%d_LEDTSVsLEDcount", run).Data(), ledCount, ledTime, "LED count", "LED Event Scaler Time (sec)");
+			plots.AddGraph(hname, 5, TString::Format("%d_EventCountScaler", run).Data(), countTime, countSEC, "Time (sec)", "SEC", 20, 2);
+			plots.AddGraph(hname, 6, TString::Format("%d_EventCountQDC1", run).Data(), countTime, countQEC, "Time (sec)", "QEC1", 21, 4);
+			plots.AddGraph(hname, 7, TString::Format("%d_EventCountQDC2", run).Data(), countTime, countQEC2, "Time (sec)", "QEC2", 22, 6);
 			delete deltaTRun;
-			delete gMultipVsTimeRun;
-			delete gSTimeVsfIndex;
-			delete gEventCountScaler;
-			delete gEventCountQDC1;
-			delete gEventCountQDC2;
-			RootFile->cd();
 		}	
 	}
 	
@@ -710,6 +647,10 @@ void vetoPerformance(string Input, int *thresh, bool runBreakdowns)
 		hRawQDC[i]->Write(hname,TObject::kOverwrite);
 	}
 	
+	if (runBreakdowns) {
+		RootFile->cd();
+		plots.Write();
+	}
 	RootFile->Close();
 	cout << "\nWrote ROOT file." << endl;
 }
\ No newline at end of file
@@ -57,7 +57,8 @@ void vetoThreshFinder(string Input, bool runHistos)
 		GATDataSet *ds = new GATDataSet(run);
 
 		// standard veto initialization block
-		TChain *v = ds->GetVetoChain();
+		TChain *v = GetExtractedVetoChain(run);	// veto-only file, if veto-extract made one
+		if (v == NULL) v = ds->GetVetoChain();
 		long vEntries = v->GetEntries();
 		MJTRun *vRun = new MJTRun();
 		MGTBasicEvent *vEvent = new MGTBasicEvent(); 
@@ -67,6 +68,10 @@ void vetoThreshFinder(string Input, bool runHistos)
 		v->SetBranchAddress("mVeto",&mVeto);
 		v->SetBranchAddress("vetoEvent",&vEvent);
 		v->SetBranchAddress("vetoBits",&vBits);
+		ReaderSetup io(v, "VetoTree");
+		io.SetBranches({"run","mVeto","vetoEvent","vetoBits"});
+		io.SetDisableOthers(true);
+		io.Apply();
 
 		printf("\n========= Scanning Run %i: %li entries. =========\n",run,vEntries);
 
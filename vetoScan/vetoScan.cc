@@ -23,12 +23,14 @@ static const char Usage[] =
 "                       : Options: `runs` or `totals`\n"
 "     -T (--swThresh) : Set QDC software threshold using `vetoSWThresholds.txt`\n"
 "     -p (--perfCheck) : Veto performance check (data quality).\n"
-"                      : Option: `runs`, `totals`\n"
+"                      : Option: `runs` (per-run plots, saved as plotData for ../auto-veto/veto-render), `totals`\n"
 "                      : If -T is specified, user picks which SW thresholds to use.\n"
 "     -m (--muFinder) : Scan runs for muons.\n"
 "                     : If -T is specified, user picks which SW thresholds to use.\n"
 "                     : Output options: `root`,`list`,`both`\n"
 "     -D (--dispList) : Create veto hit list for vetoDisplay code\n"
+"     -I (--io-stats) : Print read calls & cache efficiency for each run\n"
+"     -P (--prefetch) : Async prefetching of the input files\n"
 "\n";
 
 
@@ -62,9 +64,12 @@ int main(int argc, char** argv)
 			{"perfCheck", required_argument, 0, 'p'},
 			{"muFinder", required_argument, 0, 'm'},
 			{"dispList", no_argument,0, 'D'},
+			{"io-stats", no_argument,0, 'I'},
+			{"prefetch", no_argument,0, 'P'},
+			{0, 0, 0, 0}
 		};
 
-		c = getopt_long (argc, argv, "hF:S:f:H:T:p:m:D",long_options,&option_index);
+		c = getopt_long (argc, argv, "hF:S:f:H:T:p:m:DIP",long_options,&option_index);
 		if (c == -1) break;
 
 		switch (c)
@@ -112,6 +117,12 @@ int main(int argc, char** argv)
 		case 'D':
 			muList=1;
 			break;
+		case 'I':
+			ReaderSetup::IOStats() = true;
+			break;
+		case 'P':
+			ReaderSetup::SetPrefetch(true);
+			break;
 		case '?':
 		    if (isprint (optopt))  fprintf (stderr, "Unknown option `-%c'.\n", optopt);
 		    else fprintf (stderr,"Unknown option character `\\x%x'.\n",optopt);
@@ -28,6 +28,9 @@
 
 #include "MJVetoEvent.hh"
 #include "GATDataSet.hh"
+#include "../auto-veto/VetoFiles.hh"
+#include "../auto-veto/ReaderSetup.hh"
+#include "../auto-veto/PlotRecorder.hh"
 
 using namespace std;
 